@@ -9,6 +9,7 @@
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "CommonTools/Utils/src/SelectorPtr.h"
 #include "CommonTools/Utils/src/SelectorBase.h"
+#include "CommonTools/Utils/src/ExpressionCompiler.h"
 #include "CommonTools/Utils/interface/cutParser.h"
 #include "FWCore/Utilities/interface/ObjectWithDict.h"
 
@@ -20,19 +21,26 @@ struct StringCutObjectSelector {
       throw edm::Exception(edm::errors::Configuration,
 			   "failed to parse \"" + cut + "\"");
     }
+    compiled_ = reco::parser::compile(type_, *select_);
   }
   StringCutObjectSelector(const reco::parser::SelectorPtr & select) : 
     select_(select),
-    type_(typeid(T)) {
+    type_(typeid(T)),
+    compiled_(reco::parser::compile(type_, *select_)) {
   }
   bool operator()(const T & t) const {
+    if(compiled_ != nullptr) return compiled_(& t);
     edm::ObjectWithDict o(type_, const_cast<T *>(& t));
     return (*select_)(o);  
   }
+  /// true if the cut is evaluated as compiled code
+  bool compiled() const { return compiled_ != nullptr; }
 
 private:
   reco::parser::SelectorPtr select_;
   edm::TypeWithDict type_;
+  /// the cut compiled to native code, see StringExpressionCompiler
+  reco::parser::ExpressionCompiler::Selector compiled_ = nullptr;
 };
 
 #endif
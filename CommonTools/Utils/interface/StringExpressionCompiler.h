@@ -0,0 +1,38 @@
+#ifndef CommonTools_Utils_StringExpressionCompiler_h
+#define CommonTools_Utils_StringExpressionCompiler_h
+/* \class StringExpressionCompiler
+ *
+ * Service that compiles the string cuts and expressions of the job
+ * (StringCutObjectSelector, StringObjectFunction) to native code,
+ * see reco::parser::ExpressionCompiler. Without the service, or with
+ * enable = False, the parsed expressions are used.
+ *
+ * The compiled functions are cached by the service for the job.
+ *
+ * Usage:
+ *   process.StringExpressionCompiler = cms.Service("StringExpressionCompiler")
+ *
+ */
+#include "CommonTools/Utils/src/ExpressionCompiler.h"
+
+namespace edm {
+  class ActivityRegistry;
+  class ConfigurationDescriptions;
+  class ParameterSet;
+}
+
+class StringExpressionCompiler {
+public:
+  StringExpressionCompiler(const edm::ParameterSet & iConfig, edm::ActivityRegistry & iRegistry);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+
+  /// null if the compilation is disabled
+  reco::parser::ExpressionCompiler * compiler() { return enable_ ? & compiler_ : nullptr; }
+
+private:
+  const bool enable_;
+  reco::parser::ExpressionCompiler compiler_;
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "CommonTools/Utils/src/ExpressionPtr.h"
 #include "CommonTools/Utils/src/ExpressionBase.h"
+#include "CommonTools/Utils/src/ExpressionCompiler.h"
 #include "CommonTools/Utils/interface/expressionParser.h"
 #include "FWCore/Utilities/interface/ObjectWithDict.h"
 
@@ -20,19 +21,26 @@ struct StringObjectFunction {
       throw edm::Exception(edm::errors::Configuration,
 			   "failed to parse \"" + expr + "\"");
     }
+    compiled_ = reco::parser::compile(type_, *expr_);
   }
   StringObjectFunction(const reco::parser::ExpressionPtr & expr) : 
     expr_(expr),
-    type_(typeid(T)) {
+    type_(typeid(T)),
+    compiled_(reco::parser::compile(type_, *expr_)) {
   }
   double operator()(const T & t) const {
+    if(compiled_ != nullptr) return compiled_(& t);
     edm::ObjectWithDict o(type_, const_cast<T *>(& t));
     return expr_->value(o);  
   }
+  /// true if the expression is evaluated as compiled code
+  bool compiled() const { return compiled_ != nullptr; }
 
 private:
   reco::parser::ExpressionPtr expr_;
   edm::TypeWithDict type_;
+  /// the expression compiled to native code, see StringExpressionCompiler
+  reco::parser::ExpressionCompiler::Function compiled_ = nullptr;
 };
 
 template <typename Object> class sortByStringFunction  {
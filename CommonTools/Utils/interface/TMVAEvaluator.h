@@ -10,6 +10,7 @@
 #include "TMVA/Reader.h"
 #include "TMVA/IMethod.h"
 #include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
 
@@ -19,6 +20,8 @@ class TMVAEvaluator {
   public:
     TMVAEvaluator();
 
+    // options are those of the TMVA::Reader. With useGBRForest no reader is kept,
+    // the forest is read once per process by reco::getSharedTMVAForest, and options are ignored.
     void initialize(const std::string & options, const std::string & method, const std::string & weightFile,
                     const std::vector<std::string> & variables, const std::vector<std::string> & spectators, bool useGBRForest=false, bool useAdaBoost=false);
     void initializeGBRForest(const GBRForest* gbrForest, const std::vector<std::string> & variables,
@@ -29,6 +32,11 @@ class TMVAEvaluator {
     float evaluateGBRForest(const std::map<std::string,float> & inputs) const;
     float evaluate(const std::map<std::string,float> & inputs, bool useSpectators=false) const;
 
+    // GBRForest only: inputs in the order of the variables given at initialization,
+    // one candidate or nCandidates candidates stored one after the other
+    float evaluateGBRForest(const float* inputs) const;
+    void evaluateGBRForest(const float* inputs, unsigned int nCandidates, float* values) const;
+
   private:
     bool mIsInitialized;
     bool mUsingGBRForest;
@@ -38,6 +46,7 @@ class TMVAEvaluator {
     mutable std::mutex m_mutex;
     CMS_THREAD_GUARD(m_mutex) std::unique_ptr<TMVA::Reader> mReader;
     std::shared_ptr<const GBRForest> mGBRForest;
+    std::shared_ptr<const GBRForestFlat> mFlatForest;  // used for the evaluation
 
     CMS_THREAD_GUARD(m_mutex) mutable std::map<std::string,std::pair<size_t,float>> mVariables;
     CMS_THREAD_GUARD(m_mutex) mutable std::map<std::string,std::pair<size_t,float>> mSpectators;
@@ -0,0 +1,51 @@
+#ifndef CommonTools_Utils_TMVAForestCache_h
+#define CommonTools_Utils_TMVAForestCache_h
+
+/*
+ * Process-wide cache of the BDTs read from TMVA weight files.
+ *
+ * Each (method, weight file, variables, spectators) combination is parsed once
+ * with a temporary TMVA::Reader and converted to an immutable GBRForest, together
+ * with its flat evaluation copy. The result is shared by all the modules and streams
+ * that ask for it, and is thread safe to evaluate: no TMVA::Reader is kept.
+ * The cache only holds weak references, a model is freed with its last user.
+ *
+ * Usage:  auto bdt = reco::getSharedTMVAForest("BDTG", weightFile, variables);
+ *         float value = bdt->flat.GetGradBoostClassifier(inputs);  // inputs in the order of variables
+ */
+
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TMVA {
+  class MethodBDT;
+}
+
+namespace reco {
+
+  struct TMVAForest {
+    explicit TMVAForest(const TMVA::MethodBDT *bdt) : forest(bdt), flat(forest) {}
+
+    const GBRForest forest;
+    const GBRForestFlat flat;
+  };
+
+  std::shared_ptr<const TMVAForest> getSharedTMVAForest(const std::string& method, const std::string& weightFile,
+                                                        const std::vector<std::string>& variables,
+                                                        const std::vector<std::string>& spectators = std::vector<std::string>());
+
+  // the forest alone, sharing the ownership of the cached model
+  inline std::shared_ptr<const GBRForest> getSharedGBRForest(const std::string& method, const std::string& weightFile,
+                                                             const std::vector<std::string>& variables,
+                                                             const std::vector<std::string>& spectators = std::vector<std::string>()) {
+    auto model = getSharedTMVAForest(method, weightFile, variables, spectators);
+    return std::shared_ptr<const GBRForest>(model, &model->forest);
+  }
+
+}
+
+#endif // CommonTools_Utils_TMVAForestCache_h
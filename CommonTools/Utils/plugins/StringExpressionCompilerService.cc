@@ -0,0 +1,4 @@
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "CommonTools/Utils/interface/StringExpressionCompiler.h"
+
+DEFINE_FWK_SERVICE(StringExpressionCompiler);
@@ -6,6 +6,7 @@ namespace reco {
   namespace parser {
     class AnyObjSelector : public SelectorBase {
       bool operator()(const edm::ObjectWithDict & c) const override { return true; }
+      bool cppCode(std::string & code) const override { code += "true"; return true; }
     };
   }
 }
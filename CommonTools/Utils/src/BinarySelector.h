@@ -25,6 +25,10 @@ namespace reco {
       bool operator()( const edm::ObjectWithDict & o ) const override {
 	return cmp_->compare( lhs_->value( o ), rhs_->value( o ) );
       }
+      bool cppCode( std::string & code ) const override {
+	std::string lhs, rhs;
+	return lhs_->cppCode( lhs ) && rhs_->cppCode( rhs ) && cmp_->cppCode( code, lhs, rhs );
+      }
       boost::shared_ptr<ExpressionBase> lhs_;
       boost::shared_ptr<ComparisonBase> cmp_;
       boost::shared_ptr<ExpressionBase> rhs_;
@@ -11,12 +11,18 @@
  *
  */
 #include "CommonTools/Utils/src/ComparisonBase.h"
+#include "CommonTools/Utils/src/OperatorCode.h"
 
 namespace reco {
   namespace parser {
     template<class CompT>
     struct Comparison : public ComparisonBase {
       bool compare(double lhs, double rhs) const override { return comp(lhs, rhs); }
+      bool cppCode(std::string & code, const std::string & lhs, const std::string & rhs) const override {
+	if (OperatorCode<CompT>::name() == nullptr) return false;
+	code += "(" + lhs + " " + OperatorCode<CompT>::name() + " " + rhs + ")";
+	return true;
+      }
     private:
       CompT comp;
     };
@@ -11,11 +11,15 @@
  *
  */
 
+#include <string>
+
 namespace reco {
   namespace parser {
     struct ComparisonBase {
       virtual ~ComparisonBase() { }
       virtual bool compare( double, double ) const = 0;
+      /// append the C++ code of the comparison of lhs and rhs
+      virtual bool cppCode( std::string &, const std::string & lhs, const std::string & rhs ) const { return false; }
     };
   }
 }
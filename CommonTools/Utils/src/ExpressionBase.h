@@ -9,6 +9,7 @@
  *
  */
 #include <boost/shared_ptr.hpp>
+#include <string>
 #include <vector>
 
 namespace edm { class ObjectWithDict; }
@@ -18,6 +19,9 @@ namespace reco {
     struct ExpressionBase {
       virtual ~ExpressionBase() { }
       virtual double value( const edm::ObjectWithDict & ) const = 0;
+      /// append the C++ code of the expression of "obj",
+      /// return false if it can't be compiled
+      virtual bool cppCode( std::string & ) const { return false; }
     };
     typedef boost::shared_ptr<ExpressionBase> ExpressionPtr;
   }
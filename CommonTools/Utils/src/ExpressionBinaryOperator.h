@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include "CommonTools/Utils/src/OperatorCode.h"
 
 namespace reco {
   namespace parser {
@@ -20,6 +21,15 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return op_((*lhs_).value(o), (*rhs_).value(o));
       }
+      bool cppCode(std::string & code) const override {
+	std::string lhs, rhs;
+	if (OperatorCode<Op>::name() == nullptr || !lhs_->cppCode(lhs) || !rhs_->cppCode(rhs)) return false;
+	if (OperatorCode<Op>::infix())
+	  code += "(" + lhs + " " + OperatorCode<Op>::name() + " " + rhs + ")";
+	else
+	  code += OperatorCode<Op>::name() + ("(" + lhs + ", " + rhs + ")");
+	return true;
+      }
       ExpressionBinaryOperator(ExpressionStack & expStack) { 
 	rhs_ = expStack.back(); expStack.pop_back();
 	lhs_ = expStack.back(); expStack.pop_back();
@@ -0,0 +1,108 @@
+#include "CommonTools/Utils/src/ExpressionCompiler.h"
+#include "CommonTools/Utils/src/SelectorBase.h"
+#include "CommonTools/Utils/src/ExpressionBase.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
+
+#include "TInterpreter.h"
+#include "TVirtualMutex.h"
+
+#include <Math/ProbFuncMathCore.h>
+#include <DataFormats/Math/interface/deltaPhi.h>
+#include <DataFormats/Math/interface/deltaR.h>
+
+using namespace reco::parser;
+
+namespace {
+  // declarations needed by the generated code, see MethodInvoker::cppCode
+  const char * const prelude =
+    "#include <algorithm>\n"
+    "#include <cmath>\n"
+    "#include <cstdint>\n"
+    "#include <string>\n"
+    "namespace reco { namespace parser { namespace compiled {\n"
+    "  [[noreturn]] void nullPointer(const char *);\n"
+    "  double chi2prob(double, double);\n"
+    "  double deltaR(double, double, double, double);\n"
+    "  double deltaPhi(double, double);\n"
+    "  double testBit(double, double);\n"
+    "  template<typename T> inline const T & deref(const T & v, const char *) { return v; }\n"
+    "  template<typename T> inline const T & deref(T * p, const char * method) {\n"
+    "    if (p == nullptr) nullPointer(method);\n"
+    "    return *p;\n"
+    "  }\n"
+    "}}}\n";
+}
+
+ExpressionCompiler::Selector ExpressionCompiler::compile(const edm::TypeWithDict & type, const SelectorBase & select) {
+  std::string code;
+  if( ! select.cppCode( code ) ) return nullptr;
+  return reinterpret_cast<Selector>( compile( type, "bool", code ) );
+}
+
+ExpressionCompiler::Function ExpressionCompiler::compile(const edm::TypeWithDict & type, const ExpressionBase & expr) {
+  std::string code;
+  if( ! expr.cppCode( code ) ) return nullptr;
+  return reinterpret_cast<Function>( compile( type, "double", code ) );
+}
+
+void * ExpressionCompiler::compile(const edm::TypeWithDict & type, const char * returnType, const std::string & code) {
+  const std::string typeName = type.cppName();
+  const std::string key = std::string( returnType ) + " " + typeName + " " + code;
+
+  std::lock_guard<std::mutex> guard( mutex_ );
+  auto found = functions_.find( key );
+  if( found != functions_.end() ) return found->second;
+
+  void * function = nullptr;
+  {
+    R__LOCKGUARD( gInterpreterMutex );
+    // the interpreter is shared by the process: the prelude is declared
+    // once and the names of the functions must be unique in it
+    static const bool preludeDeclared = gInterpreter->Declare( prelude );
+    static unsigned int nFunctions = 0;
+    if( preludeDeclared ) {
+      const std::string name = "f" + std::to_string( nFunctions++ );
+      const std::string definition =
+	"namespace reco { namespace parser { namespace compiled {\n" +
+	std::string( returnType ) + " " + name + "(const void * ptr) {\n"
+	"  const " + typeName + " & obj = * static_cast<const " + typeName + " *>(ptr);\n"
+	"  return " + code + ";\n"
+	"}\n"
+	"}}}\n";
+      if( gInterpreter->Declare( definition.c_str() ) ) {
+	TInterpreter::EErrorCode error = TInterpreter::kNoError;
+	Long_t address = gInterpreter->Calc( ( "(long)&reco::parser::compiled::" + name ).c_str(), &error );
+	if( error == TInterpreter::kNoError ) function = reinterpret_cast<void *>( address );
+      }
+    }
+  }
+  if( function == nullptr ) {
+    LogDebug( "ExpressionCompiler" ) << "could not compile for " << typeName << ": " << code
+				      << "\nthe parsed expression will be used";
+  }
+  functions_[ key ] = function;
+  return function;
+}
+
+void reco::parser::compiled::nullPointer(const char * method) {
+  throw edm::Exception( edm::errors::InvalidReference )
+    << "method \"" << method << "\" returned a null pointer ";
+}
+
+double reco::parser::compiled::chi2prob(double x, double ndof) {
+  return ROOT::Math::chisquared_cdf_c( x, ndof );
+}
+
+double reco::parser::compiled::deltaR(double eta1, double phi1, double eta2, double phi2) {
+  return reco::deltaR( eta1, phi1, eta2, phi2 );
+}
+
+double reco::parser::compiled::deltaPhi(double phi1, double phi2) {
+  return reco::deltaPhi( phi1, phi2 );
+}
+
+double reco::parser::compiled::testBit(double mask, double iBit) {
+  return ( int( mask ) >> int( iBit ) ) & 1;
+}
@@ -0,0 +1,73 @@
+#ifndef CommonTools_Utils_ExpressionCompiler_h
+#define CommonTools_Utils_ExpressionCompiler_h
+/* \class reco::parser::ExpressionCompiler
+ *
+ * Compiles parsed cuts and expressions to native code with the
+ * ROOT interpreter, so that they are evaluated without going
+ * through the dictionaries at each call.
+ *
+ * The parsed tree is written as a C++ function of the object
+ * (see SelectorBase::cppCode and ExpressionBase::cppCode) and
+ * compiled once for each (type, expression) by a compiler: the
+ * selectors and functions of the same cut share the compiled code.
+ * The compiler keeps the functions by expression, this cache is
+ * released with it (the code itself stays in the interpreter).
+ *
+ * A null pointer is returned if the expression can't be compiled
+ * (e.g. lazy parsing, for which the methods depend on the dynamic
+ * type of the objects): the parsed tree must then be used.
+ *
+ * StringCutObjectSelector and StringObjectFunction use the compiler
+ * of the StringExpressionCompiler service (see reco::parser::compile
+ * below), if it is configured and enabled.
+ *
+ */
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace edm { class TypeWithDict; }
+
+namespace reco {
+  namespace parser {
+    class SelectorBase;
+    struct ExpressionBase;
+
+    class ExpressionCompiler {
+    public:
+      typedef bool (*Selector)(const void *);
+      typedef double (*Function)(const void *);
+
+      ExpressionCompiler() { }
+      ExpressionCompiler(const ExpressionCompiler &) = delete;
+      ExpressionCompiler & operator=(const ExpressionCompiler &) = delete;
+
+      Selector compile(const edm::TypeWithDict & type, const SelectorBase & select);
+      Function compile(const edm::TypeWithDict & type, const ExpressionBase & expr);
+
+    private:
+      void * compile(const edm::TypeWithDict & type, const char * returnType, const std::string & code);
+
+      std::mutex mutex_;
+      /// compiled functions by type and code, null for the failures
+      std::map<std::string, void *> functions_;
+    };
+
+    /// compiled with the StringExpressionCompiler service, null if the service
+    /// is not configured or disabled (or outside of the framework), or if the
+    /// expression can't be compiled
+    ExpressionCompiler::Selector compile(const edm::TypeWithDict & type, const SelectorBase & select);
+    ExpressionCompiler::Function compile(const edm::TypeWithDict & type, const ExpressionBase & expr);
+
+    /// functions called by the compiled code
+    namespace compiled {
+      [[noreturn]] void nullPointer(const char * method);
+      double chi2prob(double x, double ndof);
+      double deltaR(double eta1, double phi1, double eta2, double phi2);
+      double deltaPhi(double phi1, double phi2);
+      double testBit(double mask, double iBit);
+    }
+  }
+}
+
+#endif
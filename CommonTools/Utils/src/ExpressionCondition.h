@@ -21,6 +21,12 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return (*cond_)(o) ? true_->value(o) : false_->value(o);
       }
+      bool cppCode(std::string & code) const override {
+	std::string cond, t, f;
+	if (!cond_->cppCode(cond) || !true_->cppCode(t) || !false_->cppCode(f)) return false;
+	code += "(" + cond + " ? " + t + " : " + f + ")";
+	return true;
+      }
       ExpressionCondition(ExpressionStack & expStack, SelectorStack & selStack) { 
 	false_ = expStack.back(); expStack.pop_back();
 	true_  = expStack.back(); expStack.pop_back();
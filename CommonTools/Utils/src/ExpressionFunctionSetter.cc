@@ -32,6 +32,30 @@ namespace reco {
     struct tan_f { double operator()( double x ) const { return tan( x ); } };
     struct tanh_f { double operator()( double x ) const { return tanh( x ); } };
     struct test_bit_f { double operator()( double mask, double iBit ) const { return (int(mask) >> int(iBit)) & 1; } };
+
+    RECO_PARSER_OPERATOR_CODE( abs_f, "std::fabs", false )
+    RECO_PARSER_OPERATOR_CODE( acos_f, "std::acos", false )
+    RECO_PARSER_OPERATOR_CODE( asin_f, "std::asin", false )
+    RECO_PARSER_OPERATOR_CODE( atan_f, "std::atan", false )
+    RECO_PARSER_OPERATOR_CODE( atan2_f, "std::atan2", false )
+    RECO_PARSER_OPERATOR_CODE( chi2prob_f, "reco::parser::compiled::chi2prob", false )
+    RECO_PARSER_OPERATOR_CODE( cos_f, "std::cos", false )
+    RECO_PARSER_OPERATOR_CODE( cosh_f, "std::cosh", false )
+    RECO_PARSER_OPERATOR_CODE( deltaR_f, "reco::parser::compiled::deltaR", false )
+    RECO_PARSER_OPERATOR_CODE( deltaPhi_f, "reco::parser::compiled::deltaPhi", false )
+    RECO_PARSER_OPERATOR_CODE( exp_f, "std::exp", false )
+    RECO_PARSER_OPERATOR_CODE( hypot_f, "std::hypot", false )
+    RECO_PARSER_OPERATOR_CODE( log_f, "std::log", false )
+    RECO_PARSER_OPERATOR_CODE( log10_f, "std::log10", false )
+    RECO_PARSER_OPERATOR_CODE( max_f, "std::max", false )
+    RECO_PARSER_OPERATOR_CODE( min_f, "std::min", false )
+    RECO_PARSER_OPERATOR_CODE( pow_f, "std::pow", false )
+    RECO_PARSER_OPERATOR_CODE( sin_f, "std::sin", false )
+    RECO_PARSER_OPERATOR_CODE( sinh_f, "std::sinh", false )
+    RECO_PARSER_OPERATOR_CODE( sqrt_f, "std::sqrt", false )
+    RECO_PARSER_OPERATOR_CODE( tan_f, "std::tan", false )
+    RECO_PARSER_OPERATOR_CODE( tanh_f, "std::tanh", false )
+    RECO_PARSER_OPERATOR_CODE( test_bit_f, "reco::parser::compiled::testBit", false )
   }
 }
 
@@ -11,11 +11,21 @@
  *
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
+#include <cmath>
+#include <cstdio>
 
 namespace reco {
   namespace parser {
     struct ExpressionNumber : public ExpressionBase {
       double value( const edm::ObjectWithDict& ) const override { return value_; }
+      bool cppCode( std::string & code ) const override {
+	if( !std::isfinite( value_ ) ) return false;
+	char number[32];
+	// enough digits to read back the same double
+	snprintf( number, sizeof( number ), "double(%.17g)", value_ );
+	code += number;
+	return true;
+      }
       ExpressionNumber( double value ) : value_( value ) { }
     private:
       double value_;
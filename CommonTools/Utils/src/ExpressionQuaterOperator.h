@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include "CommonTools/Utils/src/OperatorCode.h"
 
 namespace reco {
   namespace parser {
@@ -20,6 +21,13 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return op_(args_[0]->value(o), args_[1]->value(o), args_[2]->value(o), args_[3]->value(o));
       }
+      bool cppCode(std::string & code) const override {
+	if (OperatorCode<Op>::name() == nullptr) return false;
+	std::string args[4];
+	for (int i = 0; i < 4; ++i) if (!args_[i]->cppCode(args[i])) return false;
+	code += OperatorCode<Op>::name() + ("(" + args[0] + ", " + args[1] + ", " + args[2] + ", " + args[3] + ")");
+	return true;
+      }
       ExpressionQuaterOperator(ExpressionStack & expStack) { 
 	args_[3] = expStack.back(); expStack.pop_back();
 	args_[2] = expStack.back(); expStack.pop_back();
@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include "CommonTools/Utils/src/OperatorCode.h"
 
 namespace reco {
   namespace parser {
@@ -20,6 +21,12 @@ namespace reco {
       double value(const edm::ObjectWithDict& o) const override { 
 	return op_((*exp_).value(o));
       }
+      bool cppCode(std::string & code) const override {
+	std::string exp;
+	if (OperatorCode<Op>::name() == nullptr || !exp_->cppCode(exp)) return false;
+	code += std::string("(") + OperatorCode<Op>::name() + "(" + exp + "))";
+	return true;
+      }
       ExpressionUnaryOperator(ExpressionStack & expStack) { 
 	exp_ = expStack.back(); expStack.pop_back();
       }
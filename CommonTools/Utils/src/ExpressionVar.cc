@@ -158,6 +158,24 @@ double ExpressionVar::value(const edm::ObjectWithDict& obj) const
   return ret;
 }
 
+bool ExpressionVar::cppCode(std::string& code) const
+{
+  std::string var = "obj";
+  for (std::vector<MethodInvoker>::const_iterator I = methods_.begin(), E = methods_.end(); I != E; ++I) {
+    if (!I->cppCode(var)) {
+      return false;
+    }
+  }
+  // enums are read as int, like in objToDouble
+  if (retType_ == method::enumType) {
+    code += "double(int(" + var + "))";
+  }
+  else {
+    code += "double(" + var + ")";
+  }
+  return true;
+}
+
 double
 ExpressionVar::objToDouble(const edm::ObjectWithDict& obj,
                            method::TypeCode type)
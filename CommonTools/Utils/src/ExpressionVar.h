@@ -54,6 +54,7 @@ public: // Public Methods
   ExpressionVar(const ExpressionVar&);
   ~ExpressionVar() override;
   double value(const edm::ObjectWithDict&) const override;
+  bool cppCode(std::string&) const override;
 };
 
 /// Same as ExpressionVar but with lazy resolution of object methods
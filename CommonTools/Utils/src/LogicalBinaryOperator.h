@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/src/SelectorStack.h"
+#include "CommonTools/Utils/src/OperatorCode.h"
 
 namespace reco {
   namespace parser {    
@@ -22,6 +23,12 @@ namespace reco {
 	lhs_ = selStack.back(); selStack.pop_back();
       }
       bool operator()(const edm::ObjectWithDict& o) const override ;
+      bool cppCode(std::string & code) const override {
+	std::string lhs, rhs;
+	if (OperatorCode<Op>::name() == nullptr || !lhs_->cppCode(lhs) || !rhs_->cppCode(rhs)) return false;
+	code += "(" + lhs + " " + OperatorCode<Op>::name() + " " + rhs + ")";
+	return true;
+      }
       private:
       Op op_;
       SelectorPtr lhs_, rhs_;
@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/src/SelectorStack.h"
+#include "CommonTools/Utils/src/OperatorCode.h"
 
 namespace reco {
   namespace parser {    
@@ -23,6 +24,12 @@ namespace reco {
       bool operator()(const edm::ObjectWithDict& o) const override {
 	return op_((*rhs_)(o));
       }
+      bool cppCode(std::string & code) const override {
+	std::string rhs;
+	if (OperatorCode<Op>::name() == nullptr || !rhs_->cppCode(rhs)) return false;
+	code += std::string("(") + OperatorCode<Op>::name() + rhs + ")";
+	return true;
+      }
       private:
       Op op_;
       SelectorPtr rhs_;
@@ -5,11 +5,67 @@
 #include "CommonTools/Utils/src/findMethod.h"
 #include "CommonTools/Utils/src/returnType.h"
 #include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
 using namespace reco::parser;
 using namespace std;
 
+namespace {
+  /// C++ literal of a method argument, with the exact type of the
+  /// parameter so that the same overload is called
+  struct AnyMethodArgument2Code : public boost::static_visitor<bool> {
+    AnyMethodArgument2Code(std::string& code) : code_(code) { }
+    bool operator()(int8_t v) const { return integer("int8_t", v); }
+    bool operator()(uint8_t v) const { return integer("uint8_t", v); }
+    bool operator()(int16_t v) const { return integer("int16_t", v); }
+    bool operator()(uint16_t v) const { return integer("uint16_t", v); }
+    bool operator()(int32_t v) const { return integer("int32_t", v); }
+    bool operator()(uint32_t v) const { return integer("uint32_t", v); }
+    bool operator()(int64_t v) const { return integer("int64_t", v); }
+    bool operator()(uint64_t v) const { return integer("uint64_t", v); }
+    // unsigned long, when it is none of the above
+    template<typename T>
+    typename boost::enable_if<boost::is_integral<T>, bool>::type
+    operator()(T v) const { return integer("(unsigned long)", v); }
+    // any other type: not compiled, the parsed expression is used
+    template<typename T>
+    typename boost::disable_if<boost::is_integral<T>, bool>::type
+    operator()(const T&) const { return false; }
+    bool operator()(double v) const { return floating("double(%.17g)", v); }
+    bool operator()(float v) const { return floating("float(%.9g)", v); }
+    bool operator()(const std::string& v) const {
+      code_ += "std::string(\"";
+      for (char c : v) {
+        if (c == '"' || c == '\\') code_ += '\\';
+        else if (c < ' ' || c > '~') return false;
+        code_ += c;
+      }
+      code_ += "\")";
+      return true;
+    }
+  private:
+    template<typename T>
+    bool integer(const char* type, T v) const {
+      // the most negative values can't be written as literals
+      if (std::numeric_limits<T>::is_signed && v == std::numeric_limits<T>::min()) return false;
+      code_ += std::string(type) + "(" + std::to_string(v) + ")";
+      return true;
+    }
+    bool floating(const char* format, double v) const {
+      if (!std::isfinite(v)) return false;
+      char number[32];
+      snprintf(number, sizeof(number), format, v);
+      code_ += number;
+      return true;
+    }
+    std::string& code_;
+  };
+}
+
 MethodInvoker::
 MethodInvoker(const edm::FunctionWithDict& method,
               const vector<AnyMethodArgument>& ints)
@@ -173,6 +229,42 @@ invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
   return ret;
 }
 
+bool
+MethodInvoker::
+cppCode(std::string& code) const
+{
+  // deref (see ExpressionCompiler) strips pointers, throwing on null ones
+  std::string call = "deref(" + code + "." + methodName();
+  if (isFunction_) {
+    call += "(";
+    size_t i = 0;
+    for (auto const& param : method_) {
+      if (i == ints_.size()) {
+        break;
+      }
+      if (i != 0) {
+        call += ", ";
+      }
+      // the enum values are stored as int, see AnyMethodArgumentFixup
+      edm::TypeWithDict parameter(param);
+      bool isEnum = parameter.isEnum();
+      if (isEnum) {
+        call += "static_cast<" + parameter.stripConstRef().cppName() + ">(";
+      }
+      if (!boost::apply_visitor(AnyMethodArgument2Code(call), ints_[i])) {
+        return false;
+      }
+      if (isEnum) {
+        call += ")";
+      }
+      ++i;
+    }
+    call += ")";
+  }
+  code = call + ", \"" + methodName() + "\")";
+  return true;
+}
+
 LazyInvoker::
 LazyInvoker(const std::string& name,
             const std::vector<AnyMethodArgument>& args)
@@ -307,4 +399,3 @@ throwFailedConversion(const edm::ObjectWithDict& o) const
       << "\" retured a \"" << o.typeOf().qualifiedName()
       << "\" which is not convertible to double.";
 }
-
@@ -60,6 +60,10 @@ public: // Public Function Members
   /// before calling 'invoke', and of deallocating it afterwards
   edm::ObjectWithDict invoke(const edm::ObjectWithDict& obj,
                              edm::ObjectWithDict& retstore) const;
+  /// Wraps the C++ code of the object in the call of the method,
+  /// dereferencing the result like invoke does.
+  /// Returns false if the call can't be written in C++
+  bool cppCode(std::string& code) const;
 };
 
 /// A bigger brother of the MethodInvoker:
@@ -0,0 +1,50 @@
+#ifndef CommonTools_Utils_OperatorCode_h
+#define CommonTools_Utils_OperatorCode_h
+/* \class reco::parser::OperatorCode
+ *
+ * C++ spelling of the operators and functions of parsed
+ * expressions, used to compile them (see ExpressionCompiler).
+ * The default is a null name: the operator can't be compiled
+ * and the expression is evaluated through the dictionaries.
+ * infix() tells if the name goes between the operands or is
+ * called as a function of them.
+ *
+ */
+#include <functional>
+
+namespace reco {
+  namespace parser {
+    template<typename T> struct power_of;
+
+    template<typename Op>
+    struct OperatorCode {
+      static const char * name() { return nullptr; }
+      static bool infix() { return false; }
+    };
+
+#define RECO_PARSER_OPERATOR_CODE(OP, NAME, INFIX)			\
+    template<>								\
+    struct OperatorCode<OP> {						\
+      static const char * name() { return NAME; }			\
+      static bool infix() { return INFIX; }				\
+    };
+
+    RECO_PARSER_OPERATOR_CODE(std::less<double>, "<", true)
+    RECO_PARSER_OPERATOR_CODE(std::less_equal<double>, "<=", true)
+    RECO_PARSER_OPERATOR_CODE(std::equal_to<double>, "==", true)
+    RECO_PARSER_OPERATOR_CODE(std::greater_equal<double>, ">=", true)
+    RECO_PARSER_OPERATOR_CODE(std::greater<double>, ">", true)
+    RECO_PARSER_OPERATOR_CODE(std::not_equal_to<double>, "!=", true)
+    RECO_PARSER_OPERATOR_CODE(std::logical_and<bool>, "&&", true)
+    RECO_PARSER_OPERATOR_CODE(std::logical_or<bool>, "||", true)
+    RECO_PARSER_OPERATOR_CODE(std::logical_not<bool>, "!", false)
+    RECO_PARSER_OPERATOR_CODE(std::plus<double>, "+", true)
+    RECO_PARSER_OPERATOR_CODE(std::minus<double>, "-", true)
+    RECO_PARSER_OPERATOR_CODE(std::multiplies<double>, "*", true)
+    RECO_PARSER_OPERATOR_CODE(std::divides<double>, "/", true)
+    RECO_PARSER_OPERATOR_CODE(std::negate<double>, "-", false)
+    RECO_PARSER_OPERATOR_CODE(power_of<double>, "std::pow", false)
+  }
+}
+
+#endif
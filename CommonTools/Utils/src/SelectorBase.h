@@ -10,6 +10,8 @@
  *
  */
 
+#include <string>
+
 namespace edm {class ObjectWithDict;}
 
 namespace reco {
@@ -20,6 +22,9 @@ namespace reco {
       virtual ~SelectorBase() { }
       /// return true if the object is selected
       virtual bool operator()(const edm::ObjectWithDict & c) const = 0;
+      /// append the C++ code of the selection of "obj",
+      /// return false if it can't be compiled
+      virtual bool cppCode(std::string &) const { return false; }
     };
   }
 }
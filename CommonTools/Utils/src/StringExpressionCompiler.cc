@@ -0,0 +1,42 @@
+#include "CommonTools/Utils/interface/StringExpressionCompiler.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+using namespace reco::parser;
+
+StringExpressionCompiler::StringExpressionCompiler(const edm::ParameterSet & iConfig, edm::ActivityRegistry &) :
+  enable_(iConfig.getParameter<bool>("enable")) {
+}
+
+void StringExpressionCompiler::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<bool>("enable", true)->setComment("compile the string cuts and expressions, use the parsed ones if false");
+  descriptions.add("StringExpressionCompiler", desc);
+}
+
+namespace {
+  ExpressionCompiler * serviceCompiler() {
+    try {
+      edm::Service<StringExpressionCompiler> service;
+      return service.isAvailable() ? service->compiler() : nullptr;
+    }
+    catch( const edm::Exception & e ) {
+      // no services outside of the framework (FWLite, standalone programs)
+      if( e.categoryCode() == edm::errors::NotFound ) return nullptr;
+      throw;
+    }
+  }
+}
+
+ExpressionCompiler::Selector reco::parser::compile(const edm::TypeWithDict & type, const SelectorBase & select) {
+  ExpressionCompiler * compiler = serviceCompiler();
+  return compiler != nullptr ? compiler->compile( type, select ) : nullptr;
+}
+
+ExpressionCompiler::Function reco::parser::compile(const edm::TypeWithDict & type, const ExpressionBase & expr) {
+  ExpressionCompiler * compiler = serviceCompiler();
+  return compiler != nullptr ? compiler->compile( type, expr ) : nullptr;
+}
@@ -1,11 +1,14 @@
 #include "CommonTools/Utils/interface/TMVAEvaluator.h"
 
 #include "CommonTools/Utils/interface/TMVAZipReader.h"
+#include "CommonTools/Utils/interface/TMVAForestCache.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "CondFormats/DataRecord/interface/GBRWrapperRcd.h"
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "TMVA/MethodBDT.h"
 
+#include <algorithm>
+
 
 TMVAEvaluator::TMVAEvaluator() :
   mIsInitialized(false), mUsingGBRForest(false), mUseAdaBoost(false)
@@ -15,6 +18,26 @@ TMVAEvaluator::TMVAEvaluator() :
 void TMVAEvaluator::initialize(const std::string & options, const std::string & method, const std::string & weightFile,
                                const std::vector<std::string> & variables, const std::vector<std::string> & spectators, bool useGBRForest, bool useAdaBoost)
 {
+  if (useGBRForest)
+  {
+    // the forest is read once per process and shared, no reader is needed
+    // (and the reader options do not apply)
+    auto model = reco::getSharedTMVAForest(method, weightFile, variables, spectators);
+    mGBRForest = std::shared_ptr<const GBRForest>(model, &model->forest);
+    mFlatForest = std::shared_ptr<const GBRForestFlat>(model, &model->flat);
+    mMethod = method;
+
+    for(std::vector<std::string>::const_iterator it = variables.begin(); it!=variables.end(); ++it)
+      mVariables.insert( std::make_pair( *it, std::make_pair( it - variables.begin(), 0. ) ) );
+    for(std::vector<std::string>::const_iterator it = spectators.begin(); it!=spectators.end(); ++it)
+      mSpectators.insert( std::make_pair( *it, std::make_pair( it - spectators.begin(), 0. ) ) );
+
+    mIsInitialized = true;
+    mUsingGBRForest = true;
+    mUseAdaBoost = useAdaBoost;
+    return;
+  }
+
   // initialize the TMVA reader
   mReader.reset(new TMVA::Reader(options.c_str()));
   mReader->SetVerbose(false);
@@ -37,17 +60,6 @@ void TMVAEvaluator::initialize(const std::string & options, const std::string &
   // load the TMVA weights
   reco::details::loadTMVAWeights(mReader.get(), mMethod, weightFile);
 
-  if (useGBRForest)
-  {
-    mGBRForest.reset( new GBRForest( dynamic_cast<TMVA::MethodBDT*>( mReader->FindMVA(mMethod.c_str()) ) ) );
-
-    // now can free some memory
-    mReader.reset(nullptr);
-
-    mUsingGBRForest = true;
-    mUseAdaBoost = useAdaBoost;
-  }
-
   mIsInitialized = true;
 }
 
@@ -65,6 +77,7 @@ void TMVAEvaluator::initializeGBRForest(const GBRForest* gbrForest, const std::v
 
   // do not take ownership if getting GBRForest from an external source
   mGBRForest = std::shared_ptr<const GBRForest>(gbrForest, [](const GBRForest*) {} );
+  mFlatForest = std::make_shared<const GBRForestFlat>(*gbrForest);
 
   mIsInitialized = true;
   mUsingGBRForest = true;
@@ -136,13 +149,30 @@ float TMVAEvaluator::evaluateGBRForest(const std::map<std::string,float> & input
       edm::LogError("MissingInputVariable") << "Input variable " << it->first << " is missing from the list of inputs. The returned discriminator value might not be sensible.";
   }
 
-  // evaluate the MVA
+  value = evaluateGBRForest(vars.get());
+
+  return value;
+}
+
+
+float TMVAEvaluator::evaluateGBRForest(const float* inputs) const
+{
+  // the AdaBoost response of GBRForest is not transformed
   if (mUseAdaBoost)
-    value = mGBRForest->GetAdaBoostClassifier(vars.get());
+    return mFlatForest->GetResponse(inputs);
   else
-    value = mGBRForest->GetGradBoostClassifier(vars.get());
+    return mFlatForest->GetGradBoostClassifier(inputs);
+}
 
-  return value;
+
+void TMVAEvaluator::evaluateGBRForest(const float* inputs, unsigned int nCandidates, float* values) const
+{
+  std::vector<double> responses(nCandidates);
+  if (mUseAdaBoost)
+    mFlatForest->GetResponse(inputs, nCandidates, mVariables.size(), responses.data());
+  else
+    mFlatForest->GetGradBoostClassifier(inputs, nCandidates, mVariables.size(), responses.data());
+  std::copy(responses.begin(), responses.end(), values);
 }
 
 float TMVAEvaluator::evaluate(const std::map<std::string,float> & inputs, bool useSpectators) const
@@ -0,0 +1,56 @@
+#include "CommonTools/Utils/interface/TMVAForestCache.h"
+
+#include "CommonTools/Utils/interface/TMVAZipReader.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/thread_safety_macros.h"
+#include "TMVA/MethodBDT.h"
+#include "TMVA/Reader.h"
+
+#include <map>
+#include <mutex>
+
+namespace {
+
+  std::string cacheKey(const std::string& method, const std::string& weightFile,
+                       const std::vector<std::string>& variables, const std::vector<std::string>& spectators) {
+    std::string key = method + '\n' + weightFile;
+    for (auto const& v : variables) key += '\n' + v;
+    key += '\n';
+    for (auto const& s : spectators) key += '\n' + s;
+    return key;
+  }
+
+}
+
+std::shared_ptr<const reco::TMVAForest>
+reco::getSharedTMVAForest(const std::string& method, const std::string& weightFile,
+                          const std::vector<std::string>& variables, const std::vector<std::string>& spectators)
+{
+  // TMVA itself is not thread safe: the weight files are also read under the lock
+  CMS_THREAD_SAFE static std::mutex mutex;
+  CMS_THREAD_GUARD(mutex) static std::map<std::string, std::weak_ptr<const TMVAForest> > cache;
+
+  const std::string key = cacheKey(method, weightFile, variables, spectators);
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto& entry = cache[key];
+  if (auto model = entry.lock()) return model;
+
+  TMVA::Reader reader("!Color:Silent:!Error");
+  reader.SetVerbose(false);
+  // the reader needs addresses for the inputs, which are not used for the conversion
+  std::vector<float> dummy(variables.size()+spectators.size(), 0.f);
+  for (unsigned int i = 0; i < variables.size(); ++i) reader.AddVariable(variables[i], &dummy[i]);
+  for (unsigned int i = 0; i < spectators.size(); ++i) reader.AddSpectator(spectators[i], &dummy[variables.size()+i]);
+  reco::details::loadTMVAWeights(&reader, method, weightFile);
+
+  auto bdt = dynamic_cast<TMVA::MethodBDT*>(reader.FindMVA(method.c_str()));
+  if (bdt == nullptr)
+    throw cms::Exception("TMVAForestCache") << "Method " << method << " in " << weightFile << " is not a BDT";
+
+  auto model = std::make_shared<const TMVAForest>(bdt);
+  entry = model;
+  LogDebug("TMVAForestCache") << "Loaded " << method << " from " << weightFile << " (" << model->flat.NTrees() << " trees)";
+  return model;
+}
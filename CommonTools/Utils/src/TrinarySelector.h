@@ -29,6 +29,13 @@ namespace reco {
 	  cmp1_->compare( lhs_->value( o ), mid_->value( o ) ) &&
 	  cmp2_->compare( mid_->value( o ), rhs_->value( o ) );
       }
+      bool cppCode( std::string & code ) const override {
+	std::string lhs, mid, rhs, cmp1, cmp2;
+	if( !lhs_->cppCode( lhs ) || !mid_->cppCode( mid ) || !rhs_->cppCode( rhs ) ||
+	    !cmp1_->cppCode( cmp1, lhs, mid ) || !cmp2_->cppCode( cmp2, mid, rhs ) ) return false;
+	code += "(" + cmp1 + " && " + cmp2 + ")";
+	return true;
+      }
       boost::shared_ptr<ExpressionBase> lhs_;
       boost::shared_ptr<ComparisonBase> cmp1_;
       boost::shared_ptr<ExpressionBase> mid_;
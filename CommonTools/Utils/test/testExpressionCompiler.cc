@@ -0,0 +1,290 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "CommonTools/Utils/interface/cutParser.h"
+#include "CommonTools/Utils/interface/expressionParser.h"
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "CommonTools/Utils/interface/StringObjectFunction.h"
+#include "CommonTools/Utils/interface/StringExpressionCompiler.h"
+#include "CommonTools/Utils/src/ExpressionCompiler.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackExtra.h"
+#include "DataFormats/Candidate/interface/CompositeCandidate.h"
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/Common/interface/TestHandle.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceToken.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <typeinfo>
+
+// checks that the compiled cuts and expressions give the same results
+// as the parsed ones, on the expressions of testCutParser and testExpressionParser
+
+namespace {
+  // translates to code that doesn't compile
+  struct BrokenSelector : public reco::parser::SelectorBase {
+    bool operator()(const edm::ObjectWithDict &) const override { return true; }
+    bool cppCode(std::string & code) const override {
+      code += "obj.doesNotExist()";
+      return true;
+    }
+  };
+}
+
+class testExpressionCompiler : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testExpressionCompiler);
+  CPPUNIT_TEST(checkCuts);
+  CPPUNIT_TEST(checkExpressions);
+  CPPUNIT_TEST(checkNullPointer);
+  CPPUNIT_TEST(checkFallback);
+  CPPUNIT_TEST(checkService);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown() {}
+  void checkCuts();
+  void checkExpressions();
+  void checkNullPointer();
+  void checkFallback();
+  void checkService();
+
+private:
+  template<typename T> void checkCut(const T &, const std::string &);
+  template<typename T> void checkExpression(const T &, const std::string &);
+  edm::ServiceToken serviceToken(bool enable);
+
+  reco::parser::ExpressionCompiler compiler_;
+  edm::ActivityRegistry registry_;
+  reco::TrackExtraCollection trkExtras;
+  reco::Track trk;
+  std::vector<reco::LeafCandidate> cands;
+  reco::CompositeCandidate cand;
+  pat::Jet jet;
+  pat::Muon muon;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testExpressionCompiler);
+
+void testExpressionCompiler::setUp() {
+  const double chi2 = 20.0;
+  const int ndof = 10;
+  reco::Track::Point v(1, 2, 3);
+  reco::Track::Vector p(5, 3, 10);
+  double e[] = { 1.1,
+                 1.2, 2.2,
+                 1.3, 2.3, 3.3,
+                 1.4, 2.4, 3.4, 4.4,
+                 1.5, 2.5, 3.5, 4.5, 5.5 };
+  reco::TrackBase::CovarianceMatrix cov(e, e + 15);
+  trk = reco::Track(chi2, ndof, v, p, -1, cov);
+  trk.setQuality(reco::Track::highPurity);
+  trk.setAlgorithm(reco::Track::pixelPairStep);
+
+  reco::Track::Point outerV(100, 200, 300);
+  reco::Track::Vector outerP(0.5, 3.5, 10.5);
+  reco::Track::CovarianceMatrix outerC, innerC;
+  trkExtras.clear();
+  trkExtras.push_back(reco::TrackExtra(outerV, outerP, true, v, p, true,
+                                       outerC, 123, innerC, 456, reco::anyDirection));
+  edm::TestHandle<reco::TrackExtraCollection> h(&trkExtras, edm::ProductID(1));
+  trk.setExtra(reco::TrackExtraRef(h, 0));
+
+  reco::Candidate::LorentzVector p1(1, 2, 3, 4);
+  reco::Candidate::LorentzVector p2(1.1, -2.5, 4.3, 13.7);
+  reco::LeafCandidate c1(+1, p1);
+  reco::LeafCandidate c2(-1, p2);
+  cand = reco::CompositeCandidate();
+  cand.addDaughter(c1);
+  cand.addDaughter(c2);
+
+  cands.clear();
+  cands.push_back(c1);
+  cands.push_back(c2);
+  edm::TestHandle<std::vector<reco::LeafCandidate> > constituentsHandle(&cands, edm::ProductID(42));
+  reco::Jet::Constituents constituents;
+  constituents.push_back(reco::Jet::Constituent(constituentsHandle, 0));
+  constituents.push_back(reco::Jet::Constituent(constituentsHandle, 1));
+  reco::CaloJet::Specific caloSpecific; caloSpecific.mMaxEInEmTowers = 0.5;
+  jet = pat::Jet(reco::CaloJet(p1+p2, reco::Jet::Point(), caloSpecific, constituents));
+  jet.addBDiscriminatorPair(std::pair<std::string,float>("aaa", 1.0));
+  jet.addBDiscriminatorPair(std::pair<std::string,float>("b c", 2.0));
+
+  muon = pat::Muon(reco::Muon(+1, p1+p2));
+  muon.setUserIso(2.0);
+  muon.setUserIso(42.0, 1);
+}
+
+edm::ServiceToken testExpressionCompiler::serviceToken(bool enable) {
+  edm::ParameterSet pset;
+  pset.addParameter<bool>("enable", enable);
+  return edm::ServiceRegistry::createContaining(std::make_unique<StringExpressionCompiler>(pset, registry_));
+}
+
+template<typename T>
+void testExpressionCompiler::checkCut(const T & obj, const std::string & cut) {
+  std::cerr << "checking cut: \"" << cut << "\"" << std::endl;
+  reco::parser::SelectorPtr sel;
+  CPPUNIT_ASSERT(reco::parser::cutParser<T>(cut, sel));
+  edm::TypeWithDict t(typeid(T));
+  reco::parser::ExpressionCompiler::Selector f = compiler_.compile(t, *sel);
+  CPPUNIT_ASSERT(f != nullptr);
+  edm::ObjectWithDict o(t, const_cast<T *>(&obj));
+  CPPUNIT_ASSERT_EQUAL((*sel)(o), f(&obj));
+}
+
+template<typename T>
+void testExpressionCompiler::checkExpression(const T & obj, const std::string & expression) {
+  std::cerr << "checking expression: \"" << expression << "\"" << std::endl;
+  reco::parser::ExpressionPtr expr;
+  CPPUNIT_ASSERT(reco::parser::expressionParser<T>(expression, expr));
+  edm::TypeWithDict t(typeid(T));
+  reco::parser::ExpressionCompiler::Function f = compiler_.compile(t, *expr);
+  CPPUNIT_ASSERT(f != nullptr);
+  edm::ObjectWithDict o(t, const_cast<T *>(&obj));
+  double parsed = expr->value(o);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(parsed, f(&obj), 1.e-9 * std::max(1., std::abs(parsed)));
+}
+
+void testExpressionCompiler::checkCuts() {
+  checkCut(trk, "");
+  checkCut(trk, "pt");
+  checkCut(trk, "pt > 2");
+  checkCut(trk, "charge < 0");
+  checkCut(trk, "pt = 3");
+  checkCut(trk, "pt != 3");
+  checkCut(trk, "! pt == 3");
+  checkCut(trk, "2.9 < pt < 3.1");
+  checkCut(trk, "pt > 2 & charge < 0");
+  checkCut(trk, "pt < 2 | charge > 0");
+  checkCut(trk, "pt > 2 | charge > 0 | (pt < 2 && charge < 0)");
+  checkCut(trk, "-pt < -2");
+  checkCut(trk, "26.9 < 3 * pt ^ 2 < 27.1");
+  checkCut(trk, "( 0.99 < sin( phi ) < 1.01 ) & ( -0.01 < cos( phi ) < 0.01 )");
+  checkCut(trk, "! (( 0.99 < sin( phi ) < 1.01 ) & ( -0.01 < cos( phi ) < 0.01 ))");
+  checkCut(trk, "pt && pt > 1");
+  // bit tests
+  checkCut(trk, "test_bit(7, 0)");
+  checkCut(trk, "test_bit(7, 3)");
+  checkCut(trk, "test_bit(4, 2)");
+  // enum arguments and bool returns
+  checkCut(trk, "quality('highPurity')");
+  checkCut(trk, "quality('loose')");
+  checkCut(trk, "quality('goodIterative')");
+  // Ref chaining
+  checkCut(trk, "extra.outerPhi > 0");
+  checkCut(cand, "daughter(0).isStandAloneMuon");
+  checkCut(cand, "daughter(0).pt > daughter(1).pt");
+}
+
+void testExpressionCompiler::checkExpressions() {
+  checkExpression(trk, "pt");
+  checkExpression(trk, "charge");
+  checkExpression(trk, "pt/3");
+  // method arguments
+  checkExpression(trk, "covariance(0, 0)");
+  checkExpression(trk, "covariance(1, 0)");
+  checkExpression(trk, "momentum.x");
+  checkExpression(trk, "hitPattern.numberOfValidHits");
+  checkExpression(trk, "referencePoint.R");
+  // enum returns and arguments
+  checkExpression(trk, "algo");
+  checkExpression(trk, "quality('highPurity')");
+  // Ref chaining
+  checkExpression(trk, "extra.outerPhi");
+  checkExpression(trk, "extra.outerPosition.z");
+  checkExpression(trk, "cosh(theta)");
+  checkExpression(trk, "hypot(px, py)");
+  checkExpression(trk, "chi2prob(chi2, ndof)");
+  checkExpression(trk, "test_bit(hitPattern.numberOfValidHits, 0)");
+  // ternaries
+  checkExpression(trk, "?ndof<0?1:0");
+  checkExpression(trk, "?ndof=10?1:0");
+  checkExpression(trk, "?pt>2?pt:-pt");
+  // pointer chaining and bool returns
+  checkExpression<reco::Candidate>(cand, "numberOfDaughters");
+  checkExpression<reco::Candidate>(cand, "daughter(0).isStandAloneMuon");
+  checkExpression<reco::Candidate>(cand, "daughter(1).pt");
+  checkExpression<reco::Candidate>(cand, "min(daughter(0).pt, daughter(1).pt)");
+  checkExpression<reco::Candidate>(cand, "max(daughter(0).pt, daughter(1).pt)");
+  checkExpression<reco::Candidate>(cand, "deltaPhi(daughter(0).phi, daughter(1).phi)");
+  checkExpression<reco::Candidate>(cand, "deltaPhi(daughter(1).phi, daughter(0).phi)");
+  checkExpression<reco::Candidate>(cand, "deltaR(daughter(0).eta, daughter(0).phi, daughter(1).eta, daughter(1).phi)");
+  // double and string arguments
+  checkExpression(jet, "nCarrying(1.0)");
+  checkExpression(jet, "nCarrying(0.1)");
+  checkExpression(jet, "maxEInEmTowers");
+  checkExpression(jet, "bDiscriminator(\"aaa\")");
+  checkExpression(jet, "bDiscriminator('b c')");
+  // default and integer arguments
+  checkExpression(muon, "userIso");
+  checkExpression(muon, "userIso()");
+  checkExpression(muon, "userIso(0)");
+  checkExpression(muon, "userIso(1)");
+}
+
+void testExpressionCompiler::checkNullPointer() {
+  // daughter(2) is null: both throw
+  reco::parser::ExpressionPtr expr;
+  CPPUNIT_ASSERT(reco::parser::expressionParser<reco::Candidate>("daughter(2).pt", expr));
+  edm::TypeWithDict t(typeid(reco::Candidate));
+  reco::parser::ExpressionCompiler::Function f = compiler_.compile(t, *expr);
+  CPPUNIT_ASSERT(f != nullptr);
+  edm::ObjectWithDict o(t, &cand);
+  CPPUNIT_ASSERT_THROW(expr->value(o), edm::Exception);
+  CPPUNIT_ASSERT_THROW(f(&cand), edm::Exception);
+}
+
+void testExpressionCompiler::checkFallback() {
+  edm::TypeWithDict t(typeid(reco::Candidate));
+  // lazy parsing can't be translated, the methods depend on the dynamic type
+  reco::parser::ExpressionPtr expr;
+  CPPUNIT_ASSERT(reco::parser::expressionParser<reco::Candidate>("name.empty()", expr, true));
+  CPPUNIT_ASSERT(compiler_.compile(t, *expr) == nullptr);
+  // code that doesn't compile, also when asked again
+  BrokenSelector broken;
+  CPPUNIT_ASSERT(compiler_.compile(t, broken) == nullptr);
+  CPPUNIT_ASSERT(compiler_.compile(t, broken) == nullptr);
+
+  // the functions use the parsed expressions then
+  edm::ServiceRegistry::Operate operate(serviceToken(true));
+  StringObjectFunction<reco::Candidate, true> lazy("name.empty()");
+  CPPUNIT_ASSERT(!lazy.compiled());
+  CPPUNIT_ASSERT_EQUAL(1., lazy(cand));
+  StringCutObjectSelector<reco::Candidate, true> lazyCut("roles.size() == 0");
+  CPPUNIT_ASSERT(!lazyCut.compiled());
+  CPPUNIT_ASSERT(lazyCut(cand));
+}
+
+void testExpressionCompiler::checkService() {
+  {
+    // no services outside of the framework
+    StringCutObjectSelector<reco::Track> select("pt > 2");
+    CPPUNIT_ASSERT(!select.compiled());
+    CPPUNIT_ASSERT(select(trk));
+  }
+  {
+    edm::ServiceRegistry::Operate operate(serviceToken(false));
+    StringCutObjectSelector<reco::Track> select("pt > 2");
+    CPPUNIT_ASSERT(!select.compiled());
+    CPPUNIT_ASSERT(select(trk));
+  }
+  {
+    edm::ServiceRegistry::Operate operate(serviceToken(true));
+    StringCutObjectSelector<reco::Track> select("pt > 2");
+    CPPUNIT_ASSERT(select.compiled());
+    CPPUNIT_ASSERT(select(trk));
+    StringObjectFunction<reco::Track> function("covariance(1, 0)");
+    CPPUNIT_ASSERT(function.compiled());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(trk.covariance(1, 0), function(trk), 1.e-9);
+  }
+}
@@ -42,6 +42,7 @@
        //for backwards-compatibility
        double GetClassifier(const float* vector) const { return GetGradBoostClassifier(vector); }
        
+       double InitialResponse() const { return fInitialResponse; }
        void SetInitialResponse(double response) { fInitialResponse = response; }
        
        std::vector<GBRTree> &Trees() { return fTrees; }
@@ -0,0 +1,91 @@
+#ifndef EGAMMAOBJECTS_GBRForestFlat
+#define EGAMMAOBJECTS_GBRForestFlat
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// GBRForestFlat                                                        //
+//                                                                      //
+// Evaluation-only copy of a GBRForest, built once from the conditions  //
+// object (e.g. when its IOV changes) and not persistent itself.        //
+//                                                                      //
+// The nodes of all trees are stored in one contiguous array,           //
+// breadth-first within each tree, 16 bytes per node.                   //
+// Each cut value is also stored as its rank among the sorted distinct  //
+// cuts on the same variable: x > cut is the same as rank(x) > rank,    //
+// where rank(x) counts the cuts below x. The batch GetResponse         //
+// quantizes the inputs of all candidates once and then walks each      //
+// tree for a group of candidates in lockstep on integer comparisons.   //
+//                                                                      //
+// The responses are identical to the ones of GBRForest.                //
+//////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class GBRForest;
+
+class GBRForestFlat {
+
+  public:
+
+    GBRForestFlat();
+    explicit GBRForestFlat(const GBRForest &forest);
+
+    double GetResponse(const float* vector) const;
+    double GetGradBoostClassifier(const float* vector) const;
+    double GetClassifier(const float* vector) const { return GetGradBoostClassifier(vector); }
+
+    // nVectors candidates, the inputs of candidate i start at vectors+i*stride
+    void GetResponse(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const;
+    void GetGradBoostClassifier(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const;
+
+    unsigned int NTrees() const { return fRoots.size(); }
+    unsigned int NNodes() const { return fNodes.size(); }
+
+  private:
+
+    struct Node {
+      float cut;
+      uint16_t rank;  // rank of cut among the distinct cuts on var
+      uint8_t var;
+      int32_t left, right;  // >=0: next node, <0: ~(index of the response)
+    };
+
+    // candidates walked together through one tree
+    static constexpr unsigned int kGroupSize = 16;
+
+    double fInitialResponse;
+    std::vector<Node> fNodes;
+    std::vector<float> fResponses;
+    std::vector<unsigned int> fRoots;
+    std::vector<unsigned int> fDepths;  // longest path to a response, per tree
+
+    // sorted distinct cuts of variable v in [fCutOffsets[v], fCutOffsets[v+1])
+    unsigned int fNVars;
+    std::vector<float> fCuts;
+    std::vector<unsigned int> fCutOffsets;
+    bool fQuantized;  // false if a variable has too many distinct cuts for the ranks
+};
+
+//_______________________________________________________________________
+inline double GBRForestFlat::GetResponse(const float* vector) const {
+  double response = fInitialResponse;
+  for (unsigned int root : fRoots) {
+    int index = root;
+    do {
+      const Node &node = fNodes[index];
+      index = vector[node.var] > node.cut ? node.right : node.left;
+    } while (index>=0);
+    response += fResponses[~index];
+  }
+  return response;
+}
+
+//_______________________________________________________________________
+inline double GBRForestFlat::GetGradBoostClassifier(const float* vector) const {
+  double response = GetResponse(vector);
+  return 2.0/(1.0+exp(-2.0*response))-1; //MVA output between -1 and 1
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+//_______________________________________________________________________
+GBRForestFlat::GBRForestFlat() :
+  fInitialResponse(0.),
+  fNVars(0),
+  fCutOffsets(1,0),
+  fQuantized(true)
+{
+
+}
+
+//_______________________________________________________________________
+GBRForestFlat::GBRForestFlat(const GBRForest &forest) :
+  fInitialResponse(forest.InitialResponse()),
+  fNVars(0),
+  fQuantized(true)
+{
+  for (const GBRTree &tree : forest.Trees()) {
+    const unsigned int nodeOffset = fNodes.size();
+    const unsigned int responseOffset = fResponses.size();
+    fResponses.insert(fResponses.end(), tree.Responses().begin(), tree.Responses().end());
+
+    // breadth-first renumbering: local index -> global index
+    std::vector<int> global(tree.CutIndices().size(), -1);
+    std::vector<std::pair<int,unsigned int> > queue(1, std::make_pair(0,1U));  // local index, depth
+    unsigned int depth = 0;
+    global[0] = nodeOffset;
+    for (unsigned int iq = 0; iq < queue.size(); ++iq) {
+      const int local = queue[iq].first;
+      depth = std::max(depth, queue[iq].second);
+      // daughters > 0 are intermediate nodes, the others index the responses
+      for (int daughter : {tree.LeftIndices()[local], tree.RightIndices()[local]}) {
+        if (daughter > 0) {
+          global[daughter] = nodeOffset + queue.size();
+          queue.emplace_back(daughter, queue[iq].second+1);
+        }
+      }
+    }
+
+    auto link = [&](int daughter) -> int32_t {
+      return daughter > 0 ? global[daughter] : ~int32_t(responseOffset - daughter);
+    };
+    for (auto const &q : queue) {
+      const int local = q.first;
+      Node node;
+      node.cut = tree.CutVals()[local];
+      node.rank = 0;
+      node.var = tree.CutIndices()[local];
+      node.left = link(tree.LeftIndices()[local]);
+      node.right = link(tree.RightIndices()[local]);
+      fNodes.push_back(node);
+      fNVars = std::max(fNVars, node.var+1U);
+    }
+
+    fRoots.push_back(nodeOffset);
+    fDepths.push_back(depth);
+  }
+
+  // distinct cut values of each variable, and the rank of each node's cut
+  std::vector<std::vector<float> > cuts(fNVars);
+  for (auto const &node : fNodes) cuts[node.var].push_back(node.cut);
+  fCutOffsets.assign(1,0);
+  for (auto &varCuts : cuts) {
+    std::sort(varCuts.begin(), varCuts.end());
+    varCuts.erase(std::unique(varCuts.begin(), varCuts.end()), varCuts.end());
+    if (varCuts.size() > std::numeric_limits<uint16_t>::max()) fQuantized = false;
+    fCuts.insert(fCuts.end(), varCuts.begin(), varCuts.end());
+    fCutOffsets.push_back(fCuts.size());
+  }
+  if (!fQuantized) return;
+  for (auto &node : fNodes) {
+    auto const &varCuts = cuts[node.var];
+    node.rank = std::lower_bound(varCuts.begin(), varCuts.end(), node.cut) - varCuts.begin();
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestFlat::GetResponse(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const {
+  if (!fQuantized) {
+    for (unsigned int i = 0; i < nVectors; ++i) responses[i] = GetResponse(vectors+i*stride);
+    return;
+  }
+
+  // rank(x) = number of distinct cuts below x (0 for NaN, which fails all cuts as well)
+  std::vector<uint16_t> ranks(std::size_t(nVectors)*fNVars);
+  for (unsigned int i = 0; i < nVectors; ++i) {
+    const float *vector = vectors+i*stride;
+    uint16_t *vectorRanks = ranks.data()+std::size_t(i)*fNVars;
+    for (unsigned int v = 0; v < fNVars; ++v) {
+      const float *begin = fCuts.data()+fCutOffsets[v];
+      const float *end = fCuts.data()+fCutOffsets[v+1];
+      vectorRanks[v] = std::lower_bound(begin, end, vector[v]) - begin;
+    }
+  }
+
+  for (unsigned int i = 0; i < nVectors; ++i) responses[i] = fInitialResponse;
+
+  // trees in order for each candidate, so that the sums are the same as GBRForest::GetResponse
+  int32_t index[kGroupSize];
+  for (unsigned int itree = 0; itree < fRoots.size(); ++itree) {
+    const int32_t root = fRoots[itree];
+    const unsigned int depth = fDepths[itree];
+    for (unsigned int first = 0; first < nVectors; first += kGroupSize) {
+      const unsigned int n = std::min(kGroupSize, nVectors-first);
+      const uint16_t *groupRanks = ranks.data()+std::size_t(first)*fNVars;
+      for (unsigned int j = 0; j < n; ++j) index[j] = root;
+      // every path reaches a response in at most depth steps
+      for (unsigned int d = 0; d < depth; ++d) {
+        for (unsigned int j = 0; j < n; ++j) {
+          const int32_t current = index[j];
+          const Node &node = fNodes[current>=0 ? current : root];
+          const int32_t next = groupRanks[j*fNVars+node.var] > node.rank ? node.right : node.left;
+          index[j] = current>=0 ? next : current;
+        }
+      }
+      for (unsigned int j = 0; j < n; ++j) responses[first+j] += fResponses[~index[j]];
+    }
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestFlat::GetGradBoostClassifier(const float* vectors, unsigned int nVectors, unsigned int stride, double* responses) const {
+  GetResponse(vectors, nVectors, stride, responses);
+  for (unsigned int i = 0; i < nVectors; ++i)
+    responses[i] = 2.0/(1.0+exp(-2.0*responses[i]))-1;
+}
@@ -0,0 +1,98 @@
+// GBRForestFlat must give the same responses as the GBRForest it is built from,
+// candidate by candidate and in batches
+
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+  constexpr unsigned int nVars = 12;
+
+  std::mt19937 gen(4242);
+
+  // random tree of at most maxDepth levels, cuts on a coarse grid so that values repeat
+  int addNode(GBRTree &tree, unsigned int depth, unsigned int maxDepth) {
+    std::uniform_real_distribution<float> uniform(0.f,1.f);
+    if (depth==maxDepth || (depth>0 && uniform(gen)<0.2f)) {
+      tree.Responses().push_back(uniform(gen)-0.5f);
+      return -int(tree.Responses().size()-1);
+    }
+    int index = tree.CutIndices().size();
+    tree.CutIndices().push_back(gen()%nVars);
+    tree.CutVals().push_back(std::round(uniform(gen)*20.f)/10.f-1.f);
+    tree.LeftIndices().push_back(0);
+    tree.RightIndices().push_back(0);
+    int left = addNode(tree, depth+1, maxDepth);
+    int right = addNode(tree, depth+1, maxDepth);
+    tree.LeftIndices()[index] = left;
+    tree.RightIndices()[index] = right;
+    return index;
+  }
+
+  GBRForest makeForest(unsigned int nTrees) {
+    GBRForest forest;
+    forest.SetInitialResponse(0.3);
+    for (unsigned int i=0; i<nTrees; ++i) {
+      GBRTree tree;
+      if (i%50==0) {
+        // a single response, stored as in GBRTree(const TMVA::DecisionTree*)
+        tree.CutIndices().push_back(0);
+        tree.CutVals().push_back(0);
+        tree.LeftIndices().push_back(0);
+        tree.RightIndices().push_back(0);
+        tree.Responses().push_back(0.1f);
+      } else {
+        addNode(tree, 0, 2+i%6);
+      }
+      forest.Trees().push_back(tree);
+    }
+    return forest;
+  }
+
+}
+
+int main() {
+  const GBRForest forest = makeForest(400);
+  const GBRForestFlat flat(forest);
+  assert(flat.NTrees()==forest.Trees().size());
+
+  // inputs on and around the cut grid, and some NaN
+  const unsigned int nCandidates = 1000;
+  const unsigned int stride = nVars+3;
+  std::uniform_int_distribution<int> grid(-15,15);
+  std::uniform_real_distribution<float> uniform(-1.5f,1.5f);
+  std::vector<float> inputs(nCandidates*stride);
+  for (unsigned int i=0; i<inputs.size(); ++i) {
+    switch (i%4) {
+      case 0: inputs[i] = grid(gen)/10.f; break;
+      case 1: inputs[i] = std::nextafter(grid(gen)/10.f, 2.f); break;
+      case 2: inputs[i] = uniform(gen); break;
+      default: inputs[i] = (i%97==3) ? std::numeric_limits<float>::quiet_NaN() : uniform(gen);
+    }
+  }
+
+  std::vector<double> batch(nCandidates), batchClassifier(nCandidates);
+  flat.GetResponse(inputs.data(), nCandidates, stride, batch.data());
+  flat.GetGradBoostClassifier(inputs.data(), nCandidates, stride, batchClassifier.data());
+  for (unsigned int i=0; i<nCandidates; ++i) {
+    const float *vector = inputs.data()+i*stride;
+    const double response = forest.GetResponse(vector);
+    assert(flat.GetResponse(vector)==response);
+    assert(batch[i]==response);
+    assert(flat.GetClassifier(vector)==forest.GetClassifier(vector));
+    assert(batchClassifier[i]==forest.GetClassifier(vector));
+  }
+
+  // batches not multiple of the group size, and empty
+  flat.GetResponse(inputs.data()+stride, 7, stride, batch.data());
+  for (unsigned int i=0; i<7; ++i) assert(batch[i]==forest.GetResponse(inputs.data()+(i+1)*stride));
+  flat.GetResponse(inputs.data(), 0, stride, batch.data());
+
+  return 0;
+}
@@ -2,6 +2,7 @@
 #define __DataFormats_PatCandidates_PackedCandidate_h__
 
 #include <atomic>
+#include <limits>
 #include <mutex>
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
@@ -690,6 +691,7 @@ namespace pat {
 
   protected:
     friend class ::testPackedCandidate;
+    friend class PackedCandidateSoA;
     static constexpr float kMinDEtaToStore_=0.001;
     static constexpr float kMinDTrkPtToStore_=0.001;
     
@@ -700,6 +702,13 @@ namespace pat {
 
     void pack(bool unpackAfterwards=true) ;
     void unpack() const ;
+    /// eta and phi of the packed values as set by unpack(), shared with PackedCandidateSoA
+    static float unpackEta(uint16_t packedEta) { return int16_t(packedEta)*6.0f/std::numeric_limits<int16_t>::max(); }
+    static double unpackPhi(uint16_t packedPhi, float pt) {
+      double shift = (pt<1. ? 0.1*pt : 0.1/pt); // shift particle phi to break degeneracies in angular separations
+      double sign = ( ( int(pt*10) % 2 == 0 ) ? 1 : -1 ); // introduce a pseudo-random sign of the shift
+      return int16_t(packedPhi)*3.2f/std::numeric_limits<int16_t>::max() + sign*shift*3.2/std::numeric_limits<int16_t>::max();
+    }
     void packVtx(bool unpackAfterwards=true) ;
     void unpackVtx() const ;
     void packCovariance(const reco::TrackBase::CovarianceMatrix  & m,bool unpackAfterwards=true) ;
@@ -0,0 +1,60 @@
+#ifndef __DataFormats_PatCandidates_PackedCandidateSoA_h__
+#define __DataFormats_PatCandidates_PackedCandidateSoA_h__
+
+#include <vector>
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+
+/**
+  \class    pat::PackedCandidateSoA PackedCandidateSoA.h "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
+  \brief    Kinematics of a whole PackedCandidateCollection, unpacked at once into contiguous arrays
+
+   For code that reads the four vectors of all the candidates of a collection:
+   the packed values are decoded in vectorized loops and no four vector is
+   allocated per candidate, nor are the candidates themselves unpacked.
+   The values are the ones the candidates return (e.g. pt(i) == cands[i].pt()).
+
+   The arrays are kept when fill() is called again, e.g. on the next event,
+   so a PackedCandidateSoA reused across events doesn't allocate either.
+*/
+
+namespace pat {
+  class PackedCandidateSoA {
+  public:
+    PackedCandidateSoA() {}
+    explicit PackedCandidateSoA(const PackedCandidateCollection & cands) { fill(cands); }
+
+    /// unpack the kinematics of all the candidates
+    void fill(const PackedCandidateCollection & cands) ;
+
+    size_t size() const { return pt_.size(); }
+
+    double pt(size_t i) const { return pt_[i]; }
+    double eta(size_t i) const { return eta_[i]; }
+    double phi(size_t i) const { return phi_[i]; }
+    double mass(size_t i) const { return mass_[i]; }
+    double px(size_t i) const { return px_[i]; }
+    double py(size_t i) const { return py_[i]; }
+    double pz(size_t i) const { return pz_[i]; }
+    double energy(size_t i) const { return energy_[i]; }
+
+    /// the arrays, indexed like the collection
+    const std::vector<double> & pt() const { return pt_; }
+    const std::vector<double> & eta() const { return eta_; }
+    const std::vector<double> & phi() const { return phi_; }
+    const std::vector<double> & mass() const { return mass_; }
+    const std::vector<double> & px() const { return px_; }
+    const std::vector<double> & py() const { return py_; }
+    const std::vector<double> & pz() const { return pz_; }
+    const std::vector<double> & energy() const { return energy_; }
+
+  private:
+    // packed values and their float16 decoding
+    std::vector<uint16_t> packedPt_, packedM_;
+    std::vector<float> unpackedPt_, unpackedM_;
+
+    std::vector<double> pt_, eta_, phi_, mass_;
+    std::vector<double> px_, py_, pz_, energy_;
+  };
+}
+
+#endif
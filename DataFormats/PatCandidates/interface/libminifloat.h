@@ -14,6 +14,21 @@ class MiniFloatConverter {
             conv.i32 = mantissatable[offsettable[h>>10]+(h&0x3ff)]+exponenttable[h>>10];
             return conv.flt;
         }
+        /// Same result as float16to32 for n values, computed without the tables
+        /// so that the loop is vectorized
+        inline static void float16to32(const uint16_t * h, float * f, unsigned int n) {
+            for (unsigned int i = 0; i < n; ++i) {
+                uint32_t sign = uint32_t(h[i] & 0x8000) << 16;
+                uint32_t exponent = (h[i] >> 10) & 0x1f;
+                uint32_t mantissa = h[i] & 0x3ff;
+                union { float flt; uint32_t i32; } norm, denorm;
+                // 0x1f is for inf and NaN
+                norm.i32 = sign | ((exponent == 0x1f ? 0xff : exponent + 112) << 23) | (mantissa << 13);
+                denorm.flt = float(mantissa) * 5.9604644775390625e-08f; // 2^-24, exact
+                denorm.i32 |= sign;
+                f[i] = (exponent != 0) ? norm.flt : denorm.flt;
+            }
+        }
         inline static uint16_t float32to16(float x) {
             return float32to16round(x);
         }
@@ -0,0 +1,36 @@
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
+#include "DataFormats/PatCandidates/interface/libminifloat.h"
+
+void pat::PackedCandidateSoA::fill(const PackedCandidateCollection & cands) {
+    const size_t n = cands.size();
+    packedPt_.resize(n); packedM_.resize(n);
+    unpackedPt_.resize(n); unpackedM_.resize(n);
+    for (std::vector<double> * v : { &pt_, &eta_, &phi_, &mass_, &px_, &py_, &pz_, &energy_ }) v->resize(n);
+
+    // gather the float16 values to decode them all at once
+    for (size_t i = 0; i < n; ++i) {
+        packedPt_[i] = cands[i].packedPt_;
+        packedM_[i]  = cands[i].packedM_;
+    }
+    MiniFloatConverter::float16to32(packedPt_.data(), unpackedPt_.data(), n);
+    MiniFloatConverter::float16to32(packedM_.data(), unpackedM_.data(), n);
+
+    for (size_t i = 0; i < n; ++i) {
+        const PackedCandidate & c = cands[i];
+        PackedCandidate::PolarLorentzVector p4;
+        PackedCandidate::LorentzVector p4c;
+        if (c.p4c_) {
+            // already unpacked, and possibly not from the packed values (e.g. candidates made in this job)
+            p4 = *c.p4_.load();
+            p4c = *c.p4c_.load();
+        } else {
+            // same as unpack(), on the stack
+            const float pt = unpackedPt_[i];
+            p4 = PackedCandidate::PolarLorentzVector(pt, PackedCandidate::unpackEta(c.packedEta_),
+                                                     PackedCandidate::unpackPhi(c.packedPhi_, pt), unpackedM_[i]);
+            p4c = PackedCandidate::LorentzVector(p4);
+        }
+        pt_[i] = p4.Pt(); eta_[i] = p4.Eta(); phi_[i] = p4.Phi(); mass_[i] = p4.M();
+        px_[i] = p4c.Px(); py_[i] = p4c.Py(); pz_[i] = p4c.Pz(); energy_[i] = p4c.E();
+    }
+}
@@ -1,5 +1,7 @@
 #include <cppunit/extensions/HelperMacros.h>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "DataFormats/PatCandidates/interface/libminifloat.h"
 #include "FWCore/Utilities/interface/isFinite.h"
@@ -13,6 +15,7 @@ class testMiniFloat : public CppUnit::TestFixture {
   CPPUNIT_TEST(testMin);
   CPPUNIT_TEST(testMin32RoundedToMin16);
   CPPUNIT_TEST(testDenormMin);
+  CPPUNIT_TEST(testBulkFloat16to32);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -25,6 +28,7 @@ public:
   void testMin();
   void testMin32RoundedToMin16();
   void testDenormMin();
+  void testBulkFloat16to32();
 
 private:
 };
@@ -113,3 +117,15 @@ void testMiniFloat::testDenormMin() {
   const float min32MinusUlp32CroppedTo16 = MiniFloatConverter::float16to32(MiniFloatConverter::float32to16crop(conv.flt));
   CPPUNIT_ASSERT(min32MinusUlp32CroppedTo16 == 0.f);
 }
+
+void testMiniFloat::testBulkFloat16to32() {
+  // the bulk conversion must give the same bits as the tables for all the float16s
+  std::vector<uint16_t> h(1<<16);
+  for (unsigned int i = 0; i < h.size(); ++i) h[i] = i;
+  std::vector<float> f(h.size());
+  MiniFloatConverter::float16to32(h.data(), f.data(), h.size());
+  for (unsigned int i = 0; i < h.size(); ++i) {
+    const float single = MiniFloatConverter::float16to32(h[i]);
+    CPPUNIT_ASSERT(std::memcmp(&single, &f[i], sizeof(float)) == 0);
+  }
+}
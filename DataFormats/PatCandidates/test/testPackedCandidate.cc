@@ -5,6 +5,7 @@
 #include <iomanip>
 
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateSoA.h"
 
 class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testPackedCandidate);
@@ -13,6 +14,7 @@ class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST(testCopyConstructor);
   CPPUNIT_TEST(testPackUnpack);
   CPPUNIT_TEST(testSimulateReadFromRoot);
+  CPPUNIT_TEST(testBulkUnpack);
   CPPUNIT_TEST(testPackUnpackTime);
   CPPUNIT_TEST(testQualityFlags);
 
@@ -25,6 +27,7 @@ public:
   void testCopyConstructor();
   void testPackUnpack();
   void testSimulateReadFromRoot();
+  void testBulkUnpack();
 
   void testPackUnpackTime();
   void testQualityFlags();
@@ -176,6 +179,45 @@ void testPackedCandidate::testSimulateReadFromRoot() {
   
 }
 
+void testPackedCandidate::testBulkUnpack() {
+
+  pat::PackedCandidateCollection cands;
+  for (int i = 0; i < 20; ++i) {
+    double pt = 0.3 + 1.7*i, eta = -2.5 + 0.27*i, phi = -3.1 + 0.31*i, m = (i%3 == 0) ? 0. : 0.13957;
+    pat::PackedCandidate::PolarLorentzVector plv(pt, eta, phi, m);
+    pat::PackedCandidate::LorentzVector lv(plv);
+    //invalid Refs use a special key
+    cands.emplace_back(lv, pat::PackedCandidate::Point(0.,0.,0.), pt, eta, phi, 211, reco::VertexRefProd(), reco::VertexRef().key());
+  }
+  //all but the first are as read back from ROOT
+  for (size_t i = 1; i < cands.size(); ++i) {
+    delete cands[i].p4_.exchange(nullptr);
+    delete cands[i].p4c_.exchange(nullptr);
+  }
+
+  pat::PackedCandidateSoA soa(cands);
+  CPPUNIT_ASSERT(soa.size() == cands.size());
+  //the candidates were not unpacked
+  for (size_t i = 1; i < cands.size(); ++i) CPPUNIT_ASSERT(cands[i].p4c_.load() == nullptr);
+
+  for (size_t i = 0; i < cands.size(); ++i) {
+    CPPUNIT_ASSERT(soa.pt(i) == cands[i].pt());
+    CPPUNIT_ASSERT(soa.eta(i) == cands[i].eta());
+    CPPUNIT_ASSERT(soa.phi(i) == cands[i].phi());
+    CPPUNIT_ASSERT(soa.mass(i) == cands[i].mass());
+    CPPUNIT_ASSERT(soa.px(i) == cands[i].px());
+    CPPUNIT_ASSERT(soa.py(i) == cands[i].py());
+    CPPUNIT_ASSERT(soa.pz(i) == cands[i].pz());
+    CPPUNIT_ASSERT(soa.energy(i) == cands[i].energy());
+  }
+
+  //refilled with fewer candidates
+  cands.resize(5);
+  soa.fill(cands);
+  CPPUNIT_ASSERT(soa.size() == 5);
+  CPPUNIT_ASSERT(soa.pt(4) == cands[4].pt());
+}
+
 
 void testPackedCandidate::testPackUnpackTime() {
   bool debug = false; // turn this on in order to get a printout of the numerical precision you get for the timing in the various encodings
@@ -39,6 +39,7 @@
 #include "DataFormats/SiPixelRawData/interface/SiPixelRawDataError.h"
 #include "DataFormats/Common/interface/DetSetVector.h"
 #include "EventFilter/SiPixelRawToDigi/interface/ErrorChecker.h"
+#include "EventFilter/SiPixelRawToDigi/interface/PixelDigiTable.h"
 #include "FWCore/Utilities/interface/typedefs.h"
 
 #include <vector>
@@ -80,6 +81,10 @@ public:
 
   void interpretRawData(bool& errorsInEvent, int fedId,  const FEDRawData & data, Collection & digis, Errors & errors);
 
+  /// unpack into a flat table (one row per pixel) instead of the DetSetVector;
+  /// a formatter per FED can then run concurrently
+  void interpretRawData(bool& errorsInEvent, int fedId,  const FEDRawData & data, pixeldigis::PixelDigiTable & digis, Errors & errors);
+
   void formatRawData( unsigned int lvl1_ID, RawData & fedRawData, const Digis & digis);
 
   cms_uint32_t linkId(cms_uint32_t word32) { return (word32 >> LINK_shift) & LINK_mask; }
@@ -112,6 +117,9 @@ private:
 
   int checkError(const Word32& data) const;
 
+  template<typename DigiSink>
+  void unpack(bool& errorsInEvent, int fedId, const FEDRawData & data, DigiSink & digis, Errors & errors);
+
   int digi2word(  cms_uint32_t detId, const PixelDigi& digi,
                   std::map<int, std::vector<Word32> > & words) const;
   int digi2wordPhase1Layer1(  cms_uint32_t detId, const PixelDigi& digi,
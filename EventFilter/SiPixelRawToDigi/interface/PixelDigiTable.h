@@ -0,0 +1,55 @@
+#ifndef PixelDigiTable_H
+#define PixelDigiTable_H
+
+/** \class PixelDigiTable
+ *
+ *  Flat (structure of arrays) pixel digis as unpacked from one FED:
+ *  one row per pixel, in the order of the data words.
+ *  Rows of the same module are contiguous within a FED.
+ *  Each module (or ROC of a new module) starts with a row whose row and col
+ *  are moduleStart: as in the serial unpacking, the module gets a DetSet
+ *  even if none of its pixels is valid.
+ *
+ *  Used by SiPixelRawToDigi to unpack FEDs concurrently;
+ *  fillDetSetVector converts to the legacy collection in a single pass.
+ */
+
+#include "FWCore/SOA/interface/Column.h"
+#include "FWCore/SOA/interface/Table.h"
+#include "DataFormats/Common/interface/DetSetVector.h"
+#include "DataFormats/SiPixelDigi/interface/PixelDigi.h"
+
+#include <cstdint>
+
+namespace pixeldigis {
+  SOA_DECLARE_COLUMN(RawId, uint32_t, "rawId");
+  SOA_DECLARE_COLUMN(Row, uint16_t, "row");
+  SOA_DECLARE_COLUMN(Col, uint16_t, "col");
+  SOA_DECLARE_COLUMN(Adc, uint16_t, "adc");
+
+  using PixelDigiTable = edm::soa::Table<RawId,Row,Col,Adc>;
+
+  /// row and col of the rows that start a module
+  constexpr uint16_t moduleStart = 0xffff;
+
+  /// append the digis of a table to the legacy collection
+  inline void fillDetSetVector(PixelDigiTable const& table, edm::DetSetVector<PixelDigi> & digis) {
+    auto rawIds = table.column<RawId>().begin();
+    auto rows = table.column<Row>().begin();
+    auto cols = table.column<Col>().begin();
+    auto adcs = table.column<Adc>().begin();
+    edm::DetSet<PixelDigi> * detDigis=nullptr;
+    uint32_t current = 0;
+    for (unsigned int i=0; i<table.size(); ++i) {
+      if (detDigis==nullptr || rawIds[i]!=current) {
+        current = rawIds[i];
+        detDigis = &digis.find_or_insert(current);
+        if ( (*detDigis).empty() ) (*detDigis).data.reserve(32);
+      }
+      if (rows[i]==moduleStart && cols[i]==moduleStart) continue;
+      (*detDigis).data.emplace_back(rows[i], cols[i], adcs[i]);
+    }
+  }
+}
+
+#endif
@@ -5,6 +5,7 @@
 // 20-10-2010 Andrew York (Tennessee)
 // Jan 2016 Tamas Almos Vami (Tav) (Wigner RCP) -- Cabling Map label option
 // Jul 2017 Viktor Veszpremi -- added PixelFEDChannel
+// Optional concurrent unpacking of the FEDs into flat digi tables
 
 #include "SiPixelRawToDigi.h"
 
@@ -36,6 +37,8 @@
 #include "EventFilter/SiPixelRawToDigi/interface/PixelUnpackingRegions.h"
 #include "FWCore/Framework/interface/ConsumesCollector.h"
 
+#include "tbb/parallel_for.h"
+
 #include "TH1D.h"
 #include "TFile.h"
 
@@ -104,6 +107,9 @@ SiPixelRawToDigi::SiPixelRawToDigi( const edm::ParameterSet& conf )
   //CablingMap could have a label //Tav
   cablingMapLabel = config_.getParameter<std::string> ("CablingMapLabel");
 
+  // unpack the FEDs concurrently
+  parallelUnpacking = config_.getParameter<bool> ("ParallelUnpacking");
+
 }
 
 
@@ -151,6 +157,7 @@ SiPixelRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
   desc.add<bool>("UsePilotBlade",false)->setComment("##  Use pilot blades");
   desc.add<bool>("UsePhase1",false)->setComment("##  Use phase1");
   desc.add<std::string>("CablingMapLabel","")->setComment("CablingMap label"); //Tav
+  desc.add<bool>("ParallelUnpacking",false)->setComment("##  Unpack the FEDs concurrently");
   desc.addOptional<bool>("CheckPixelOrder");  // never used, kept for back-compatibility
   descriptions.add("siPixelRawToDigi",desc);
 }
@@ -214,6 +221,8 @@ void SiPixelRawToDigi::produce( edm::Event& ev,
     LogDebug("SiPixelRawToDigi") << "region2unpack #modules (BPIX,EPIX,total): "<<regions_->nBarrelModules()<<" "<<regions_->nForwardModules()<<" "<<regions_->nModules();
   }
 
+  std::vector<int> fedsToUnpack;
+  fedsToUnpack.reserve(fedIds.size());
   for (auto aFed = fedIds.begin(); aFed != fedIds.end(); ++aFed) {
     int fedId = *aFed;
 
@@ -221,17 +230,11 @@ void SiPixelRawToDigi::produce( edm::Event& ev,
 
     if (regions_ && !regions_->mayUnpackFED(fedId)) continue;
 
-    if(debug) LogDebug("SiPixelRawToDigi")<< " PRODUCE DIGI FOR FED: " <<  fedId << endl;
-
-    PixelDataFormatter::Errors errors;
-
-    //get event data for this fed
-    const FEDRawData& fedRawData = buffers->FEDData( fedId );
-
-    //convert data to digi and strip off errors
-    formatter.interpretRawData( errorsInEvent, fedId, fedRawData, *collection, errors);
+    fedsToUnpack.push_back(fedId);
+  }
 
-    //pack errors into collection
+  //pack errors into collection
+  auto packErrors = [&](int fedId, PixelDataFormatter::Errors & errors) {
     if(includeErrors) {
       typedef PixelDataFormatter::Errors::iterator IE;
       for (IE is = errors.begin(); is != errors.end(); is++) {
@@ -296,7 +299,50 @@ void SiPixelRawToDigi::produce( edm::Event& ev,
 	} // if error assigned to a real DetId
       } // loop on errors in event for this FED
     } // if errors to be included in the event
-  } // loop on FED data to be unpacked
+  };
+
+  int nDigisEvent = 0;
+  int nWordsEvent = 0;
+  if (parallelUnpacking) {
+    // unpack the FEDs concurrently, each into its own table and error map,
+    // then merge in FED order: digis and errors are the same as for the serial unpacking
+    const auto nFeds = fedsToUnpack.size();
+    std::vector<PixelDataFormatter> formatters(nFeds, formatter);
+    std::vector<pixeldigis::PixelDigiTable> fedDigis(nFeds);
+    std::vector<PixelDataFormatter::Errors> fedErrors(nFeds);
+    std::vector<char> fedHasErrors(nFeds, false);
+
+    tbb::parallel_for(size_t(0), nFeds, [&](size_t i) {
+      bool errorsInFed = false;
+      formatters[i].interpretRawData( errorsInFed, fedsToUnpack[i], buffers->FEDData(fedsToUnpack[i]), fedDigis[i], fedErrors[i]);
+      fedHasErrors[i] = errorsInFed;
+    });
+
+    for (size_t i = 0; i < nFeds; ++i) {
+      pixeldigis::fillDetSetVector(fedDigis[i], *collection);
+      errorsInEvent |= bool(fedHasErrors[i]);
+      packErrors(fedsToUnpack[i], fedErrors[i]);
+      nDigisEvent += formatters[i].nDigis();
+      nWordsEvent += formatters[i].nWords();
+    }
+  } else {
+    for (auto fedId : fedsToUnpack) {
+
+      if(debug) LogDebug("SiPixelRawToDigi")<< " PRODUCE DIGI FOR FED: " <<  fedId << endl;
+
+      PixelDataFormatter::Errors errors;
+
+      //get event data for this fed
+      const FEDRawData& fedRawData = buffers->FEDData( fedId );
+
+      //convert data to digi and strip off errors
+      formatter.interpretRawData( errorsInEvent, fedId, fedRawData, *collection, errors);
+
+      packErrors(fedId, errors);
+    } // loop on FED data to be unpacked
+    nDigisEvent = formatter.nDigis();
+    nWordsEvent = formatter.nWords();
+  }
 
   if(includeErrors) {
     edm::DetSet<SiPixelRawDataError>& errorDetSet = errorcollection->find_or_insert(dummydetid);
@@ -307,12 +353,12 @@ void SiPixelRawToDigi::produce( edm::Event& ev,
   if (theTimer) {
     theTimer->stop();
     LogDebug("SiPixelRawToDigi") << "TIMING IS: (real)" << theTimer->realTime() ;
-    ndigis += formatter.nDigis();
-    nwords += formatter.nWords();
+    ndigis += nDigisEvent;
+    nwords += nWordsEvent;
     LogDebug("SiPixelRawToDigi") << " (Words/Digis) this ev: "
-         <<formatter.nWords()<<"/"<<formatter.nDigis() << "--- all :"<<nwords<<"/"<<ndigis;
+         <<nWordsEvent<<"/"<<nDigisEvent << "--- all :"<<nwords<<"/"<<ndigis;
     hCPU->Fill( theTimer->realTime() ); 
-    hDigi->Fill(formatter.nDigis());
+    hDigi->Fill(nDigisEvent);
   }
 
   //send digis and errors back to framework 
@@ -124,7 +124,67 @@ void PixelDataFormatter::passFrameReverter(const SiPixelFrameReverter* reverter)
   theFrameReverter = reverter;
 }
 
+namespace {
+  // destinations of the unpacked digis
+
+  class DetSetSink {
+  public:
+    explicit DetSetSink(PixelDataFormatter::Collection & digis) : theDigis(digis), detDigis(nullptr) {}
+    void reserve(int) {}
+    void newModule(cms_uint32_t rawId) {
+      detDigis = &theDigis.find_or_insert(rawId);
+      if ( (*detDigis).empty() ) (*detDigis).data.reserve(32); // avoid the first relocations
+    }
+    void add(int row, int col, int adc) {
+      (*detDigis).data.emplace_back(row, col, adc);
+      LogTrace("") << (*detDigis).data.back();
+    }
+    void done() {}
+  private:
+    PixelDataFormatter::Collection & theDigis;
+    edm::DetSet<PixelDigi> * detDigis;
+  };
+
+  class TableSink {
+  public:
+    explicit TableSink(pixeldigis::PixelDigiTable & digis) : theDigis(digis), theRawId(0), n(0) { theDigis.resize(0); }
+    // at most one digi per data word, the module starts are added on demand
+    void reserve(int nWords) { if (nWords>0) theDigis.resize(nWords); }
+    void newModule(cms_uint32_t rawId) {
+      theRawId = rawId;
+      // a row without pixel, so that the module gets its (maybe empty) DetSet
+      add(pixeldigis::moduleStart, pixeldigis::moduleStart, 0);
+    }
+    void add(int row, int col, int adc) {
+      if unlikely(n==theDigis.size()) theDigis.resize(2*n+32);
+      theDigis.get<pixeldigis::RawId>(n) = theRawId;
+      theDigis.get<pixeldigis::Row>(n) = row;
+      theDigis.get<pixeldigis::Col>(n) = col;
+      theDigis.get<pixeldigis::Adc>(n) = adc;
+      ++n;
+    }
+    void done() { theDigis.resize(n); }
+  private:
+    pixeldigis::PixelDigiTable & theDigis;
+    cms_uint32_t theRawId;
+    unsigned int n;
+  };
+}
+
 void PixelDataFormatter::interpretRawData(bool& errorsInEvent, int fedId, const FEDRawData& rawData, Collection & digis, Errors& errors)
+{
+  DetSetSink sink(digis);
+  unpack(errorsInEvent, fedId, rawData, sink, errors);
+}
+
+void PixelDataFormatter::interpretRawData(bool& errorsInEvent, int fedId, const FEDRawData& rawData, pixeldigis::PixelDigiTable & digis, Errors& errors)
+{
+  TableSink sink(digis);
+  unpack(errorsInEvent, fedId, rawData, sink, errors);
+}
+
+template<typename DigiSink>
+void PixelDataFormatter::unpack(bool& errorsInEvent, int fedId, const FEDRawData& rawData, DigiSink & digis, Errors& errors)
 {
   using namespace sipixelobjects;
 
@@ -166,11 +226,11 @@ void PixelDataFormatter::interpretRawData(bool& errorsInEvent, int fedId, const
   int layer = 0;
   PixelROC const * rocp=nullptr;
   bool skipROC=false;
-  edm::DetSet<PixelDigi> * detDigis=nullptr;
 
   const  Word32 * bw =(const  Word32 *)(header+1);
   const  Word32 * ew =(const  Word32 *)(trailer);
   if ( *(ew-1) == 0 ) { ew--;  theWordCounter--;}
+  digis.reserve(ew-bw);
   for (auto word = bw; word < ew; ++word) {
     LogTrace("")<<"DATA: " <<  print(*word);
 
@@ -208,8 +268,7 @@ void PixelDataFormatter::interpretRawData(bool& errorsInEvent, int fedId, const
       skipROC= modulesToUnpack && ( modulesToUnpack->find(rawId) == modulesToUnpack->end());
       if (skipROC) continue;
       
-      detDigis = &digis.find_or_insert(rawId);
-      if ( (*detDigis).empty() ) (*detDigis).data.reserve(32); // avoid the first relocations
+      digis.newModule(rawId);
     }
 
     // skip is roc to be skipped ot invalid
@@ -258,10 +317,10 @@ void PixelDataFormatter::interpretRawData(bool& errorsInEvent, int fedId, const
     }    
 
     GlobalPixel global = rocp->toGlobal( *local ); // global pixel coordinate (in module)
-    (*detDigis).data.emplace_back(global.row, global.col, adc);
+    digis.add(global.row, global.col, adc);
     //if(DANEK) cout<<global.row<<" "<<global.col<<" "<<adc<<endl;    
-    LogTrace("") << (*detDigis).data.back();
   }
+  digis.done();
 
 }
 
@@ -0,0 +1,40 @@
+#
+# Throughput of the pixel raw-to-digi conversion, serial vs. concurrent FED unpacking.
+# Both unpackers read the same recorded raw data; compare the per-module times
+# in the TimeReport printed at the end of the job.
+#
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("RawToDigiThroughput")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:run2_data', '')
+
+process.maxEvents = cms.untracked.PSet( input = cms.untracked.int32(1000))
+
+process.options = cms.untracked.PSet(
+    wantSummary = cms.untracked.bool(True),
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(1),
+)
+
+process.source = cms.Source("PoolSource",
+  fileNames =  cms.untracked.vstring(
+    "/store/data/Run2017C/ZeroBias/RAW/v1/000/300/079/00000/F0D43E2A-1D74-E711-A1C3-02163E01A2C5.root",
+  )
+)
+
+process.load("EventFilter.SiPixelRawToDigi.SiPixelRawToDigi_cfi")
+process.siPixelDigis.InputLabel = 'rawDataCollector'
+process.siPixelDigis.UsePhase1 = True
+process.siPixelDigis.ParallelUnpacking = False
+
+process.siPixelDigisParallel = process.siPixelDigis.clone(
+  ParallelUnpacking = True
+)
+
+process.p = cms.Path(process.siPixelDigis*process.siPixelDigisParallel)
@@ -11,11 +11,14 @@
 //
 
 // system include files
+#include <algorithm>
 #include <string>
+#include <vector>
 #include "TFile.h"
 #include "TTree.h"
 #include "TROOT.h"
 #include "TObjString.h"
+#include "TBranch.h"
 #include "Compression.h"
 
 // user include files
@@ -57,6 +60,8 @@ private:
   void openFile(edm::FileBlock const&) override;
   void reallyCloseFile() override;
 
+  void tuneBasketSizes();
+
   std::string m_fileName;
   std::string m_logicalFileName;
   int m_compressionLevel;
@@ -64,6 +69,8 @@ private:
   bool m_writeProvenance;
   bool m_fakeName; //crab workaround, remove after crab is fixed
   int m_autoFlush;
+  int m_eventsPerCluster;
+  std::vector<Long64_t> m_branchTotBytes;
   edm::ProcessHistoryRegistry m_processHistoryRegistry;
   edm::JobReport::Token m_jrToken;
   std::unique_ptr<TFile> m_file;
@@ -141,6 +148,7 @@ NanoAODOutputModule::NanoAODOutputModule(edm::ParameterSet const& pset):
   m_writeProvenance(pset.getUntrackedParameter<bool>("saveProvenance", true)),
   m_fakeName(pset.getUntrackedParameter<bool>("fakeNameForCrab", false)),
   m_autoFlush(pset.getUntrackedParameter<int>("autoFlush", -10000000)),
+  m_eventsPerCluster(pset.getUntrackedParameter<int>("eventsPerCluster", 0)),
   m_processHistoryRegistry()
 {
 }
@@ -163,6 +171,8 @@ NanoAODOutputModule::write(edm::EventForOutput const& iEvent) {
   // fill triggers
   for (auto & t : m_triggers) t.fill(iEvent,*m_tree);
   m_tree->Fill();
+  // the Fill closing a cluster has flushed its baskets
+  if (m_eventsPerCluster > 0 && m_tree->GetEntries() % m_eventsPerCluster == 0) tuneBasketSizes();
 
   m_processHistoryRegistry.registerProcessHistory(iEvent.processHistory());
 }
@@ -260,7 +270,8 @@ NanoAODOutputModule::openFile(edm::FileBlock const&) {
   // create the trees
   m_tree.reset(new TTree("Events","Events"));
   m_tree->SetAutoSave(std::numeric_limits<Long64_t>::max());
-  m_tree->SetAutoFlush(m_autoFlush);
+  m_tree->SetAutoFlush(m_eventsPerCluster > 0 ? m_eventsPerCluster : m_autoFlush);
+  m_branchTotBytes.clear();
   m_commonBranches.branch(*m_tree);
 
   m_lumiTree.reset(new TTree("LuminosityBlocks","LuminosityBlocks"));
@@ -278,6 +289,28 @@ NanoAODOutputModule::openFile(edm::FileBlock const&) {
       m_parameterSetsTree->SetAutoSave(std::numeric_limits<Long64_t>::max());
   }
 }
+void
+NanoAODOutputModule::tuneBasketSizes() {
+  // Size the basket of each column to hold the column for a whole cluster:
+  // the baskets are then only compressed when the cluster is flushed, which
+  // ROOT does in parallel tasks with implicit multithreading, instead of one
+  // at a time whenever one fills up during the event loop. Reading a column
+  // also takes one basket per cluster.
+  const Long64_t minBasketSize = 1024, maxBasketSize = 16*1024*1024;
+  TObjArray * branches = m_tree->GetListOfBranches();
+  const int nBranches = branches->GetEntriesFast();
+  m_branchTotBytes.resize(nBranches, 0); // trigger branches can be added at new runs
+  for (int i = 0; i < nBranches; ++i) {
+      TBranch * branch = static_cast<TBranch *>(branches->UncheckedAt(i));
+      Long64_t totBytes = branch->GetTotBytes();
+      Long64_t clusterBytes = totBytes - m_branchTotBytes[i];
+      m_branchTotBytes[i] = totBytes;
+      // with some margin for the fluctuations of the number of objects
+      Long64_t basketSize = clusterBytes + clusterBytes/8 + minBasketSize;
+      branch->SetBasketSize(Int_t(std::min(basketSize, maxBasketSize)));
+  }
+}
+
 void 
 NanoAODOutputModule::reallyCloseFile() {
   if (m_writeProvenance) {
@@ -316,6 +349,8 @@ NanoAODOutputModule::fillDescriptions(edm::ConfigurationDescriptions& descriptio
         ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
   desc.addUntracked<bool>("saveProvenance", true)
         ->setComment("Save process provenance information, e.g. for edmProvDump");
+  desc.addUntracked<int>("eventsPerCluster", 0)
+        ->setComment("If positive, write the events in clusters of this many events (instead of autoFlush) and size the basket of each branch to hold a whole cluster, so that the baskets are compressed in parallel when the cluster is flushed (ROOT implicit multithreading must be enabled)");
   desc.addUntracked<bool>("fakeNameForCrab", false)
         ->setComment("Change the OutputModule name in the fwk job report to fake PoolOutputModule. This is needed to run on cran (and publish) till crab is fixed");
 
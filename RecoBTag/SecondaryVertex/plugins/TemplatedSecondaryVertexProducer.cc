@@ -9,6 +9,9 @@
 
 #include <boost/iterator/transform_iterator.hpp>
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -175,6 +178,8 @@ class TemplatedSecondaryVertexProducer : public edm::stream::EDProducer<> {
 	ClusterSequencePtr		fjClusterSeq;
 	JetDefPtr			fjJetDefinition;
 
+	bool				concurrentJets;
+
 	void markUsedTracks(TrackDataVector & trackData, const input_container & trackRefs, const SecondaryVertex & sv,size_t idx);
 
 	struct SVBuilder :
@@ -286,6 +291,7 @@ TemplatedSecondaryVertexProducer<IPTI,VTX>::TemplatedSecondaryVertexProducer(
 	}
 	useSVClustering = ( params.existsAs<bool>("useSVClustering") ? params.getParameter<bool>("useSVClustering") : false );
 	useSVMomentum = ( params.existsAs<bool>("useSVMomentum") ? params.getParameter<bool>("useSVMomentum") : false );
+	concurrentJets = ( params.existsAs<bool>("concurrentJets") ? params.getParameter<bool>("concurrentJets") : false );
 	useFatJets = ( useExternalSV && params.exists("fatJets") );
 	useGroomedFatJets = ( useExternalSV && params.exists("groomedFatJets") );
 	if( useSVClustering )
@@ -654,15 +660,25 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 			new ConfigurableVertexReconstructor(vtxRecoPSet));
 
 	TransientTrackMap primariesMap;
+	// the transient tracks are built once per event, for all the jets sharing the track
+	TransientTrackMap fitTracksMap;
 
-	// result secondary vertices
+	// inputs of the vertex finding, for each jet
 
-	auto tagInfos = std::make_unique<Product>();
+	struct JetVertexInputs {
+		TrackDataVector				trackData;
+		input_container				trackRefs;
+		std::vector<TransientTrack>		fitTracks;
+		std::vector<TransientTrack>		primaries;
+		std::unique_ptr<GhostTrack>		ghostTrack;
+	};
+	std::vector<JetVertexInputs> jetInputs(trackIPTagInfos->size());
 
 	for(typename std::vector<IPTI>::const_iterator iterJets =
 		trackIPTagInfos->begin(); iterJets != trackIPTagInfos->end();
 		++iterJets) {
-		TrackDataVector trackData;
+		JetVertexInputs &inputs = jetInputs[iterJets - trackIPTagInfos->begin()];
+		TrackDataVector &trackData = inputs.trackData;
 //		      std::cout << "Jet " << iterJets-trackIPTagInfos->begin() << std::endl; 
 
 		const Vertex &pv = *iterJets->primaryVertex();
@@ -690,21 +706,18 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 
 		edm::RefToBase<Jet> jetRef = iterJets->jet();
 
-		GlobalVector jetDir(jetRef->momentum().x(),
-		                    jetRef->momentum().y(),
-		                    jetRef->momentum().z());
-
 		std::vector<std::size_t> indices =
 				iterJets->sortedIndexes(sortCriterium);
 
-		input_container trackRefs = iterJets->sortedTracks(indices);
+		inputs.trackRefs = iterJets->sortedTracks(indices);
+		const input_container &trackRefs = inputs.trackRefs;
 
 		const std::vector<reco::btag::TrackIPData> &ipData =
 					iterJets->impactParameterData();
 
 		// build transient tracks used for vertex reconstruction
 
-		std::vector<TransientTrack> fitTracks;
+		std::vector<TransientTrack> &fitTracks = inputs.fitTracks;
 		std::vector<GhostTrackState> gtStates;
 		std::auto_ptr<GhostTrackPrediction> gtPred;
 		if (useGhostTrack)
@@ -735,8 +748,19 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 			if (pos != primariesMap.end()) {
 				primaries.erase(pos->second);
 				fitTrack = pos->second;
-			} else
-				fitTrack = trackBuilder->build(trackRef);
+			} else {
+				const Track *track = reco::btag::toTrack(trackRef);
+				TransientTrackMap::iterator built =
+					fitTracksMap.lower_bound(track);
+				if (built != fitTracksMap.end() &&
+				    built->first == track)
+					fitTrack = built->second;
+				else {
+					fitTrack = trackBuilder->build(trackRef);
+					fitTracksMap.insert(built,
+						std::make_pair(track, fitTrack));
+				}
+			}
 			fitTracks.push_back(fitTrack);
 
 			trackData.back().second.svStatus =
@@ -753,9 +777,8 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 			}
 		}
 
-		std::auto_ptr<GhostTrack> ghostTrack;
 		if (useGhostTrack)
-			ghostTrack.reset(new GhostTrack(
+			inputs.ghostTrack.reset(new GhostTrack(
 				GhostTrackPrediction(
 					RecoVertex::convertPos(pv.position()),
 					RecoVertex::convertError(pv.error()),
@@ -768,28 +791,51 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 				iterJets->ghostTrack()->chi2(),
 				iterJets->ghostTrack()->ndof()));
 
-		// perform actual vertex finding
+		if (constraint == CONSTRAINT_PV_PRIMARIES_IN_FIT)
+			inputs.primaries.assign(primaries.begin(), primaries.end());
+	}
+
+	// perform actual vertex finding, with the vertex finders given
+	// (they are not shared between concurrent jets)
+
+	std::vector<std::vector<SecondaryVertex> > jetSVs(trackIPTagInfos->size());
+	std::vector<std::vector<typename TemplatedSecondaryVertexTagInfo<IPTI,VTX>::VertexData> > jetSVData(trackIPTagInfos->size());
 
+	auto findVertices = [&](size_t jetIdx,
+	                        const ConfigurableVertexReconstructor *vtxReco,
+	                        const GhostTrackVertexFinder *vtxRecoGT) {
+		typename std::vector<IPTI>::const_iterator iterJets =
+			trackIPTagInfos->begin() + jetIdx;
+		JetVertexInputs &inputs = jetInputs[jetIdx];
+		const std::vector<TransientTrack> &fitTracks = inputs.fitTracks;
+
+		const Vertex &pv = *iterJets->primaryVertex();
+
+		edm::RefToBase<Jet> jetRef = iterJets->jet();
+
+		GlobalVector jetDir(jetRef->momentum().x(),
+		                    jetRef->momentum().y(),
+		                    jetRef->momentum().z());
 
 	 	std::vector<VTX>       extAssoCollection;    
 		std::vector<TransientVertex> fittedSVs;
-		std::vector<SecondaryVertex> SVs;
+		std::vector<SecondaryVertex> &SVs = jetSVs[jetIdx];
 		if(!useExternalSV){ 
     		  switch(constraint)   {
 		    case CONSTRAINT_NONE:
 			if (useGhostTrack)
-				fittedSVs = vertexRecoGT->vertices(
-						pv, *ghostTrack);
+				fittedSVs = vtxRecoGT->vertices(
+						pv, *inputs.ghostTrack);
 			else
-				fittedSVs = vertexReco->vertices(fitTracks);
+				fittedSVs = vtxReco->vertices(fitTracks);
 			break;
 
 		    case CONSTRAINT_BEAMSPOT:
 			if (useGhostTrack)
-				fittedSVs = vertexRecoGT->vertices(
-						pv, *beamSpot, *ghostTrack);
+				fittedSVs = vtxRecoGT->vertices(
+						pv, *beamSpot, *inputs.ghostTrack);
 			else
-				fittedSVs = vertexReco->vertices(fitTracks,
+				fittedSVs = vtxReco->vertices(fitTracks,
 				                                 *beamSpot);
 			break;
 
@@ -818,21 +864,20 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 			            beamWidth, cov, BeamSpot::Unknown);
 
 			if (useGhostTrack)
-				fittedSVs = vertexRecoGT->vertices(
-						pv, bs, *ghostTrack);
+				fittedSVs = vtxRecoGT->vertices(
+						pv, bs, *inputs.ghostTrack);
 			else
-				fittedSVs = vertexReco->vertices(fitTracks, bs);
+				fittedSVs = vtxReco->vertices(fitTracks, bs);
 		    }	break;
 
 		    case CONSTRAINT_PV_PRIMARIES_IN_FIT: {
-			std::vector<TransientTrack> primaries_(
-					primaries.begin(), primaries.end());
+			const std::vector<TransientTrack> &primaries_ = inputs.primaries;
 			if (useGhostTrack)
-				fittedSVs = vertexRecoGT->vertices(
+				fittedSVs = vtxRecoGT->vertices(
 						pv, *beamSpot, primaries_,
-						*ghostTrack);
+						*inputs.ghostTrack);
 			else
-				fittedSVs = vertexReco->vertices(
+				fittedSVs = vtxReco->vertices(
 						primaries_, fitTracks,
 						*beamSpot);
 		    }	break;
@@ -848,8 +893,6 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 
 		}else{
 		  if( useSVClustering || useFatJets ) {
-		      size_t jetIdx = ( iterJets - trackIPTagInfos->begin() );
-		
 		      for(size_t iExtSv = 0; iExtSv < clusteredSVs.at(jetIdx).size(); iExtSv++){
 			 const VTX & extVertex = (*extSecVertex)[ clusteredSVs.at(jetIdx).at(iExtSv) ];
 			 if( extVertex.p4().M() < 0.3 )
@@ -873,18 +916,15 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 				    SVFilter(vertexFilter, pv, jetDir));
                 }
 		// clean up now unneeded collections
-		gtPred.reset();
-		ghostTrack.reset();
-		gtStates.clear();
-		fitTracks.clear();
-		fittedSVs.clear();
-		extAssoCollection.clear();
+		inputs.ghostTrack.reset();
+		inputs.fitTracks.clear();
+		inputs.primaries.clear();
 
 		// sort SVs by importance
 		
 		std::vector<unsigned int> vtxIndices = vertexSorting(SVs);
 
-		std::vector<typename TemplatedSecondaryVertexTagInfo<IPTI,VTX>::VertexData> svData;
+		std::vector<typename TemplatedSecondaryVertexTagInfo<IPTI,VTX>::VertexData> &svData = jetSVData[jetIdx];
 
 		svData.resize(vtxIndices.size());
 		for(unsigned int idx = 0; idx < vtxIndices.size(); idx++) {
@@ -896,16 +936,47 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::produce(edm::Event &event,
 			svData[idx].dist3d = sv.dist3d();
 			svData[idx].direction = flightDirection(pv,sv);
 			// mark tracks successfully used in vertex fit
-			markUsedTracks(trackData,trackRefs,sv,idx);
+			markUsedTracks(inputs.trackData,inputs.trackRefs,sv,idx);
 		}
+	};
+
+	if (concurrentJets && !useExternalSV && trackIPTagInfos->size() > 1) {
+		// each thread fits with its own copy of the vertex finder
+		typedef std::pair<std::unique_ptr<ConfigurableVertexReconstructor>,
+		                  std::unique_ptr<GhostTrackVertexFinder> > VertexFinders;
+		tbb::enumerable_thread_specific<VertexFinders> threadVertexFinders([&]() {
+			VertexFinders finders;
+			if (useGhostTrack)
+				finders.second.reset(new GhostTrackVertexFinder(
+					vtxRecoPSet.getParameter<double>("maxFitChi2"),
+					vtxRecoPSet.getParameter<double>("mergeThreshold"),
+					vtxRecoPSet.getParameter<double>("primcut"),
+					vtxRecoPSet.getParameter<double>("seccut"),
+					getGhostTrackFitType(vtxRecoPSet.getParameter<std::string>("fitType"))));
+			else
+				finders.first.reset(vertexReco->clone());
+			return finders;
+		});
+		tbb::parallel_for(size_t(0), trackIPTagInfos->size(), [&](size_t jetIdx) {
+			VertexFinders &finders = threadVertexFinders.local();
+			findVertices(jetIdx, finders.first.get(), finders.second.get());
+		});
+	} else {
+		for(size_t jetIdx = 0; jetIdx < trackIPTagInfos->size(); ++jetIdx)
+			findVertices(jetIdx, vertexReco.get(), vertexRecoGT.get());
+	}
+
+	// result secondary vertices
+
+	auto tagInfos = std::make_unique<Product>();
 
+	for(size_t jetIdx = 0; jetIdx < trackIPTagInfos->size(); ++jetIdx) {
 		// fill result into tag infos
 
 		tagInfos->push_back(
 			TemplatedSecondaryVertexTagInfo<IPTI,VTX>(
-				trackData, svData, SVs.size(),
-				edm::Ref<std::vector<IPTI> >(trackIPTagInfos,
-					iterJets - trackIPTagInfos->begin())));
+				jetInputs[jetIdx].trackData, jetSVData[jetIdx], jetSVs[jetIdx].size(),
+				edm::Ref<std::vector<IPTI> >(trackIPTagInfos, jetIdx)));
 	}
 
 	event.put(std::move(tagInfos));
@@ -1305,6 +1376,7 @@ void TemplatedSecondaryVertexProducer<IPTI,VTX>::fillDescriptions(edm::Configura
                         edm::ParameterDescription<std::string>("jetAlgorithm", true) and
                         edm::ParameterDescription<double>("rParam", true), true );
   desc.addOptional<bool>("useSVMomentum",false);
+  desc.addOptional<bool>("concurrentJets",false)->setComment("find the vertices of the jets concurrently, each thread with its own vertex finder");
   desc.addOptional<double>("ghostRescaling",1e-18);
   desc.addOptional<double>("relPtTolerance",1e-03);
   desc.addOptional<edm::InputTag>("fatJets");
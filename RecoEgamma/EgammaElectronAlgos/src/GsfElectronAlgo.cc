@@ -219,6 +219,7 @@ struct GsfElectronAlgo::EventData
   EgammaTowerIsolation * hadDepth2Isolation03Bc, * hadDepth2Isolation04Bc ;
   EgammaRecHitIsolation * ecalBarrelIsol03, * ecalBarrelIsol04 ;
   EgammaRecHitIsolation * ecalEndcapIsol03, * ecalEndcapIsol04 ;
+  EleTkIsolFromCands::TrkTable * ctfTrkTable ; // shared by the 0.3 and 0.4 track isolations, built on first use
 
   //Isolation Value Maps for PF and EcalDriven electrons
   typedef std::vector< edm::Handle< edm::ValueMap<double> > > IsolationValueMaps;
@@ -235,7 +236,8 @@ GsfElectronAlgo::EventData::EventData()
    hadDepth1Isolation03Bc(nullptr), hadDepth1Isolation04Bc(nullptr),
    hadDepth2Isolation03Bc(nullptr), hadDepth2Isolation04Bc(nullptr),
    ecalBarrelIsol03(nullptr), ecalBarrelIsol04(nullptr),
-   ecalEndcapIsol03(nullptr), ecalEndcapIsol04(nullptr)
+   ecalEndcapIsol03(nullptr), ecalEndcapIsol04(nullptr),
+   ctfTrkTable(nullptr)
  {
   electrons = new GsfElectronPtrCollection ;
  }
@@ -254,6 +256,7 @@ GsfElectronAlgo::EventData::~EventData()
   delete ecalBarrelIsol04 ;
   delete ecalEndcapIsol03 ;
   delete ecalEndcapIsol04 ;
+  delete ctfTrkTable ;
 
   GsfElectronPtrCollection::const_iterator it ;
   for ( it = electrons->begin() ; it != electrons->end() ; it++ )
@@ -850,7 +853,7 @@ void GsfElectronAlgo::beginEvent( edm::Event & event )
   generalData_->hcalHelper->readEvent(event) ;
   generalData_->hcalHelperPflow->readEvent(event) ;
 
-  // Isolation algos
+  // Isolation algos (the track table is built for the first electron)
   float egHcalIsoConeSizeOutSmall=0.3, egHcalIsoConeSizeOutLarge=0.4;
   float egHcalIsoConeSizeIn=generalData_->isoCfg.intRadiusHcal,egHcalIsoPtMin=generalData_->isoCfg.etMinHcal;
   int egHcalDepth1=1, egHcalDepth2=2;
@@ -1537,8 +1540,10 @@ void GsfElectronAlgo::createElectron(const gsfAlgoHelpers::HeavyObjectCache* hoc
   //====================================================
 
   reco::GsfElectron::IsolationVariables dr03, dr04 ;
-  dr03.tkSumPt = tkIsol03Calc_.calIsolPt(*ele->gsfTrack(),*eventData_->currentCtfTracks);
-  dr04.tkSumPt = tkIsol04Calc_.calIsolPt(*ele->gsfTrack(),*eventData_->currentCtfTracks);
+  if (!eventData_->ctfTrkTable)
+   { eventData_->ctfTrkTable = new EleTkIsolFromCands::TrkTable(*eventData_->currentCtfTracks) ; }
+  dr03.tkSumPt = tkIsol03Calc_.calIsolPt(*ele->gsfTrack(),*eventData_->ctfTrkTable);
+  dr04.tkSumPt = tkIsol04Calc_.calIsolPt(*ele->gsfTrack(),*eventData_->ctfTrkTable);
  
   if( !(region==DetId::Forward || region == DetId::Hcal) ) {  
     dr03.hcalDepth1TowerSumEt = eventData_->hadDepth1Isolation03->getTowerEtSum(ele) ;
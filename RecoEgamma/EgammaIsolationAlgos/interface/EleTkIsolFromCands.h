@@ -7,6 +7,9 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 
+#include <algorithm>
+#include <vector>
+
 //author S. Harper (RAL)
 //this class does a simple calculation of the track isolation for a track with eta,
 //phi and z vtx (typically the GsfTrack of the electron). It uses
@@ -40,6 +43,10 @@
 //      Note in all this, I'm not concerned about the electron in questions track, that will be rejected,
 //      I'm concerned about near by fake electrons which have been recoed by PF
 //      This is handled by the PIDVeto, which obviously is only used/required when using PFCandidates
+//
+//the tracks (or candidates) of an event can be put once in a TrkTable, sorted in eta, which is
+//then shared by all the electrons and cone sizes: only the tracks in the eta range of the cone
+//are checked. The results are identical to the ones computed on the collection
 
 
 class EleTkIsolFromCands {
@@ -69,6 +76,29 @@ private:
   TrkCuts barrelCuts_,endcapCuts_;
 
 public:
+  class TrkTable {
+  public:
+    explicit TrkTable(const reco::TrackCollection& tracks);
+    explicit TrkTable(const pat::PackedCandidateCollection& cands,const PIDVeto pidVeto=PIDVeto::NONE);
+
+    size_t size()const{return trks_.size();}
+    //calls func(index in the collection,track) for the tracks with minEta<=eta<=maxEta
+    template<typename Func>
+    void forEachInEtaRange(double minEta,double maxEta,Func func)const{
+      auto first = std::lower_bound(etas_.begin(),etas_.end(),minEta);
+      for(size_t i=first-etas_.begin();i<etas_.size() && etas_[i]<=maxEta;i++){
+	func(indices_[i],*trks_[i]);
+      }
+    }
+  private:
+    void add(const reco::TrackBase& trk,unsigned int index);
+    void sortInEta();
+
+    std::vector<double> etas_;
+    std::vector<unsigned int> indices_;
+    std::vector<const reco::TrackBase*> trks_;
+  };
+
   explicit EleTkIsolFromCands(const edm::ParameterSet& para);
   EleTkIsolFromCands(const EleTkIsolFromCands&)=default;
   ~EleTkIsolFromCands()=default;
@@ -84,6 +114,10 @@ public:
   std::pair<int,double> calIsol(const reco::TrackBase& trk,const reco::TrackCollection& tracks)const;
   std::pair<int,double> calIsol(const double eleEta,const double elePhi,const double eleVZ,
 				const reco::TrackCollection& tracks)const;
+
+  std::pair<int,double> calIsol(const reco::TrackBase& trk,const TrkTable& trks)const;
+  std::pair<int,double> calIsol(const double eleEta,const double elePhi,const double eleVZ,
+				const TrkTable& trks)const;
   
   //little helper function for the four calIsol functions for it to directly return the pt
   template<typename ...Args> 
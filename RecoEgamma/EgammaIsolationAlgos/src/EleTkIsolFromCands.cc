@@ -2,6 +2,8 @@
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/Math/interface/deltaR.h"
 
+#include <cmath>
+
 EleTkIsolFromCands::TrkCuts::TrkCuts(const edm::ParameterSet& para)
 {
   minPt = para.getParameter<double>("minPt");
@@ -118,6 +120,85 @@ EleTkIsolFromCands::calIsol(const double eleEta,const double elePhi,
   return {nrTrks,ptSum};	
 }	
 
+EleTkIsolFromCands::TrkTable::TrkTable(const reco::TrackCollection& tracks)
+{
+  for(unsigned int trkNr=0;trkNr<tracks.size();trkNr++){
+    add(tracks[trkNr],trkNr);
+  }
+  sortInEta();
+}
+
+EleTkIsolFromCands::TrkTable::TrkTable(const pat::PackedCandidateCollection& cands,
+				       const PIDVeto pidVeto)
+{
+  for(unsigned int candNr=0;candNr<cands.size();candNr++){
+    const auto& cand = cands[candNr];
+    if(cand.hasTrackDetails() && cand.charge()!=0 && passPIDVeto(cand.pdgId(),pidVeto)){
+      add(cand.pseudoTrack(),candNr);
+    }
+  }
+  sortInEta();
+}
+
+void EleTkIsolFromCands::TrkTable::add(const reco::TrackBase& trk,unsigned int index)
+{
+  //such a track never passes the dR cuts
+  if(std::isnan(trk.eta())) return;
+  etas_.push_back(trk.eta());
+  indices_.push_back(index);
+  trks_.push_back(&trk);
+}
+
+void EleTkIsolFromCands::TrkTable::sortInEta()
+{
+  std::vector<unsigned int> order(etas_.size());
+  for(unsigned int i=0;i<order.size();i++) order[i]=i;
+  std::stable_sort(order.begin(),order.end(),
+		   [this](unsigned int lhs,unsigned int rhs){return etas_[lhs]<etas_[rhs];});
+  std::vector<double> etas(order.size());
+  std::vector<unsigned int> indices(order.size());
+  std::vector<const reco::TrackBase*> trks(order.size());
+  for(unsigned int i=0;i<order.size();i++){
+    etas[i]=etas_[order[i]];
+    indices[i]=indices_[order[i]];
+    trks[i]=trks_[order[i]];
+  }
+  etas_.swap(etas);
+  indices_.swap(indices);
+  trks_.swap(trks);
+}
+
+std::pair<int,double> 
+EleTkIsolFromCands::calIsol(const reco::TrackBase& eleTrk,
+			    const TrkTable& trks)const
+{
+  return calIsol(eleTrk.eta(),eleTrk.phi(),eleTrk.vz(),trks);
+}
+
+std::pair<int,double> 
+EleTkIsolFromCands::calIsol(const double eleEta,const double elePhi,
+			    const double eleVZ,
+			    const TrkTable& trks)const
+{
+  const TrkCuts& cuts = std::abs(eleEta)<1.5 ? barrelCuts_ : endcapCuts_;
+
+  //the cut on dR2 is done in float, the eta range has a small margin for its rounding
+  const double maxDEta = std::sqrt(cuts.maxDR2)*1.0001+1e-6;
+  //the selected tracks are summed in the order of the collection, as in the other calIsol
+  std::vector<std::pair<unsigned int,double> > selected;
+  trks.forEachInEtaRange(eleEta-maxDEta,eleEta+maxDEta,
+			 [&](unsigned int index,const reco::TrackBase& trk){
+			   if(passTrkSel(trk,trk.pt(),cuts,eleEta,elePhi,eleVZ)){
+			     selected.emplace_back(index,trk.pt());
+			   }
+			 });
+  std::sort(selected.begin(),selected.end());
+
+  double ptSum=0.;
+  for(auto& trk : selected) ptSum+=trk.second;
+  return {static_cast<int>(selected.size()),ptSum};
+}
+
 bool EleTkIsolFromCands::passPIDVeto(const int pdgId,const EleTkIsolFromCands::PIDVeto veto)
 {
   int pidAbs = std::abs(pdgId);
@@ -12,6 +12,7 @@
 #include "RecoEgamma/EgammaTools/interface/ConversionTools.h"
 
 #include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestFlat.h"
 
 #include <vector>
 #include <string>
@@ -137,6 +138,8 @@ class ElectronMVAEstimatorRun2Spring16HZZ : public AnyMVAEstimatorRun2Base{
 
   // Data members
   std::vector< std::unique_ptr<const GBRForest> > gbrForest_s;
+  // flat copies used for the evaluation
+  std::vector<GBRForestFlat> gbrForestFlat_s;
 
   // All variables needed by this MVA
   const std::string MethodName_;
@@ -68,10 +68,13 @@ private:
 				  edm::Handle<EcalRecHitCollection>& eeHits,
 				  edm::ESHandle<CaloTopology>& caloTopo);
 
-  float calTrkIso(const reco::GsfElectron& ele,		  
-		  const edm::View<reco::GsfElectron>& eles,
-		  const std::vector<edm::Handle<pat::PackedCandidateCollection> >& handles,
-		  const std::vector<EleTkIsolFromCands::PIDVeto>& pidVetos)const;
+  //one table per valid candidate collection, shared by all the electrons of the event
+  static std::vector<EleTkIsolFromCands::TrkTable> 
+  makeTrkTables(const std::vector<edm::Handle<pat::PackedCandidateCollection> >& handles,
+		const std::vector<EleTkIsolFromCands::PIDVeto>& pidVetos);
+
+  float calTrkIso(const reco::GsfElectron& ele,
+		  const std::vector<EleTkIsolFromCands::TrkTable>& trkTables)const;
     
   template <typename T> void setToken(edm::EDGetTokenT<T>& token,edm::InputTag tag){token=consumes<T>(tag);}
   template <typename T> void setToken(edm::EDGetTokenT<T>& token,const edm::ParameterSet& iPara,const std::string& tag){token=consumes<T>(iPara.getParameter<edm::InputTag>(tag));}
@@ -210,6 +213,9 @@ void ElectronHEEPIDValueMapProducer::produce(edm::Event& iEvent, const edm::Even
 
   bool isAOD = isEventAOD(iEvent,eleToken_);
   const auto& candVetos = isAOD ? candVetosAOD_ : candVetosMiniAOD_;
+  // the track tables are only needed if there are electrons
+  std::vector<EleTkIsolFromCands::TrkTable> candTables;
+  if(!eleHandle->empty()) candTables = makeTrkTables(candHandles,candVetos);
 
   edm::ESHandle<CaloTopology> caloTopoHandle;
   iSetup.get<CaloTopologyRecord>().get(caloTopoHandle);
@@ -218,7 +224,7 @@ void ElectronHEEPIDValueMapProducer::produce(edm::Event& iEvent, const edm::Even
   std::vector<int> eleNrSaturateIn5x5;
   for(size_t eleNr=0;eleNr<eleHandle->size();eleNr++){
     auto elePtr = eleHandle->ptrAt(eleNr);
-    eleTrkPtIso.push_back(calTrkIso(*elePtr,*eleHandle,candHandles,candVetos));
+    eleTrkPtIso.push_back(calTrkIso(*elePtr,candTables));
     eleNrSaturateIn5x5.push_back(nrSaturatedCrysIn5x5(*elePtr,ebRecHitHandle,eeRecHitHandle,caloTopoHandle));    
   }
   
@@ -237,24 +243,33 @@ int ElectronHEEPIDValueMapProducer::nrSaturatedCrysIn5x5(const reco::GsfElectron
 
 }
 
+std::vector<EleTkIsolFromCands::TrkTable> ElectronHEEPIDValueMapProducer::
+makeTrkTables(const std::vector<edm::Handle<pat::PackedCandidateCollection> >& handles,
+	      const std::vector<EleTkIsolFromCands::PIDVeto>& pidVetos)
+{
+  std::vector<EleTkIsolFromCands::TrkTable> trkTables;
+  for(size_t handleNr=0;handleNr<handles.size();handleNr++){
+    auto& handle = handles[handleNr];
+    if(handle.isValid()){
+      if(handleNr<pidVetos.size()){
+	trkTables.emplace_back(*handle,pidVetos[handleNr]);
+      }else{
+	throw cms::Exception("LogicError") <<" somehow the pidVetos and handles do not much, given this is checked at construction time, something has gone wrong in the code handle nr "<<handleNr<<" size of vetos "<<pidVetos.size();
+      }
+    }
+  }
+  return trkTables;
+}
+
 float ElectronHEEPIDValueMapProducer::
-calTrkIso(const reco::GsfElectron& ele,		  
-	  const edm::View<reco::GsfElectron>& eles,
-	  const std::vector<edm::Handle<pat::PackedCandidateCollection> >& handles,
-	  const std::vector<EleTkIsolFromCands::PIDVeto>& pidVetos)const
+calTrkIso(const reco::GsfElectron& ele,
+	  const std::vector<EleTkIsolFromCands::TrkTable>& trkTables)const
 {
   if(ele.gsfTrack().isNull()) return std::numeric_limits<float>::max();
   else{
     float trkIso=0.; 
-    for(size_t handleNr=0;handleNr<handles.size();handleNr++){
-      auto& handle = handles[handleNr];
-      if(handle.isValid()){
-	if(handleNr<pidVetos.size()){
-	  trkIso+= trkIsoCalc_.calIsolPt(*ele.gsfTrack(),*handle,pidVetos[handleNr]);
-	}else{
-	  throw cms::Exception("LogicError") <<" somehow the pidVetos and handles do not much, given this is checked at construction time, something has gone wrong in the code handle nr "<<handleNr<<" size of vetos "<<pidVetos.size();
-	}
-      }
+    for(auto& trkTable : trkTables){
+      trkIso+= trkIsoCalc_.calIsolPt(*ele.gsfTrack(),trkTable);
     }
     return trkIso;
   }
@@ -29,6 +29,7 @@ void ElectronMVAEstimatorRun2Spring16GeneralPurpose::init(const std::vector <std
       << "wrong number of weightfiles" << std::endl;
 
   gbrForest_s.clear();
+  gbrForestFlat_s.clear();
   // Create a TMVA reader object for each category
   for(int i=0; i<nCategories; i++){
 
@@ -37,6 +38,7 @@ void ElectronMVAEstimatorRun2Spring16GeneralPurpose::init(const std::vector <std
 
     edm::FileInPath weightFile( weightFileNames[i] );
     gbrForest_s.push_back( createSingleReader(i, weightFile ) );
+    gbrForestFlat_s.emplace_back( *gbrForest_s.back() );
 
   }
 
@@ -96,7 +98,7 @@ mvaValue( const reco::GsfElectron * particle, const edm::EventBase & iEvent) con
 
 float ElectronMVAEstimatorRun2Spring16GeneralPurpose::
 mvaValue( const int iCategory, const std::vector<float> & vars) const  {
-  const float result = gbrForest_s.at(iCategory)->GetClassifier(vars.data());
+  const float result = gbrForestFlat_s.at(iCategory).GetClassifier(vars.data());
 
   const bool debug = false;
   if(debug) {
@@ -37,8 +37,8 @@ public:
 					       float jec, const reco::Vertex *, const reco::VertexCollection &, double rho);
 
 	void set(const PileupJetIdentifier &);
-        std::unique_ptr<const GBRForest> getMVA(const std::vector<std::string> &, const std::string &);
-        float getMVAval(const std::vector<std::string> &, const std::unique_ptr<const GBRForest> &);
+        std::shared_ptr<const GBRForest> getMVA(const std::vector<std::string> &, const std::string &);
+        float getMVAval(const std::vector<std::string> &, const std::shared_ptr<const GBRForest> &);
 	PileupJetIdentifier computeMva();
 	const std::string method() const { return tmvaMethod_; }
 	
@@ -66,8 +66,8 @@ protected:
 	PileupJetIdentifier internalId_;
 	variables_list_t variables_;
 
-	std::unique_ptr<const GBRForest> reader_;
-        std::vector<std::unique_ptr<const GBRForest>> etaReader_;
+	std::shared_ptr<const GBRForest> reader_;
+        std::vector<std::shared_ptr<const GBRForest>> etaReader_;
 	std::string tmvaWeights_, tmvaMethod_;
         std::vector<std::string> tmvaEtaWeights_;
 	std::vector<std::string> tmvaVariables_;
@@ -115,6 +115,16 @@ FastjetJetProducer::FastjetJetProducer(const edm::ParameterSet& iConfig):
 
 	input_chrefcand_token_ = consumes<edm::View<reco::RecoChargedRefCandidate> >(iConfig.getParameter<edm::InputTag>("src"));
 
+	// the grid-median rho of the same inputs may already be in the event,
+	// it is then computed once for all the jet collections that subtract it
+	const edm::InputTag srcGridRho = iConfig.existsAs<edm::InputTag>("srcGridRho") ?
+	  iConfig.getParameter<edm::InputTag>("srcGridRho") : edm::InputTag();
+	useGridRhoFromEvent_ = correctShape_ && !srcGridRho.label().empty();
+	if ( useGridRhoFromEvent_ ) {
+	  input_gridrho_token_ = consumes<double>(srcGridRho);
+	  input_gridrhom_token_ = consumes<double>(edm::InputTag(srcGridRho.label(),"rhom",srcGridRho.process()));
+	}
+
 	if ( useFiltering_ ||
 			useTrimming_ ||
 			usePruning_ ||
@@ -420,7 +430,13 @@ void FastjetJetProducer::runAlgorithm( edm::Event & iEvent, edm::EventSetup cons
 
     unique_ptr<fastjet::Subtractor> subtractor;
     unique_ptr<fastjet::GridMedianBackgroundEstimator> bge_rho_grid;
-    if ( correctShape_ ) {
+    if ( correctShape_ && useGridRhoFromEvent_ ) {
+      edm::Handle<double> rho, rhom;
+      iEvent.getByToken(input_gridrho_token_, rho);
+      iEvent.getByToken(input_gridrhom_token_, rhom);
+      subtractor = unique_ptr<fastjet::Subtractor>( new fastjet::Subtractor( *rho, *rhom ) );
+      subtractor->set_use_rho_m();
+    } else if ( correctShape_ ) {
       bge_rho_grid = unique_ptr<fastjet::GridMedianBackgroundEstimator> (new  fastjet::GridMedianBackgroundEstimator(gridMaxRapidity_, gridSpacing_) );
       bge_rho_grid->set_particles(fjInputs_);
       subtractor = unique_ptr<fastjet::Subtractor>( new fastjet::Subtractor(  bge_rho_grid.get()) );
@@ -499,6 +515,7 @@ void FastjetJetProducer::fillDescriptionsFromFastJetProducer(edm::ParameterSetDe
 	desc.add<double>("R0",	-1.0);
 	desc.add<double>("gridMaxRapidity",	-1.0); // For fixed-grid rho
 	desc.add<double>("gridSpacing",	-1.0);  // For fixed-grid rho
+	desc.add<edm::InputTag>("srcGridRho",	edm::InputTag()); // fixed-grid rho and rho_m of the same inputs, if already computed
 	desc.add<double>("DzTrVtxMax",	999999.);  
 	desc.add<double>("DxyTrVtxMax",	999999.);  
 	desc.add<double>("MaxVtxZ",	15.0);  
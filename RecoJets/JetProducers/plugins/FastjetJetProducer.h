@@ -104,6 +104,7 @@ protected:
   double R0_;                 /// for soft drop : R0 (angular distance normalization - should be set to jet radius in most cases)
   double gridMaxRapidity_;    /// for shape subtraction, get the fixed-grid rho
   double gridSpacing_;        /// for shape subtraction, get the grid spacing
+  bool useGridRhoFromEvent_;  /// for shape subtraction, read rho and rho_m computed by a FixedGridRhoProducerFastjet
 
 
   double subjetPtMin_;        /// for CMSBoostedTauSeedingAlgorithm : subjet pt min
@@ -118,6 +119,8 @@ protected:
 
   // tokens for the data access
   edm::EDGetTokenT<edm::View<reco::RecoChargedRefCandidate> > input_chrefcand_token_;
+  edm::EDGetTokenT<double> input_gridrho_token_;
+  edm::EDGetTokenT<double> input_gridrhom_token_;
     
 };
 
@@ -11,7 +11,9 @@ FixedGridRhoProducerFastjet::FixedGridRhoProducerFastjet(const edm::ParameterSet
 	iConfig.getParameter<double>("gridSpacing") )
 {
   pfCandidatesTag_ = iConfig.getParameter<edm::InputTag>("pfCandidatesTag");
+  produceRhoM_ = iConfig.existsAs<bool>("produceRhoM") && iConfig.getParameter<bool>("produceRhoM");
   produces<double>();
+  if (produceRhoM_) produces<double>("rhom");
 
   input_pfcoll_token_ = consumes<edm::View<reco::Candidate> >(pfCandidatesTag_);
 
@@ -30,6 +32,7 @@ void FixedGridRhoProducerFastjet::produce(edm::Event& iEvent, const edm::EventSe
    }
    bge_.set_particles(inputs);
    iEvent.put(std::make_unique<double>(bge_.rho()));
+   if (produceRhoM_) iEvent.put(std::make_unique<double>(bge_.rho_m()),"rhom");
 }
 
 DEFINE_FWK_MODULE(FixedGridRhoProducerFastjet);
@@ -20,6 +20,7 @@ class FixedGridRhoProducerFastjet : public edm::stream::EDProducer<> {
 
   edm::InputTag pfCandidatesTag_;
   fastjet::GridMedianBackgroundEstimator bge_;
+  bool produceRhoM_;  // also put rho_m, for the jet producers that subtract with the same grid
 
   edm::EDGetTokenT<edm::View<reco::Candidate> > input_pfcoll_token_;
 
@@ -4,7 +4,9 @@ import FWCore.ParameterSet.Config as cms
 fixedGridRhoFastjetAll = cms.EDProducer("FixedGridRhoProducerFastjet",
     pfCandidatesTag = cms.InputTag("particleFlow"),
     maxRapidity = cms.double(5.0),
-    gridSpacing = cms.double(0.55)
+    gridSpacing = cms.double(0.55),
+    # also put rho_m ("rhom"), see srcGridRho of FastjetJetProducer
+    produceRhoM = cms.bool(False)
 )
 
 
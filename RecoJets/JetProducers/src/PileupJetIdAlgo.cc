@@ -6,11 +6,10 @@
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "DataFormats/Math/interface/deltaR.h"
 #include "FWCore/ParameterSet/interface/FileInPath.h"
-#include "CommonTools/Utils/interface/TMVAZipReader.h"
+#include "CommonTools/Utils/interface/TMVAForestCache.h"
 
 #include "TMatrixDSym.h"
 #include "TMatrixDSymEigen.h"
-#include "TMVA/MethodBDT.h"
 
 // ------------------------------------------------------------------------------------------
 const float large_val = std::numeric_limits<float>::max();
@@ -140,19 +139,16 @@ void setPtEtaPhi(const reco::Candidate & p, float & pt, float & eta, float &phi
 	phi = p.phi();
 }
 
-std::unique_ptr<const GBRForest> PileupJetIdAlgo::getMVA(const std::vector<std::string> &varList, const std::string &tmvaWeights)
+std::shared_ptr<const GBRForest> PileupJetIdAlgo::getMVA(const std::vector<std::string> &varList, const std::string &tmvaWeights)
 {
-        TMVA::Reader tmpTMVAReader( "!Color:Silent:!Error" );
         for(std::vector<std::string>::const_iterator it=varList.begin(); it!=varList.end(); ++it) {
             if( tmvaNames_[*it].empty() ) tmvaNames_[*it] = *it;
-            tmpTMVAReader.AddVariable( *it, variables_[ tmvaNames_[*it] ].first );
         }
         for(std::vector<std::string>::iterator it=tmvaSpectators_.begin(); it!=tmvaSpectators_.end(); ++it) {
             if( tmvaNames_[*it].empty() ) tmvaNames_[*it] = *it;
-            tmpTMVAReader.AddSpectator( *it, variables_[ tmvaNames_[*it] ].first );
         }
-        reco::details::loadTMVAWeights(&tmpTMVAReader,  tmvaMethod_, tmvaWeights);
-        return( std::make_unique<const GBRForest> ( dynamic_cast<TMVA::MethodBDT*>( tmpTMVAReader.FindMVA(tmvaMethod_.c_str()) ) ) );
+        // read once per process, shared by all streams and configurations using the same weights
+        return reco::getSharedGBRForest(tmvaMethod_, tmvaWeights, varList, tmvaSpectators_);
 }
 
 void PileupJetIdAlgo::bookReader()
@@ -172,7 +168,7 @@ void PileupJetIdAlgo::set(const PileupJetIdentifier & id)
 
 // ------------------------------------------------------------------------------------------
 
-float PileupJetIdAlgo::getMVAval(const std::vector<std::string> &varList, const std::unique_ptr<const GBRForest> &reader)
+float PileupJetIdAlgo::getMVAval(const std::vector<std::string> &varList, const std::shared_ptr<const GBRForest> &reader)
 {
         float mvaval = -2;
         std::vector<float> vars;
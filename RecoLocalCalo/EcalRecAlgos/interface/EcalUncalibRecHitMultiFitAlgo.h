@@ -23,9 +23,18 @@ class EcalUncalibRecHitMultiFitAlgo
   
  public:
   
+  /// result of the one-pulse prefit of a crystal computed beforehand (see prefitInputs)
+  struct Prefit {
+    double amplitude;
+    double chisq;
+  };
+
   EcalUncalibRecHitMultiFitAlgo();
   ~EcalUncalibRecHitMultiFitAlgo() { };
-  EcalUncalibratedRecHit makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX);
+  EcalUncalibratedRecHit makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX, const Prefit * prefit = nullptr);
+  /// amplitudes and noise covariance of the prefit of a crystal; false if its prefit
+  /// is not a plain one-pulse fit (dynamic pedestals, bad samples, max-sample shortcut)
+  bool prefitInputs(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, SampleVector &amplitudes, SampleMatrix &noisecov) const;
   void disableErrorCalculation() { _computeErrors = false; }
   void setDoPrefit(bool b) { _doPrefit = b; }
   void setPrefitMaxChiSq(double x) { _prefitMaxChiSq = x; }
@@ -37,6 +46,19 @@ class EcalUncalibRecHitMultiFitAlgo
   void setGainSwitchUseMaxSample(bool b) { _gainSwitchUseMaxSample = b; }
   
  private:
+   struct Inputs {
+     SampleVector amplitudes;
+     SampleMatrix noisecov;
+     SampleGainVector gainsNoise;
+     SampleGainVector gainsPedestal;
+     SampleGainVector badSamples;
+     double maxamplitude;
+     double pedval;
+     bool hasGainSwitch;
+     bool dynamicPedestal;
+   };
+   void fillInputs(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, Inputs &in) const;
+
    PulseChiSqSNNLS _pulsefunc;
    PulseChiSqSNNLS _pulsefuncSingle;
    bool _computeErrors;
@@ -0,0 +1,59 @@
+#ifndef PulseChiSqOnePulseBatch_h
+#define PulseChiSqOnePulseBatch_h
+
+/** \class PulseChiSqOnePulseBatch
+  *  One-pulse (in-time only) fit of many crystals at once, as done by
+  *  PulseChiSqSNNLS with a single bx, one iteration and no pedestal or
+  *  step columns (the multifit prefit).
+  *
+  *  The inputs are stored crystal-innermost in groups of kLanes crystals,
+  *  so that the Cholesky decomposition of the covariance and the triangular
+  *  solves of a group run in the SIMD lanes. The storage grows to the
+  *  largest number of crystals seen and is reused afterwards.
+  *
+  *  The results agree with PulseChiSqSNNLS to rounding. A crystal whose
+  *  covariance is not positive definite is flagged with status() false and
+  *  must be fitted with PulseChiSqSNNLS.
+  */
+
+#include "RecoLocalCalo/EcalRecAlgos/interface/EigenMatrixTypes.h"
+
+#include <vector>
+
+class PulseChiSqOnePulseBatch {
+  public:
+
+    static constexpr unsigned int kLanes = 8;
+
+    void clear() { _n = 0; }
+
+    /// adds a crystal, returns its index in the batch
+    unsigned int add(const SampleVector &samples, const SampleMatrix &samplecov, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov);
+
+    void fit();
+
+    unsigned int size() const { return _n; }
+    bool status(unsigned int i) const { return _status[i]; }
+    double X(unsigned int i) const { return _amplitude[i]; }
+    double ChiSq(unsigned int i) const { return _chisq[i]; }
+
+  private:
+
+    static constexpr unsigned int nsample = SampleVector::RowsAtCompileTime;
+    // per crystal: samples, pulse and lower triangle of the covariance
+    static constexpr unsigned int nTriangle = nsample*(nsample+1)/2;
+    static constexpr unsigned int nInputs = 2*nsample + nTriangle;
+
+    static constexpr unsigned int tri(unsigned int i, unsigned int j) { return i*(i+1)/2 + j; }
+    double * group(unsigned int g) { return _inputs.data() + std::size_t(g)*nInputs*kLanes; }
+
+    void fitGroup(unsigned int g);
+
+    unsigned int _n = 0;
+    std::vector<double> _inputs;
+    std::vector<double> _amplitude;
+    std::vector<double> _chisq;
+    std::vector<char> _status;
+};
+
+#endif
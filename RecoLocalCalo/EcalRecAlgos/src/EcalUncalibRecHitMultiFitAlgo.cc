@@ -5,6 +5,11 @@
 #include "CondFormats/EcalObjects/interface/EcalPedestals.h"
 #include "CondFormats/EcalObjects/interface/EcalGainRatios.h"
 
+namespace {
+  constexpr unsigned int iSampleMax = 5;
+  constexpr unsigned int iFullPulseMax = 9;
+}
+
 EcalUncalibRecHitMultiFitAlgo::EcalUncalibRecHitMultiFitAlgo() : 
   _computeErrors(true),
   _doPrefit(false),
@@ -25,28 +30,28 @@ EcalUncalibRecHitMultiFitAlgo::EcalUncalibRecHitMultiFitAlgo() :
     
 }
 
-/// compute rechits
-EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX) {
+/// amplitudes, gains and noise covariance of a crystal
+void EcalUncalibRecHitMultiFitAlgo::fillInputs(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, Inputs &in) const {
 
-  uint32_t flags = 0;
-  
   const unsigned int nsample = EcalDataFrame::MAXSAMPLES;
   
-  double maxamplitude = -std::numeric_limits<double>::max();
-  const unsigned int iSampleMax = 5;
-  const unsigned int iFullPulseMax = 9;
-  
-  double pedval = 0.;
+  double &maxamplitude = in.maxamplitude;
+  double &pedval = in.pedval;
+  maxamplitude = -std::numeric_limits<double>::max();
+  pedval = 0.;
     
-  SampleVector amplitudes;
-  SampleGainVector gainsNoise;
-  SampleGainVector gainsPedestal;
-  SampleGainVector badSamples = SampleGainVector::Zero();
+  SampleVector &amplitudes = in.amplitudes;
+  SampleGainVector &gainsNoise = in.gainsNoise;
+  SampleGainVector &gainsPedestal = in.gainsPedestal;
+  SampleGainVector &badSamples = in.badSamples;
+  badSamples = SampleGainVector::Zero();
   bool hasSaturation = dataFrame.isSaturated();
-  bool hasGainSwitch = hasSaturation || dataFrame.hasSwitchToGain6() || dataFrame.hasSwitchToGain1();
+  bool &hasGainSwitch = in.hasGainSwitch;
+  hasGainSwitch = hasSaturation || dataFrame.hasSwitchToGain6() || dataFrame.hasSwitchToGain1();
   
   //no dynamic pedestal in case of gain switch, since then the fit becomes too underconstrained
-  bool dynamicPedestal = _dynamicPedestals && !hasGainSwitch;
+  bool &dynamicPedestal = in.dynamicPedestal;
+  dynamicPedestal = _dynamicPedestals && !hasGainSwitch;
   
   for(unsigned int iSample = 0; iSample < nsample; iSample++) {
         
@@ -104,24 +109,8 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
         
   }
 
-  double amplitude, amperr, chisq;
-  bool status = false;
-    
-  //special handling for gain switch, where sample before maximum is potentially affected by slew rate limitation
-  //optionally apply a stricter criteria, assuming slew rate limit is only reached in case where maximum sample has gain switched but previous sample has not
-  //option 1: use simple max-sample algorithm
-  if (hasGainSwitch && _gainSwitchUseMaxSample) {
-    double maxpulseamplitude = maxamplitude / fullpulse[iFullPulseMax];
-    EcalUncalibratedRecHit rh( dataFrame.id(), maxpulseamplitude, pedval, 0., 0., flags );
-    rh.setAmplitudeError(0.);
-    for (unsigned int ipulse=0; ipulse<_pulsefunc.BXs().rows(); ++ipulse) {
-      int bx = _pulsefunc.BXs().coeff(ipulse);
-      if (bx!=0) {
-        rh.setOutOfTimeAmplitude(bx+5, 0.0);
-      }
-    }
-    return rh;
-  }
+  //the simple max-sample algorithm is used in case of gain switch, see makeRecHit
+  if (hasGainSwitch && _gainSwitchUseMaxSample) return;
 
   //option2: A floating negative single-sample offset is added to the fit
   //such that the affected sample is treated only as a lower limit for the true amplitude
@@ -132,7 +121,7 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   }
   
   //compute noise covariance matrix, which depends on the sample gains
-  SampleMatrix noisecov;
+  SampleMatrix &noisecov = in.noisecov;
   if (hasGainSwitch) {
     std::array<double,3> pedrmss = {{aped->rms_x12, aped->rms_x6, aped->rms_x1}};
     std::array<double,3> gainratios = {{ 1., aGain->gain12Over6(), aGain->gain6Over1()*aGain->gain12Over6()}};
@@ -168,14 +157,57 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
       noisecov += _addPedestalUncertainty*_addPedestalUncertainty*SampleMatrix::Ones();
     }
   }
+}
+
+/// compute rechits
+EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX, const Prefit * prefit) {
+
+  uint32_t flags = 0;
   
+  Inputs in;
+  fillInputs(dataFrame, aped, aGain, noisecors, in);
+  const double maxamplitude = in.maxamplitude;
+  const double pedval = in.pedval;
+  const SampleVector &amplitudes = in.amplitudes;
+  const SampleMatrix &noisecov = in.noisecov;
+  const SampleGainVector &gainsPedestal = in.gainsPedestal;
+  const SampleGainVector &badSamples = in.badSamples;
+  const bool hasGainSwitch = in.hasGainSwitch;
+
+  double amplitude, amperr, chisq;
+  bool status = false;
+    
+  //special handling for gain switch, where sample before maximum is potentially affected by slew rate limitation
+  //optionally apply a stricter criteria, assuming slew rate limit is only reached in case where maximum sample has gain switched but previous sample has not
+  //option 1: use simple max-sample algorithm
+  if (hasGainSwitch && _gainSwitchUseMaxSample) {
+    double maxpulseamplitude = maxamplitude / fullpulse[iFullPulseMax];
+    EcalUncalibratedRecHit rh( dataFrame.id(), maxpulseamplitude, pedval, 0., 0., flags );
+    rh.setAmplitudeError(0.);
+    for (unsigned int ipulse=0; ipulse<_pulsefunc.BXs().rows(); ++ipulse) {
+      int bx = _pulsefunc.BXs().coeff(ipulse);
+      if (bx!=0) {
+        rh.setOutOfTimeAmplitude(bx+5, 0.0);
+      }
+    }
+    return rh;
+  }
+
   //optimized one-pulse fit for hlt
   bool usePrefit = false;
   if (_doPrefit) {
-    status = _pulsefuncSingle.DoFit(amplitudes,noisecov,_singlebx,fullpulse,fullpulsecov,gainsPedestal,badSamples);
-    amplitude = status ? _pulsefuncSingle.X()[0] : 0.;
-    amperr = status ? _pulsefuncSingle.Errors()[0] : 0.;
-    chisq = _pulsefuncSingle.ChiSq();
+    if (prefit) {
+      status = true;
+      amplitude = prefit->amplitude;
+      amperr = 0.;
+      chisq = prefit->chisq;
+    }
+    else {
+      status = _pulsefuncSingle.DoFit(amplitudes,noisecov,_singlebx,fullpulse,fullpulsecov,gainsPedestal,badSamples);
+      amplitude = status ? _pulsefuncSingle.X()[0] : 0.;
+      amperr = status ? _pulsefuncSingle.Errors()[0] : 0.;
+      chisq = _pulsefuncSingle.ChiSq();
+    }
     
     if (chisq < _prefitMaxChiSq) {
       usePrefit = true;
@@ -225,3 +257,15 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   return rh;
 }
 
+bool EcalUncalibRecHitMultiFitAlgo::prefitInputs(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, SampleVector &amplitudes, SampleMatrix &noisecov) const {
+
+  Inputs in;
+  fillInputs(dataFrame, aped, aGain, noisecors, in);
+  if (in.hasGainSwitch && _gainSwitchUseMaxSample) return false;
+  //dynamic pedestals and step corrections add columns to the fit
+  if (in.gainsPedestal.maxCoeff()>=0 || in.badSamples.maxCoeff()>0) return false;
+
+  amplitudes = in.amplitudes;
+  noisecov = in.noisecov;
+  return true;
+}
@@ -0,0 +1,136 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqOnePulseBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+unsigned int PulseChiSqOnePulseBatch::add(const SampleVector &samples, const SampleMatrix &samplecov, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov) {
+
+  const unsigned int g = _n/kLanes;
+  const unsigned int l = _n%kLanes;
+
+  if (l==0) {
+    const std::size_t size = std::size_t(g+1)*nInputs*kLanes;
+    if (_inputs.size()<size) {
+      _inputs.resize(size);
+      _amplitude.resize((g+1)*kLanes);
+      _chisq.resize((g+1)*kLanes);
+      _status.resize((g+1)*kLanes);
+    }
+    //unused lanes of the last group fit a unit pulse to zero samples
+    double * in = group(g);
+    std::fill(in, in+nInputs*kLanes, 0.);
+    for (unsigned int i=0; i<nsample; ++i) {
+      std::fill_n(in + (nsample+i)*kLanes, kLanes, 1.);
+      std::fill_n(in + (2*nsample+tri(i,i))*kLanes, kLanes, 1.);
+    }
+  }
+
+  double * in = group(g) + l;
+  double * s = in;
+  double * p = in + nsample*kLanes;
+  double * c = in + 2*nsample*kLanes;
+
+  //same pulse position and covariance as PulseChiSqSNNLS for bx 0, with the
+  //amplitude initialized to the maximum sample
+  const int bx = 0;
+  const int firstsamplet = bx + 3;
+  const int offset = 7-3-bx;
+  const double ampveccoef = samples.coeff(bx + 5);
+  const double ampsq = ampveccoef*ampveccoef;
+
+  for (unsigned int i=0; i<nsample; ++i) {
+    s[i*kLanes] = samples.coeff(i);
+    p[i*kLanes] = fullpulse.coeff(i+offset);
+    for (unsigned int j=0; j<=i; ++j) {
+      double cov = samplecov.coeff(i,j);
+      if (ampveccoef!=0. && int(j)>=firstsamplet) cov += ampsq*fullpulsecov.coeff(i+offset,j+offset);
+      c[tri(i,j)*kLanes] = cov;
+    }
+  }
+
+  return _n++;
+}
+
+void PulseChiSqOnePulseBatch::fit() {
+  const unsigned int ngroups = (_n + kLanes - 1)/kLanes;
+  for (unsigned int g=0; g<ngroups; ++g) fitGroup(g);
+}
+
+void PulseChiSqOnePulseBatch::fitGroup(unsigned int g) {
+
+  const double * in = group(g);
+  const double * s = in;
+  const double * p = in + nsample*kLanes;
+  const double * c = in + 2*nsample*kLanes;
+
+  //all the loops below run over the lanes innermost
+  alignas(64) double L[nTriangle][kLanes];
+  alignas(64) double y[nsample][kLanes];
+  alignas(64) double z[nsample][kLanes];
+  alignas(64) double x[kLanes];
+  bool positive[kLanes];
+  std::fill_n(positive, kLanes, true);
+
+  //Cholesky decomposition of the covariance, c = L L^T
+  for (unsigned int j=0; j<nsample; ++j) {
+    for (unsigned int l=0; l<kLanes; ++l) x[l] = c[tri(j,j)*kLanes+l];
+    for (unsigned int k=0; k<j; ++k) {
+      for (unsigned int l=0; l<kLanes; ++l) x[l] -= L[tri(j,k)][l]*L[tri(j,k)][l];
+    }
+    for (unsigned int l=0; l<kLanes; ++l) {
+      positive[l] &= x[l]>0.;
+      L[tri(j,j)][l] = std::sqrt(x[l]>0. ? x[l] : 1.);
+    }
+    for (unsigned int i=j+1; i<nsample; ++i) {
+      for (unsigned int l=0; l<kLanes; ++l) x[l] = c[tri(i,j)*kLanes+l];
+      for (unsigned int k=0; k<j; ++k) {
+        for (unsigned int l=0; l<kLanes; ++l) x[l] -= L[tri(i,k)][l]*L[tri(j,k)][l];
+      }
+      for (unsigned int l=0; l<kLanes; ++l) L[tri(i,j)][l] = x[l]/L[tri(j,j)][l];
+    }
+  }
+
+  //y = L^-1 samples, z = L^-1 pulse
+  for (unsigned int i=0; i<nsample; ++i) {
+    for (unsigned int l=0; l<kLanes; ++l) {
+      y[i][l] = s[i*kLanes+l];
+      z[i][l] = p[i*kLanes+l];
+    }
+    for (unsigned int k=0; k<i; ++k) {
+      for (unsigned int l=0; l<kLanes; ++l) {
+        y[i][l] -= L[tri(i,k)][l]*y[k][l];
+        z[i][l] -= L[tri(i,k)][l]*z[k][l];
+      }
+    }
+    for (unsigned int l=0; l<kLanes; ++l) {
+      y[i][l] /= L[tri(i,i)][l];
+      z[i][l] /= L[tri(i,i)][l];
+    }
+  }
+
+  //non-negative amplitude and chi2 of the fit
+  alignas(64) double aTa[kLanes] = {};
+  alignas(64) double aTb[kLanes] = {};
+  alignas(64) double chisq[kLanes] = {};
+  for (unsigned int i=0; i<nsample; ++i) {
+    for (unsigned int l=0; l<kLanes; ++l) {
+      aTa[l] += z[i][l]*z[i][l];
+      aTb[l] += z[i][l]*y[i][l];
+    }
+  }
+  for (unsigned int l=0; l<kLanes; ++l) x[l] = std::max(0.,aTb[l]/aTa[l]);
+  for (unsigned int i=0; i<nsample; ++i) {
+    for (unsigned int l=0; l<kLanes; ++l) {
+      const double r = x[l]*z[i][l] - y[i][l];
+      chisq[l] += r*r;
+    }
+  }
+
+  const unsigned int nlanes = std::min(kLanes, _n - g*kLanes);
+  for (unsigned int l=0; l<nlanes; ++l) {
+    const unsigned int i = g*kLanes + l;
+    _status[i] = positive[l];
+    _amplitude[i] = x[l];
+    _chisq[i] = chisq[l];
+  }
+}
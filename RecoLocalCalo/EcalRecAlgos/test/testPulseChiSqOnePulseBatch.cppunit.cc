@@ -0,0 +1,138 @@
+/* Unit test for PulseChiSqOnePulseBatch: the batched one-pulse fit
+   must give the amplitudes and chi2 of PulseChiSqSNNLS with a single
+   in-time bx and one iteration (the multifit prefit)
+
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqOnePulseBatch.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class testPulseChiSqOnePulseBatch: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(testPulseChiSqOnePulseBatch);
+  CPPUNIT_TEST(testRandomInputs);
+  CPPUNIT_TEST(testNotPositiveDefinite);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown(){}
+
+  void testRandomInputs();
+  void testNotPositiveDefinite();
+
+private:
+  void randomInputs(SampleVector &samples, SampleMatrix &samplecov);
+
+  std::mt19937 engine_;
+  FullSampleVector fullpulse_;
+  FullSampleMatrix fullpulsecov_;
+  BXVector singlebx_;
+  PulseChiSqSNNLS single_;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testPulseChiSqOnePulseBatch);
+
+void testPulseChiSqOnePulseBatch::setUp(){
+
+  engine_.seed(12345);
+
+  // alpha-beta like pulse, peaking at sample 5, stored as in EcalUncalibRecHitWorkerMultiFit
+  fullpulse_ = FullSampleVector::Zero();
+  const double alpha = 1.5;
+  for (int i=0; i<12; ++i) {
+    const double x = (i+1)/3.;
+    fullpulse_(i+7) = std::pow(x,alpha)*std::exp(-alpha*(x-1.));
+  }
+
+  // small positive semi-definite pulse covariance
+  std::normal_distribution<double> gauss(0.,1.);
+  FullSampleMatrix a;
+  for (int i=0; i<FullSampleVectorSize; ++i)
+    for (int j=0; j<FullSampleVectorSize; ++j)
+      a(i,j) = gauss(engine_);
+  fullpulsecov_ = 1e-5*a*a.transpose();
+
+  singlebx_.resize(1);
+  singlebx_ << 0;
+
+  single_.disableErrorCalculation();
+  single_.setMaxIters(1);
+  single_.setMaxIterWarnings(false);
+}
+
+void testPulseChiSqOnePulseBatch::randomInputs(SampleVector &samples, SampleMatrix &samplecov){
+
+  std::uniform_real_distribution<double> amplitude(-5.,500.);
+  std::uniform_real_distribution<double> noise(0.5,3.);
+  std::uniform_real_distribution<double> correlation(0.,0.8);
+  std::normal_distribution<double> gauss(0.,1.);
+
+  // correlated noise
+  const double sigma = noise(engine_);
+  const double rho = correlation(engine_);
+  for (int i=0; i<SampleVectorSize; ++i)
+    for (int j=0; j<SampleVectorSize; ++j)
+      samplecov(i,j) = sigma*sigma*std::pow(rho,std::abs(i-j));
+
+  SampleVector white;
+  for (int i=0; i<SampleVectorSize; ++i) white(i) = gauss(engine_);
+  SampleMatrix l = samplecov.llt().matrixL();
+  samples = amplitude(engine_)*fullpulse_.segment<SampleVectorSize>(4) + l*white;
+}
+
+void testPulseChiSqOnePulseBatch::testRandomInputs(){
+
+  // not a multiple of the lanes, the last group is partly filled
+  const unsigned int ncrystals = 5*PulseChiSqOnePulseBatch::kLanes + 3;
+
+  std::vector<SampleVector> samples(ncrystals);
+  std::vector<SampleMatrix> samplecov(ncrystals);
+  PulseChiSqOnePulseBatch batch;
+
+  // the batch is reused, with fewer crystals the second time
+  for (unsigned int n : {ncrystals, ncrystals/2}) {
+    batch.clear();
+    for (unsigned int i=0; i<n; ++i) {
+      randomInputs(samples[i],samplecov[i]);
+      CPPUNIT_ASSERT_EQUAL(i, batch.add(samples[i],samplecov[i],fullpulse_,fullpulsecov_));
+    }
+    CPPUNIT_ASSERT_EQUAL(n, batch.size());
+    batch.fit();
+
+    for (unsigned int i=0; i<n; ++i) {
+      CPPUNIT_ASSERT(batch.status(i));
+      CPPUNIT_ASSERT(single_.DoFit(samples[i],samplecov[i],singlebx_,fullpulse_,fullpulsecov_));
+      const double amplitude = single_.X()[0];
+      const double chisq = single_.ChiSq();
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(amplitude, batch.X(i), 1e-9*std::max(1.,std::abs(amplitude)));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(chisq, batch.ChiSq(i), 1e-9*std::max(1.,chisq));
+    }
+  }
+}
+
+void testPulseChiSqOnePulseBatch::testNotPositiveDefinite(){
+
+  SampleVector samples;
+  SampleMatrix samplecov;
+  PulseChiSqOnePulseBatch batch;
+
+  randomInputs(samples,samplecov);
+  batch.add(samples,samplecov,fullpulse_,fullpulsecov_);
+
+  // no pulse covariance is added for a zero maximum sample
+  SampleVector zero = SampleVector::Zero();
+  SampleMatrix negative = -SampleMatrix::Identity();
+  batch.add(zero,negative,fullpulse_,fullpulsecov_);
+
+  batch.fit();
+  CPPUNIT_ASSERT(batch.status(0));
+  CPPUNIT_ASSERT(!batch.status(1));
+}
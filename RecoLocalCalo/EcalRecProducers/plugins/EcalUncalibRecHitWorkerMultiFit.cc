@@ -22,6 +22,26 @@
 #include <FWCore/ParameterSet/interface/ParameterSetDescription.h>
 #include <FWCore/ParameterSet/interface/EmptyGroupDescription.h>
 
+namespace {
+  // index of the last sample before the first saturated one (-1 if sample 0 is saturated), -2 if no sample is saturated
+  int lastSampleBeforeSaturation(const EcalDataFrame & dataFrame) {
+    for(unsigned int iSample = 0; iSample < EcalDataFrame::MAXSAMPLES; iSample++) {
+      if ( dataFrame.sample(iSample).gainId() == 0 ) return iSample-1;
+    }
+    return -2;
+  }
+
+  void fillPulse(const EcalPulseShapes::Item & aPulse, const EcalPulseCovariances::Item & aPulseCov,
+                 FullSampleVector & fullpulse, FullSampleMatrix & fullpulsecov) {
+    for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i)
+      fullpulse(i+7) = aPulse.pdfval[i];
+
+    for(int i=0; i<EcalPulseShape::TEMPLATESAMPLES;i++)
+    for(int j=0; j<EcalPulseShape::TEMPLATESAMPLES;j++)
+      fullpulsecov(i+7,j+7) = aPulseCov.covval[i][j];
+  }
+}
+
 EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::ParameterSet&ps,edm::ConsumesCollector& c) :
   EcalUncalibRecHitWorkerBaseClass(ps,c)
 {
@@ -49,6 +69,7 @@ EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::Para
 
   prefitMaxChiSqEB_ = ps.getParameter<double>("prefitMaxChiSqEB");
   prefitMaxChiSqEE_ = ps.getParameter<double>("prefitMaxChiSqEE");
+  batchPrefit_ = ps.getParameter<bool>("batchPrefit");
   
   dynamicPedestalsEB_ = ps.getParameter<bool>("dynamicPedestalsEB");
   dynamicPedestalsEE_ = ps.getParameter<bool>("dynamicPedestalsEE");
@@ -284,8 +305,45 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
     FullSampleVector fullpulse(FullSampleVector::Zero());
     FullSampleMatrix fullpulsecov(FullSampleMatrix::Zero());
 
+    // the one-pulse prefits are computed for all the crystals at once,
+    // before the loop that makes the rechits
+    const bool batchPrefit = batchPrefit_ && (barrel ? doPrefitEB_ : doPrefitEE_);
+    if (batchPrefit) {
+        prefitBatch_.clear();
+        prefitIndex_.assign(digis.size(), -1);
+        SampleVector amplitudes;
+        SampleMatrix noisecov;
+        unsigned int idg = 0;
+        for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idg) {
+            if ( lastSampleBeforeSaturation(*itdg) >= -1 ) continue;
+            DetId detid(itdg->id());
+            const EcalPedestals::Item * aped = nullptr;
+            const EcalMGPAGainRatio * aGain = nullptr;
+            const EcalPulseShapes::Item * aPulse = nullptr;
+            const EcalPulseCovariances::Item * aPulseCov = nullptr;
+            if (barrel) {
+                unsigned int hashedIndex = EBDetId(detid).hashedIndex();
+                aped       = &peds->barrel(hashedIndex);
+                aGain      = &gains->barrel(hashedIndex);
+                aPulse     = &pulseshapes->barrel(hashedIndex);
+                aPulseCov  = &pulsecovariances->barrel(hashedIndex);
+            } else {
+                unsigned int hashedIndex = EEDetId(detid).hashedIndex();
+                aped       = &peds->endcap(hashedIndex);
+                aGain      = &gains->endcap(hashedIndex);
+                aPulse     = &pulseshapes->endcap(hashedIndex);
+                aPulseCov  = &pulsecovariances->endcap(hashedIndex);
+            }
+            if (!multiFitMethod_.prefitInputs(*itdg, aped, aGain, noisecor(barrel), amplitudes, noisecov)) continue;
+            fillPulse(*aPulse, *aPulseCov, fullpulse, fullpulsecov);
+            prefitIndex_[idg] = prefitBatch_.add(amplitudes, noisecov, fullpulse, fullpulsecov);
+        }
+        prefitBatch_.fit();
+    }
+
     result.reserve(result.size() + digis.size());
-    for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg)
+    unsigned int idg = 0;
+    for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idg)
     {
         DetId detid(itdg->id());
 
@@ -322,12 +380,7 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
         double pedRMSVec[3]  = { aped->rms_x12,  aped->rms_x6,  aped->rms_x1 };
         double gainRatios[3] = { 1., aGain->gain12Over6(), aGain->gain6Over1()*aGain->gain12Over6()};
 
-        for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i)
-            fullpulse(i+7) = aPulse->pdfval[i];
-    
-        for(int i=0; i<EcalPulseShape::TEMPLATESAMPLES;i++)
-        for(int j=0; j<EcalPulseShape::TEMPLATESAMPLES;j++)
-            fullpulsecov(i+7,j+7) = aPulseCov->covval[i][j];
+        fillPulse(*aPulse, *aPulseCov, fullpulse, fullpulsecov);
         
 	// compute the right bin of the pulse shape using time calibration constants
 	EcalTimeCalibConstantMap::const_iterator it = itime->find( detid );
@@ -340,13 +393,7 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
             << "! something wrong with EcalTimeCalibConstants in your DB? ";
 	}
 
-        int lastSampleBeforeSaturation = -2;
-        for(unsigned int iSample = 0; iSample < EcalDataFrame::MAXSAMPLES; iSample++) {
-          if ( ((EcalDataFrame)(*itdg)).sample(iSample).gainId() == 0 ) {
-            lastSampleBeforeSaturation=iSample-1;
-            break;
-          }
-        }
+        int lastSampleBeforeSaturation = ::lastSampleBeforeSaturation(*itdg);
 
         // === amplitude computation ===
 
@@ -371,7 +418,15 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
             // multifit
             const SampleMatrixGainArray &noisecors = noisecor(barrel);
             
-            result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX));
+            EcalUncalibRecHitMultiFitAlgo::Prefit prefit;
+            const EcalUncalibRecHitMultiFitAlgo::Prefit * batchedPrefit = nullptr;
+            if (batchPrefit && prefitIndex_[idg]>=0 && prefitBatch_.status(prefitIndex_[idg])) {
+                prefit.amplitude = prefitBatch_.X(prefitIndex_[idg]);
+                prefit.chisq = prefitBatch_.ChiSq(prefitIndex_[idg]);
+                batchedPrefit = &prefit;
+            }
+            
+            result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX, batchedPrefit));
             auto & uncalibRecHit = result.back();
             
             // === time computation ===
@@ -557,6 +612,7 @@ EcalUncalibRecHitWorkerMultiFit::getAlgoDescription() {
 	      edm::ParameterDescription<bool>("doPrefitEE", false, true) and
 	      edm::ParameterDescription<double>("prefitMaxChiSqEB", 25., true) and
 	      edm::ParameterDescription<double>("prefitMaxChiSqEE", 10., true) and
+	      edm::ParameterDescription<bool>("batchPrefit", false, true) and
 	      edm::ParameterDescription<bool>("dynamicPedestalsEB", false, true) and
 	      edm::ParameterDescription<bool>("dynamicPedestalsEE", false, true) and
 	      edm::ParameterDescription<bool>("mitigateBadSamplesEB", false, true) and
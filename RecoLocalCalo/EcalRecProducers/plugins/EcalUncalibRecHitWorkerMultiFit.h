@@ -11,6 +11,7 @@
 
 #include "RecoLocalCalo/EcalRecProducers/interface/EcalUncalibRecHitWorkerBaseClass.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/EcalUncalibRecHitMultiFitAlgo.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqOnePulseBatch.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/EcalUncalibRecHitTimeWeightsAlgo.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/EcalUncalibRecHitRecChi2Algo.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/EcalUncalibRecHitRatioMethodAlgo.h"
@@ -69,6 +70,11 @@ class EcalUncalibRecHitWorkerMultiFit final : public EcalUncalibRecHitWorkerBase
                 bool ampErrorCalculation_;
                 bool useLumiInfoRunHeader_;
                 EcalUncalibRecHitMultiFitAlgo multiFitMethod_;
+
+                // one-pulse prefits of all the crystals of an event fitted together
+                bool batchPrefit_;
+                PulseChiSqOnePulseBatch prefitBatch_;
+                std::vector<int> prefitIndex_;
                 
 		int bunchSpacingManual_;
                 edm::EDGetTokenT<unsigned int> bunchSpacing_; 
@@ -19,6 +19,8 @@ ecalMultiFitUncalibRecHit = cms.EDProducer("EcalUncalibRecHitProducer",
       doPrefitEE = cms.bool(False),
       prefitMaxChiSqEB = cms.double(25.),
       prefitMaxChiSqEE = cms.double(10.),
+      # fit the prefits of all the crystals together (SIMD), same results to rounding
+      batchPrefit = cms.bool(False),
       
       dynamicPedestalsEB = cms.bool(False),
       dynamicPedestalsEE = cms.bool(False),
@@ -10,6 +10,75 @@
 //
 #include "DataFormats/CaloRecHit/interface/CaloID.h"
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+  // fixed grid of tiles over the x-y extent of the hits of a layer, about two hits per tile
+  class LayerTiles {
+  public:
+    template<typename Nodes>
+    explicit LayerTiles(const Nodes& nd) {
+      const unsigned int n = nd.size();
+      xmin_ = ymin_ = std::numeric_limits<double>::max();
+      double xmax = -xmin_, ymax = -ymin_;
+      for (auto const& node : nd) {
+        xmin_ = std::min(xmin_, node.data.x); xmax = std::max(xmax, node.data.x);
+        ymin_ = std::min(ymin_, node.data.y); ymax = std::max(ymax, node.data.y);
+      }
+      nx_ = ny_ = std::max(1, std::min(maxTilesPerSide, int(std::sqrt(0.5*n))));
+      sx_ = xmax > xmin_ ? (xmax - xmin_)/nx_ : 1.;
+      sy_ = ymax > ymin_ ? (ymax - ymin_)/ny_ : 1.;
+      minSize_ = std::min(sx_, sy_);
+
+      first_.assign(nx_*ny_ + 1, 0);
+      for (auto const& node : nd) ++first_[tile(node.data.x, node.data.y) + 1];
+      for (int t = 0; t < nx_*ny_; ++t) first_[t+1] += first_[t];
+      hits_.resize(n);
+      std::vector<unsigned int> fill(first_.begin(), first_.end() - 1);
+      for (unsigned int i = 0; i < n; ++i) hits_[fill[tile(nd[i].data.x, nd[i].data.y)]++] = i;
+    }
+
+    // calls f(j) for the hits in rings of tiles of increasing distance around (x, y),
+    // until the rings are farther than maxDist2 (which f may lower)
+    template<typename F>
+    void forEachAround(double x, double y, const double& maxDist2, F f) const {
+      const int cx = tileX(x), cy = tileY(y);
+      const int rmax = std::max(nx_, ny_);
+      for (int r = 0; r <= rmax; ++r) {
+        // the hits of ring r are more than r-1 tiles away, one tile of margin for the rounding of the tile index
+        if (r >= 2) {
+          const double lowerBound = (r-2)*minSize_;
+          if (lowerBound*lowerBound > maxDist2) break;
+        }
+        for (int iy = std::max(0, cy-r); iy <= std::min(ny_-1, cy+r); ++iy) {
+          const int step = (iy == cy-r || iy == cy+r) ? 1 : 2*r;
+          for (int ix = cx-r; ix <= cx+r; ix += step) {
+            if (ix < 0 || ix >= nx_) continue;
+            const int t = iy*nx_ + ix;
+            for (unsigned int k = first_[t]; k < first_[t+1]; ++k) f(hits_[k]);
+          }
+        }
+      }
+    }
+
+  private:
+    static constexpr int maxTilesPerSide = 256;
+
+    int tileX(double x) const { return std::min(nx_-1, std::max(0, int((x - xmin_)/sx_))); }
+    int tileY(double y) const { return std::min(ny_-1, std::max(0, int((y - ymin_)/sy_))); }
+    int tile(double x, double y) const { return tileY(y)*nx_ + tileX(x); }
+
+    double xmin_, ymin_, sx_, sy_, minSize_;
+    int nx_, ny_;
+    std::vector<unsigned int> first_;
+    std::vector<unsigned int> hits_;
+  };
+}
+
 void HGCalImagingAlgo::populate(const HGCRecHitCollection& hits){
   //loop over all hits and create the Hexel structure, skip energies below ecut
 
@@ -69,30 +138,48 @@ void HGCalImagingAlgo::populate(const HGCRecHitCollection& hits){
 void HGCalImagingAlgo::makeClusters()
 {
 
-  // used for speedy search
-  std::vector<KDTree> hit_kdtree(2*(maxlayer+1));
+  // the layers are independent, their clusters are appended in layer order afterwards
+  std::vector<std::vector<std::vector<KDNode> > > layerClusters(2*(maxlayer+1));
 
   //assign all hits in each layer to a cluster core or halo
-  for (unsigned int i = 0; i <= 2*maxlayer+1; ++i) {
+  auto clusterLayer = [&](unsigned int i) {
     KDTreeBox bounds(minpos[i][0],maxpos[i][0],
 		     minpos[i][1],maxpos[i][1]);
 
-    hit_kdtree[i].build(points[i],bounds);
+    // used for speedy search
+    KDTree hit_kdtree;
+    hit_kdtree.build(points[i],bounds);
 
     unsigned int actualLayer = i > maxlayer ? (i-(maxlayer+1)) : i; // maps back from index used for KD trees to actual layer
 
-    double maxdensity = calculateLocalDensity(points[i],hit_kdtree[i], actualLayer); // also stores rho (energy density) for each point (node)
+    double maxdensity = calculateLocalDensity(points[i],hit_kdtree, actualLayer); // also stores rho (energy density) for each point (node)
     // calculate distance to nearest point with higher density storing distance (delta) and point's index
     calculateDistanceToHigher(points[i]);
-    findAndAssignClusters(points[i],hit_kdtree[i],maxdensity,bounds,actualLayer);
+    findAndAssignClusters(points[i],hit_kdtree,maxdensity,bounds,actualLayer,layerClusters[i]);
+  };
+
+  if (verbosity < pINFO) {
+    for (unsigned int i = 0; i <= 2*maxlayer+1; ++i) clusterLayer(i);
+  } else {
+    tbb::parallel_for(0U, 2*maxlayer+2, clusterLayer);
   }
+
   //make the cluster vector
+  for (auto& clusters : layerClusters) {
+    if (verbosity < pINFO)
+      {
+	std::cout << "moving cluster offset by " << clusters.size() << std::endl;
+      }
+    for (auto& cluster : clusters) current_v.push_back(std::move(cluster));
+    cluster_offset += clusters.size();
+  }
 }
 
 std::vector<reco::BasicCluster> HGCalImagingAlgo::getClusters(bool doSharing){
 
   reco::CaloID caloID = reco::CaloID::DET_HGCAL_ENDCAP;
   std::vector< std::pair<DetId, float> > thisCluster;
+  std::vector<std::vector<double> > fractions; // reused by all the clusters
   for (unsigned int i = 0; i < current_v.size(); ++i){
     double energy = 0;
     Point position;
@@ -102,7 +189,6 @@ std::vector<reco::BasicCluster> HGCalImagingAlgo::getClusters(bool doSharing){
       std::vector<unsigned> seeds = findLocalMaximaInCluster(current_v[i]);
       // sharing found seeds.size() sub-cluster seeds in cluster i
 
-      std::vector<std::vector<double> > fractions;
       // first pass can have noise it in
       shareEnergy(current_v[i],seeds,fractions);
 
@@ -262,32 +348,43 @@ double HGCalImagingAlgo::calculateDistanceToHigher(std::vector<KDNode> &nd){
   const double max_dist2 = dist2;
   const unsigned int nd_size = nd.size();
 
+  // position of each hit in the density ordering
+  std::vector<unsigned int> rank(nd_size);
+  for(unsigned int oi = 0; oi < nd_size; ++oi) rank[rs[oi]] = oi;
+  const LayerTiles tiles(nd);
+
   for(unsigned int oi = 1; oi < nd_size; ++oi){ // start from second-highest density
     dist2 = max_dist2;
     unsigned int i = rs[oi];
-    // we only need to check up to oi since hits
+    // we only need to check the hits before oi since hits
     // are ordered by decreasing density
     // and all points coming BEFORE oi are guaranteed to have higher rho
-    // and the ones AFTER to have lower rho
-    for(unsigned int oj = 0; oj < oi; ++oj){
-      unsigned int j = rs[oj];
-      double tmp = distance2(nd[i].data, nd[j].data);
-      if(tmp <= dist2){ //this "<=" instead of "<" addresses the (rare) case when there are only two hits
-	    dist2 = tmp;
-	    nearestHigher = j;
-      }
-    }
+    // and the ones AFTER to have lower rho.
+    // The closest of them is searched in the tiles around the hit; for equal
+    // distances the last in density order is kept, as with a loop over oj < oi
+    // and "<=" (which addresses the (rare) case when there are only two hits)
+    int nearestRank = -1;
+    tiles.forEachAround(nd[i].data.x, nd[i].data.y, dist2, [&](unsigned int j) {
+	if(rank[j] >= oi) return;
+	double tmp = distance2(nd[i].data, nd[j].data);
+	if(tmp < dist2 || (tmp == dist2 && int(rank[j]) > nearestRank)){
+	  dist2 = tmp;
+	  nearestRank = rank[j];
+	}
+      });
+    if(nearestRank >= 0) nearestHigher = rs[nearestRank];
     nd[i].data.delta = std::sqrt(dist2);
     nd[i].data.nearestHigher = nearestHigher; //this uses the original unsorted hitlist
   }
   return maxdensity;
 }
 
-int HGCalImagingAlgo::findAndAssignClusters(std::vector<KDNode> &nd,KDTree &lp, double maxdensity, KDTreeBox &bounds, const unsigned int layer){
+int HGCalImagingAlgo::findAndAssignClusters(std::vector<KDNode> &nd,KDTree &lp, double maxdensity, KDTreeBox &bounds, const unsigned int layer,
+					    std::vector<std::vector<KDNode> > &clustersOnLayer){
 
   //this is called once per layer and endcap...
-  //so when filling the cluster temporary vector of Hexels we resize each time by the number
-  //of clusters found. This is always equal to the number of cluster centers...
+  //so the clusters of the layer are filled in their own vector of vectors of Hexels,
+  //sized by the number of clusters found. This is always equal to the number of cluster centers...
 
   unsigned int clusterIndex = 0;
   float delta_c; // critical distance
@@ -315,7 +412,7 @@ int HGCalImagingAlgo::findAndAssignClusters(std::vector<KDNode> &nd,KDTree &lp,
     nd[ds[i]].data.clusterIndex = clusterIndex;
     if (verbosity < pINFO)
       {
-	    std::cout << "Adding new cluster with index " << clusterIndex+cluster_offset << std::endl;
+	    std::cout << "Adding new cluster with index " << clusterIndex << " on layer " << layer << std::endl;
 	    std::cout << "Cluster center is hit " << ds[i] << std::endl;
       }
     clusterIndex++;
@@ -335,13 +432,12 @@ int HGCalImagingAlgo::findAndAssignClusters(std::vector<KDNode> &nd,KDTree &lp,
     }
   }
 
-  //make room in the temporary cluster vector for the additional clusterIndex clusters
-  // from this layer
+  //make room in the cluster vector of this layer for its clusterIndex clusters
   if (verbosity < pINFO)
     {
       std::cout << "resizing cluster vector by "<< clusterIndex << std::endl;
     }
-  current_v.resize(cluster_offset+clusterIndex);
+  clustersOnLayer.resize(clusterIndex);
 
   //assign points closer than dc to other clusters to border region
   //and find critical border density
@@ -389,21 +485,15 @@ int HGCalImagingAlgo::findAndAssignClusters(std::vector<KDNode> &nd,KDTree &lp,
     int ci = nd[i].data.clusterIndex;
     if(ci!=-1) {
       if (nd[i].data.rho <= rho_b[ci]) nd[i].data.isHalo = true;
-      current_v[ci+cluster_offset].push_back(nd[i]);
+      clustersOnLayer[ci].push_back(nd[i]);
       if (verbosity < pINFO)
 	  {
-	    std::cout << "Pushing hit " << i << " into cluster with index " << ci+cluster_offset << std::endl;
-	    std::cout << "Size now " << current_v[ci+cluster_offset].size() << std::endl;
+	    std::cout << "Pushing hit " << i << " into cluster with index " << ci << " on layer " << layer << std::endl;
+	    std::cout << "Size now " << clustersOnLayer[ci].size() << std::endl;
 	  }
     }
   }
 
-  //prepare the offset for the next layer if there is one
-  if (verbosity < pINFO)
-    {
-      std::cout << "moving cluster offset by " << clusterIndex << std::endl;
-    }
-  cluster_offset += clusterIndex;
   return clusterIndex;
 }
 
@@ -465,14 +555,13 @@ void HGCalImagingAlgo::shareEnergy(const std::vector<KDNode>& incluster,
 				   const std::vector<unsigned>& seeds,
 				   std::vector<std::vector<double> >& outclusters) {
   std::vector<bool> isaseed(incluster.size(),false);
-  outclusters.clear();
+  // the inner vectors keep their capacity from the previous clusters
   outclusters.resize(seeds.size());
   std::vector<Point> centroids(seeds.size());
   std::vector<double> energies(seeds.size());
 
   if( seeds.size() == 1 ) { // short circuit the case of a lone cluster
-    outclusters[0].clear();
-    outclusters[0].resize(incluster.size(),1.0);
+    outclusters[0].assign(incluster.size(),1.0);
     return;
   }
 
@@ -488,7 +577,7 @@ void HGCalImagingAlgo::shareEnergy(const std::vector<KDNode>& incluster,
   // seeds always have fraction 1.0, to stabilize fit
   // initializing fit
   for( unsigned i = 0; i < seeds.size(); ++i ) {
-    outclusters[i].resize(incluster.size(),0.0);
+    outclusters[i].assign(incluster.size(),0.0);
     for( unsigned j = 0; j < incluster.size(); ++j ) {
       if( j == seeds[i] ) {
 	outclusters[i][j] = 1.0;
@@ -12,7 +12,9 @@
 #include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
 #include "RecoLocalCalo/HcalRecAlgos/interface/PulseShapeFunctor.h"
 
-#include <Math/Functor.h>
+#include <array>
+#include <memory>
+#include <vector>
 
 struct MahiNnlsWorkspace {
 
@@ -81,6 +83,23 @@ struct MahiNnlsWorkspace {
 
 };
 
+// pulse shape functor of one pulse shape and the pulses it already returned,
+// keyed by the exact pulse time (direct-mapped)
+struct MahiPulseTemplates {
+
+  static constexpr unsigned int nCached = 64;
+
+  MahiPulseTemplates(const HcalPulseShapes::Shape& ps);
+
+  void getPulseShape(double t0, std::array<double, MaxSVSize>& pulse);
+
+  const HcalPulseShapes::Shape* shape;
+  std::unique_ptr<FitterFuncs::PulseShapeFunctor> psf;
+
+  std::array<double, nCached> times;
+  std::array<std::array<double, MaxSVSize>, nCached> pulses;
+};
+
 class MahiFit
 {
  public:
@@ -160,10 +179,10 @@ class MahiFit
   unsigned int bxSizeConf_;
   int bxOffsetConf_;
 
-  //for pulse shapes
+  //for pulse shapes, one entry per pulse shape seen
   int cntsetPulseShape_;
-  std::unique_ptr<FitterFuncs::PulseShapeFunctor> psfPtr_;
-  std::unique_ptr<ROOT::Math::Functor> pfunctor_;
+  std::vector<std::unique_ptr<MahiPulseTemplates> > pulseTemplates_;
+  MahiPulseTemplates* currentTemplates_=nullptr;
 
 }; 
 #endif
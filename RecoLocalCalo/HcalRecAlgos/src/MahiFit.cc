@@ -1,10 +1,47 @@
 #include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h" 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+MahiPulseTemplates::MahiPulseTemplates(const HcalPulseShapes::Shape& ps) :
+  shape(&ps),
+  // only the pulse shape itself from PulseShapeFunctor is used for Mahi
+  // the uncertainty terms calculated inside PulseShapeFunctor are used for Method 2 only
+  psf(new FitterFuncs::PulseShapeFunctor(ps,false,false,false,false,
+					 1,0,2.5,0,0.00065,1,10))
+{
+  times.fill(std::numeric_limits<double>::quiet_NaN());
+}
+
+void MahiPulseTemplates::getPulseShape(double t0, std::array<double, MaxSVSize>& pulse) {
+
+  uint64_t bits;
+  std::memcpy(&bits, &t0, sizeof(bits));
+  const unsigned int slot = ((bits ^ (bits >> 32)) * 0x9E3779B97F4A7C15ULL) >> 58;
+
+  if (times[slot] != t0) {
+    const double xx[4]={t0, 1.0, 0.0, 3};
+    psf->singlePulseShapeFunc(&xx[0]);
+    psf->getPulseShape(pulses[slot]);
+    times[slot] = t0;
+  }
+  pulse = pulses[slot];
+}
+
 MahiFit::MahiFit() :
   fullTSSize_(19), 
   fullTSofInterest_(8)
-{}
+{
+  // entries beyond the pulses of a fit are never written, the others are
+  // set by doFit before they are used
+  std::fill(std::begin(nnlsWork_.pulseCovArray), std::end(nnlsWork_.pulseCovArray), FullSampleMatrix::Zero());
+  std::fill(std::begin(nnlsWork_.pulseShapeArray), std::end(nnlsWork_.pulseShapeArray), FullSampleVector::Zero());
+  std::fill(std::begin(nnlsWork_.pulseDerivArray), std::end(nnlsWork_.pulseDerivArray), FullSampleVector::Zero());
+}
 
 double MahiFit::getSiPMDarkCurrent(double darkCurrent, double fcByPE, double lambda) const {
   double mu = darkCurrent * 25 / fcByPE;
@@ -281,21 +318,12 @@ void MahiFit::updatePulseShape(double itQ, FullSampleVector &pulseShape, FullSam
   nnlsWork_.pulseM.fill(0);
   nnlsWork_.pulseP.fill(0);
 
-  const double xx[4]={t0, 1.0, 0.0, 3};
-  const double xxm[4]={-nnlsWork_.dt+t0, 1.0, 0.0, 3};
-  const double xxp[4]={ nnlsWork_.dt+t0, 1.0, 0.0, 3};
-
-  (*pfunctor_)(&xx[0]);
-  psfPtr_->getPulseShape(nnlsWork_.pulseN);
-
-  (*pfunctor_)(&xxm[0]);
-  psfPtr_->getPulseShape(nnlsWork_.pulseM);
-  
-  (*pfunctor_)(&xxp[0]);
-  psfPtr_->getPulseShape(nnlsWork_.pulseP);
+  currentTemplates_->getPulseShape(t0, nnlsWork_.pulseN);
+  currentTemplates_->getPulseShape(-nnlsWork_.dt+t0, nnlsWork_.pulseM);
+  currentTemplates_->getPulseShape( nnlsWork_.dt+t0, nnlsWork_.pulseP);
 
   //in the 2018+ case where the sample of interest (SOI) is in TS3, add an extra offset to align 
-  //with previous SOI=TS4 case assumed by psfPtr_->getPulseShape()
+  //with previous SOI=TS4 case assumed by PulseShapeFunctor::getPulseShape()
   int delta =nnlsWork_. tsOffset == 3 ? 1 : 0;
 
   for (unsigned int iTS=nnlsWork_.fullTSOffset; iTS<nnlsWork_.fullTSOffset + nnlsWork_.tsSize; iTS++) {
@@ -488,7 +516,11 @@ void MahiFit::setPulseShapeTemplate(const HcalPulseShapes::Shape& ps) {
 
   if (!(&ps == currentPulseShape_ ))
     {
-      resetPulseShapeTemplate(ps);
+      // the channels alternate between a few pulse shapes, keep their templates
+      auto it = std::find_if(pulseTemplates_.begin(), pulseTemplates_.end(),
+			     [&ps](const std::unique_ptr<MahiPulseTemplates>& t) { return t->shape == &ps; });
+      if (it == pulseTemplates_.end()) resetPulseShapeTemplate(ps);
+      else currentTemplates_ = it->get();
       currentPulseShape_ = &ps;
     }
 }
@@ -496,11 +528,13 @@ void MahiFit::setPulseShapeTemplate(const HcalPulseShapes::Shape& ps) {
 void MahiFit::resetPulseShapeTemplate(const HcalPulseShapes::Shape& ps) { 
   ++ cntsetPulseShape_;
 
-  // only the pulse shape itself from PulseShapeFunctor is used for Mahi
-  // the uncertainty terms calculated inside PulseShapeFunctor are used for Method 2 only
-  psfPtr_.reset(new FitterFuncs::PulseShapeFunctor(ps,false,false,false,false,
-						   1,0,2.5,0,0.00065,1,10));
-  pfunctor_ = std::unique_ptr<ROOT::Math::Functor>( new ROOT::Math::Functor(psfPtr_.get(),&FitterFuncs::PulseShapeFunctor::singlePulseShapeFunc, 3) );
+  auto templates = std::make_unique<MahiPulseTemplates>(ps);
+  currentTemplates_ = templates.get();
+
+  auto it = std::find_if(pulseTemplates_.begin(), pulseTemplates_.end(),
+			 [&ps](const std::unique_ptr<MahiPulseTemplates>& t) { return t->shape == &ps; });
+  if (it == pulseTemplates_.end()) pulseTemplates_.push_back(std::move(templates));
+  else *it = std::move(templates);
 
 }
 
@@ -603,10 +637,6 @@ void MahiFit::resetWorkspace() const {
   nnlsWork_.bxOffset=0;
   nnlsWork_.dt=0;
 
-  std::fill(std::begin(nnlsWork_.pulseCovArray), std::end(nnlsWork_.pulseCovArray), FullSampleMatrix::Zero());
-  std::fill(std::begin(nnlsWork_.pulseShapeArray), std::end(nnlsWork_.pulseShapeArray), FullSampleVector::Zero());
-  std::fill(std::begin(nnlsWork_.pulseDerivArray), std::end(nnlsWork_.pulseDerivArray), FullSampleVector::Zero());
-
   std::fill(std::begin(nnlsWork_.pulseN), std::end(nnlsWork_.pulseN), 0);
   std::fill(std::begin(nnlsWork_.pulseM), std::end(nnlsWork_.pulseM), 0);
   std::fill(std::begin(nnlsWork_.pulseP), std::end(nnlsWork_.pulseP), 0);
@@ -13,6 +13,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -534,11 +535,39 @@ bool CSCSegAlgoRU::addHit(AlgoState& aState, const CSCRecHit2D* aHit, int layer)
 
 void CSCSegAlgoRU::updateParameters(AlgoState& aState) const {
   // Delete input CSCSegFit, create a new one and make the fit
-  // delete sfit;
-  aState.sfit.reset(new CSCSegFit( aState.aChamber, aState.proto_segment ));
+  // (starting from the input one, whose hits are mostly the same)
+  if ( aState.sfit )
+    aState.sfit.reset(new CSCSegFit( *aState.sfit, aState.proto_segment ));
+  else
+    aState.sfit.reset(new CSCSegFit( aState.aChamber, aState.proto_segment ));
   aState.sfit->fit();
+#ifdef EDM_ML_DEBUG
+  checkFit(aState);
+#endif
 }
 
+#ifdef EDM_ML_DEBUG
+void CSCSegAlgoRU::checkFit(const AlgoState& aState) const {
+  // The fit started from the previous one must be the fit of proto_segment
+  // from scratch, bit for bit
+  CSCSegFit refit( aState.aChamber, aState.proto_segment );
+  refit.fit();
+  const CSCSegFit& sfit = *aState.sfit;
+  bool same = ( sfit.hits() == aState.proto_segment && sfit.fitdone() == refit.fitdone() );
+  if ( same && refit.fitdone() )
+    same = ( sfit.chi2() == refit.chi2() && sfit.ndof() == refit.ndof() &&
+	     sfit.intercept().x() == refit.intercept().x() && sfit.intercept().y() == refit.intercept().y() &&
+	     sfit.localdir().x() == refit.localdir().x() && sfit.localdir().y() == refit.localdir().y() &&
+	     sfit.localdir().z() == refit.localdir().z() );
+  if ( !same )
+    edm::LogError("CSCSegAlgoRU") << "[CSCSegAlgoRU::checkFit] fit of " << sfit.nhits() << " hits differs from the refit of "
+				  << aState.proto_segment.size() << " hits: chi2 " << sfit.chi2() << " vs " << refit.chi2()
+				  << ", intercept " << sfit.intercept() << " vs " << refit.intercept()
+				  << ", direction " << sfit.localdir() << " vs " << refit.localdir();
+  assert( same );
+}
+#endif
+
 float CSCSegAlgoRU::fit_r_phi(const AlgoState& aState, const SVector6& points, int layer) const{
   //find R or Phi on the given layer using the given points for the interpolation
   float Sx = 0;
@@ -790,15 +819,16 @@ bool CSCSegAlgoRU::replaceHit(AlgoState& aState, const CSCRecHit2D* h, int layer
 }
 
 void CSCSegAlgoRU::compareProtoSegment(AlgoState& aState, const CSCRecHit2D* h, int layer) const {
-  // Copy the input CSCSegFit
-  std::unique_ptr<CSCSegFit> oldfit;
-  oldfit.reset(new CSCSegFit( aState.aChamber, aState.proto_segment ));
-  oldfit->fit();
+  // Copy the input CSCSegFit (it is the fit of proto_segment)
+#ifdef EDM_ML_DEBUG
+  checkFit(aState);
+#endif
+  std::unique_ptr<CSCSegFit> oldfit(new CSCSegFit( *aState.sfit ));
   ChamberHitContainer oldproto = aState.proto_segment;
   
   // May create a new fit
   bool ok = replaceHit(aState, h, layer);
-  if ( (aState.sfit->chi2() >= oldfit->chi2() ) || !ok ) {
+  if ( !ok || (aState.sfit->chi2() >= oldfit->chi2() ) ) {
     // keep original fit
     aState.proto_segment = oldproto;
     aState.sfit = std::move(oldfit); // reset to the original input fit
@@ -806,11 +836,12 @@ void CSCSegAlgoRU::compareProtoSegment(AlgoState& aState, const CSCRecHit2D* h,
 }
 
 void CSCSegAlgoRU::increaseProtoSegment(AlgoState& aState, const CSCRecHit2D* h, int layer, int chi2_factor) const {
-  // Creates a new fit
-  std::unique_ptr<CSCSegFit> oldfit;
+  // Creates a new fit (the input CSCSegFit is the fit of proto_segment)
+#ifdef EDM_ML_DEBUG
+  checkFit(aState);
+#endif
   ChamberHitContainer oldproto = aState.proto_segment;
-  oldfit.reset(new CSCSegFit( aState.aChamber, aState.proto_segment ));
-  oldfit->fit();
+  std::unique_ptr<CSCSegFit> oldfit(new CSCSegFit( *aState.sfit ));
 
   bool ok = addHit(aState, h, layer);
   //@@ TEST ON ndof<=0 IS JUST TO ACCEPT nhits=2 CASE??
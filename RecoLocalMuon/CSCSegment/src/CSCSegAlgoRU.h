@@ -127,6 +127,9 @@ private:
     /// Utility functions 	
     bool addHit(AlgoState& aState, const CSCRecHit2D* hit, int layer) const;
     void updateParameters(AlgoState& aState) const;
+#ifdef EDM_ML_DEBUG
+    void checkFit(const AlgoState& aState) const; // assert that sfit is the fit of proto_segment from scratch
+#endif
     float fit_r_phi(const AlgoState& aState, const SVector6& points, int layer) const;
     float fitX(const AlgoState& aState, SVector6 points, SVector6 errors, int ir, int ir2, float &chi2_str) const;
     void baseline(AlgoState& aState, int n_seg_min) const;//function for arasing bad hits in case of bad chi2/NDOF 
@@ -10,6 +10,33 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <algorithm>
+
+
+CSCSegFit::CSCSegFit( const CSCSegFit& previous, CSCSetOfHits hits) :
+  chamber_( previous.chamber() ), hits_( hits ), scaleXError_( 1.0 ), fitdone_( false ), nsummed_( 0 ) {
+
+  if ( hits_.size() > localHits_.size() ) return; // won't be fitted
+
+  for (size_t i = 0; i != hits_.size(); ++i) {
+    for (size_t j = 0; j != previous.hits_.size() && j != localHits_.size(); ++j) {
+      if ( previous.hits_[j] == hits_[i] && previous.localHits_[j].hit == hits_[i] ) {
+        localHits_[i] = previous.localHits_[j];
+        break;
+      }
+    }
+  }
+
+  // the sums are only reused as they are: summing in the same order as
+  // from scratch gives exactly the same fit
+  if ( previous.nsummed_ <= hits_.size() &&
+       std::equal( hits_.begin(), hits_.begin() + previous.nsummed_, previous.hits_.begin() ) ) {
+    M_ = previous.M_;
+    B_ = previous.B_;
+    nsummed_ = previous.nsummed_;
+  }
+}
+
 
 void CSCSegFit::fit(void) {
   if ( fitdone() ) return; // don't redo fit unnecessarily
@@ -62,6 +89,10 @@ void CSCSegFit::fit2(void) {
   // We want hit wrt chamber (and local z will be != 0)
   LocalPoint h1pos = chamber()->toLocal(h1glopos);  
   LocalPoint h2pos = chamber()->toLocal(h2glopos);  
+
+  // keep them for a fit with more hits
+  setLocalHit( 0, h1pos );
+  setLocalHit( 1, h2pos );
     
   float dz = h2pos.z()-h1pos.z();
 
@@ -152,64 +183,21 @@ void CSCSegFit::fitlsq(void) {
   // the LAYER, so we must explicitly transform global position.
   
 
-  SMatrix4 M; // 4x4, init to 0
-  SVector4 B; // 4x1, init to 0; 
+  // The positions and inverted covariance matrices of hits shared with an
+  // earlier fit are already known, as are the sums over its first hits.
 
-  CSCSetOfHits::const_iterator ih = hits_.begin();
-  
-  for (ih = hits_.begin(); ih != hits_.end(); ++ih) {
-    const CSCRecHit2D& hit = (**ih);
+  for (size_t i = 0; i != hits_.size(); ++i) {
+    if ( localHits_[i].hit == hits_[i] ) continue;
+    const CSCRecHit2D& hit = *hits_[i];
     const CSCLayer* layer  = chamber()->layer(hit.cscDetId().layer());
     GlobalPoint gp         = layer->toGlobal(hit.localPosition());
-    LocalPoint  lp         = chamber()->toLocal(gp); 
-    
-    // Local position of hit w.r.t. chamber
-    double u = lp.x();
-    double v = lp.y();
-    double z = lp.z();
-    
-    // Covariance matrix of local errors 
-    SMatrixSym2 IC; // 2x2, init to 0
-    
-    IC(0,0) = hit.localPositionError().xx();
-    IC(1,1) = hit.localPositionError().yy();
-    //@@ NOT SURE WHICH OFF-DIAGONAL ELEMENT MUST BE DEFINED BUT (1,0) WORKS
-    //@@ (and SMatrix enforces symmetry)
-    IC(1,0) = hit.localPositionError().xy();
-    // IC(0,1) = IC(1,0);
-    
-    // Invert covariance matrix (and trap if it fails!)
-    bool ok = IC.Invert();
-    if ( !ok ) {
-      edm::LogVerbatim("CSCSegment|CSCSegFit") << "[CSCSegFit::fit] Failed to invert covariance matrix: \n" << IC;      
-      //      return ok;  //@@ SHOULD PASS THIS BACK TO CALLER?
-    }
+    setLocalHit( i, chamber()->toLocal(gp) );
+  }
 
-    M(0,0) += IC(0,0);
-    M(0,1) += IC(0,1);
-    M(0,2) += IC(0,0) * z;
-    M(0,3) += IC(0,1) * z;
-    B(0)   += u * IC(0,0) + v * IC(0,1);
- 
-    M(1,0) += IC(1,0);
-    M(1,1) += IC(1,1);
-    M(1,2) += IC(1,0) * z;
-    M(1,3) += IC(1,1) * z;
-    B(1)   += u * IC(1,0) + v * IC(1,1);
- 
-    M(2,0) += IC(0,0) * z;
-    M(2,1) += IC(0,1) * z;
-    M(2,2) += IC(0,0) * z * z;
-    M(2,3) += IC(0,1) * z * z;
-    B(2)   += ( u * IC(0,0) + v * IC(0,1) ) * z;
- 
-    M(3,0) += IC(1,0) * z;
-    M(3,1) += IC(1,1) * z;
-    M(3,2) += IC(1,0) * z * z;
-    M(3,3) += IC(1,1) * z * z;
-    B(3)   += ( u * IC(1,0) + v * IC(1,1) ) * z;
+  for ( ; nsummed_ != hits_.size(); ++nsummed_ ) addToNormalEquations( nsummed_ );
 
-  }
+  SMatrix4 M = M_; // 4x4
+  SVector4 B = B_; // 4x1
 
   SVector4 p;
   bool ok = M.Invert();
@@ -247,40 +235,17 @@ void CSCSegFit::setChi2(void) {
   
   double chsq = 0.;
 
-  CSCSetOfHits::const_iterator ih;
-  for (ih = hits_.begin(); ih != hits_.end(); ++ih) {
+  for (size_t i = 0; i != hits_.size(); ++i) {
 
-    const CSCRecHit2D& hit = (**ih);
-    const CSCLayer* layer  = chamber()->layer(hit.cscDetId().layer());
-    GlobalPoint gp         = layer->toGlobal(hit.localPosition());
-    LocalPoint lp          = chamber()->toLocal(gp);
+    // local position w.r.t. chamber and inverted covariance matrix, from fitlsq
+    const LocalHit& lh = localHits_[i];
     
-    double u = lp.x();
-    double v = lp.y();
-    double z = lp.z();
+    double du = intercept_.x() + uslope_ * lh.z - lh.u;
+    double dv = intercept_.y() + vslope_ * lh.z - lh.v;
     
-    double du = intercept_.x() + uslope_ * z - u;
-    double dv = intercept_.y() + vslope_ * z - v;
-    
-    //    LogTrace("CSCSegFit") << "[CSCSegFit::setChi2] u, v, z = " << u << ", " << v << ", " << z;
-
-    SMatrixSym2 IC; // 2x2, init to 0
-
-    IC(0,0) = hit.localPositionError().xx();
-    //    IC(0,1) = hit.localPositionError().xy();
-    IC(1,0) = hit.localPositionError().xy();
-    IC(1,1) = hit.localPositionError().yy();
-    //    IC(1,0) = IC(0,1);
-
-    //    LogTrace("CSCSegFit") << "[CSCSegFit::setChi2] IC before = \n" << IC;
+    //    LogTrace("CSCSegFit") << "[CSCSegFit::setChi2] u, v, z = " << lh.u << ", " << lh.v << ", " << lh.z;
 
-    // Invert covariance matrix
-    bool ok = IC.Invert();
-    if (!ok ){
-      edm::LogVerbatim("CSCSegment|CSCSegFit") << "[CSCSegFit::setChi2] Failed to invert covariance matrix: \n" << IC;
-      //      return ok;
-    }
-    //    LogTrace("CSCSegFit") << "[CSCSegFit::setChi2] IC after = \n" << IC;
+    const SMatrixSym2& IC = lh.IC;
     chsq += du*du*IC(0,0) + 2.*du*dv*IC(0,1) + dv*dv*IC(1,1);
   }
   
@@ -293,6 +258,76 @@ void CSCSegFit::setChi2(void) {
 }
 
 
+void CSCSegFit::setLocalHit(size_t i, const LocalPoint& lp) {
+
+  const CSCRecHit2D& hit = *hits_[i];
+  LocalHit& lh = localHits_[i];
+
+  // Local position of hit w.r.t. chamber
+  lh.u = lp.x();
+  lh.v = lp.y();
+  lh.z = lp.z();
+
+  // Covariance matrix of local errors 
+  SMatrixSym2& IC = lh.IC;
+  IC = SMatrixSym2(); // 2x2, init to 0
+
+  IC(0,0) = hit.localPositionError().xx();
+  IC(1,1) = hit.localPositionError().yy();
+  //@@ NOT SURE WHICH OFF-DIAGONAL ELEMENT MUST BE DEFINED BUT (1,0) WORKS
+  //@@ (and SMatrix enforces symmetry)
+  IC(1,0) = hit.localPositionError().xy();
+  // IC(0,1) = IC(1,0);
+
+  // Invert covariance matrix (and trap if it fails!)
+  bool ok = IC.Invert();
+  if ( !ok ) {
+    edm::LogVerbatim("CSCSegment|CSCSegFit") << "[CSCSegFit::fit] Failed to invert covariance matrix: \n" << IC;      
+    //      return ok;  //@@ SHOULD PASS THIS BACK TO CALLER?
+  }
+
+  lh.hit = hits_[i];
+}
+
+
+void CSCSegFit::addToNormalEquations(size_t i) {
+
+  // Contribution of one hit to M and B, see fitlsq
+
+  const LocalHit& lh = localHits_[i];
+  const double u = lh.u;
+  const double v = lh.v;
+  const double z = lh.z;
+  const SMatrixSym2& IC = lh.IC;
+  SMatrix4& M = M_;
+  SVector4& B = B_;
+
+  M(0,0) += IC(0,0);
+  M(0,1) += IC(0,1);
+  M(0,2) += IC(0,0) * z;
+  M(0,3) += IC(0,1) * z;
+  B(0)   += u * IC(0,0) + v * IC(0,1);
+ 
+  M(1,0) += IC(1,0);
+  M(1,1) += IC(1,1);
+  M(1,2) += IC(1,0) * z;
+  M(1,3) += IC(1,1) * z;
+  B(1)   += u * IC(1,0) + v * IC(1,1);
+ 
+  M(2,0) += IC(0,0) * z;
+  M(2,1) += IC(0,1) * z;
+  M(2,2) += IC(0,0) * z * z;
+  M(2,3) += IC(0,1) * z * z;
+  B(2)   += ( u * IC(0,0) + v * IC(0,1) ) * z;
+ 
+  M(3,0) += IC(1,0) * z;
+  M(3,1) += IC(1,1) * z;
+  M(3,2) += IC(1,0) * z * z;
+  M(3,3) += IC(1,1) * z * z;
+  B(3)   += ( u * IC(1,0) + v * IC(1,1) ) * z;
+}
+
+
 
 
 CSCSegFit::SMatrixSym12 CSCSegFit::weightMatrix() {
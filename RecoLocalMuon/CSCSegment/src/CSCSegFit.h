@@ -14,6 +14,8 @@
  * a maximum of 6, one per layer of a CSC. This means maximum dimensions
  * can be specified at compile time and hence satisfies SMatrix constraints.
  * For 2 hits of course there is no fit - just draw a straight line between them.
+ * A fit can be started from an earlier one sharing hits, e.g. with one hit added,
+ * to skip the transformation of their positions and the sums already done.
  * Details of the algorithm are in the .cc file
  *
  */
@@ -25,6 +27,7 @@
 #include <Math/SVector.h>
 #include <Math/SMatrix.h>
 
+#include <array>
 #include <vector>
 
 class CSCSegFit {
@@ -56,7 +59,13 @@ public:
 
   //@@ WANT OBJECT TO CACHE THE SET OF HITS SO CANNOT PASS BY REF
   CSCSegFit( const CSCChamber* csc, CSCSetOfHits hits) : 
-  chamber_( csc ), hits_( hits ), scaleXError_( 1.0 ), fitdone_( false ) {}
+  chamber_( csc ), hits_( hits ), scaleXError_( 1.0 ), fitdone_( false ), nsummed_( 0 ) {}
+
+  // Fit to hits sharing hits with an earlier fit in the same chamber:
+  // the positions w.r.t. the chamber of the common hits are taken from it,
+  // and so are its normal equations if the new hits start with its hits
+  // (e.g. a hit was added). The results are the same as fitting from scratch.
+  CSCSegFit( const CSCSegFit& previous, CSCSetOfHits hits);
 
   virtual ~CSCSegFit() {}
 
@@ -96,6 +105,16 @@ public:
   void fit2(void); // fit for 2 hits
   void fitlsq(void); // least-squares fit for 3-6 hits  
   void setChi2(void); // fill chi2_ & ndof_ @@ FKA fillChiSquared()
+  void setLocalHit(size_t i, const LocalPoint& lp); // fill localHits_[i] from hit i at lp w.r.t. chamber
+  void addToNormalEquations(size_t i); // add localHits_[i] to M_ & B_
+
+  // Hit position w.r.t. the chamber and inverse of its covariance matrix,
+  // the per-hit input of the fit, kept to be reused by later fits
+  struct LocalHit {
+    const CSCRecHit2D* hit = nullptr; // entry is valid if it is the hit at the same index in hits_
+    double u, v, z;
+    SMatrixSym2 IC;
+  };
 
 
  protected:
@@ -121,6 +140,15 @@ public:
   int         ndof_;      //@@ FKA protoNDF, which was double!!
   double      scaleXError_;
   bool        fitdone_;  
+
+ private:
+
+  // PRIVATE MEMBER VARIABLES - cache for the incremental fits
+
+  std::array<LocalHit, 6> localHits_;
+  SMatrix4    M_;         // normal equations M p = B, summed over the first nsummed_ hits
+  SVector4    B_;
+  size_t      nsummed_;
 };
   
 #endif
@@ -0,0 +1,85 @@
+## Process sim digi events with CSC rechit & segment builders
+## Runs the RU algo on a 25ns PU TTbar sample (busy chambers) to check and time
+## the incremental CSCSegFit fits of CSCSegAlgoRU.
+##
+## To check every fit against the fit of the same hits from scratch (the job
+## stops at the first difference), compile the package with
+## scram b -j8 USER_CXXFLAGS="-DEDM_ML_DEBUG"
+## Without it, the Timing service gives the time per event of cscSegments.
+
+import FWCore.ParameterSet.Config as cms
+from Configuration.AlCa.autoCond import autoCond
+
+process = cms.Process("TEST")
+
+## Accesses both Reco & Sim geometries from database
+process.load("Configuration.StandardSequences.GeometryDB_cff")
+
+## Use the magic of autoCond instead of an explicit global tag
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+process.GlobalTag.globaltag = autoCond["run2_mc"]
+
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+process.load("Configuration.StandardSequences.EndOfProcess_cff")
+
+## Explicit configuration of CSC for postls1 = run2
+process.load("CalibMuon.CSCCalibration.CSCChannelMapper_cfi")
+process.load("CalibMuon.CSCCalibration.CSCIndexer_cfi")
+process.CSCIndexerESProducer.AlgoName = cms.string("CSCIndexerPostls1")
+process.CSCChannelMapperESProducer.AlgoName = cms.string("CSCChannelMapperPostls1")
+
+# --- NUMBER OF EVENTS
+
+process.maxEvents = cms.untracked.PSet( input = cms.untracked.int32(1000) )
+
+process.options   = cms.untracked.PSet( wantSummary = cms.untracked.bool(True) )
+
+## ttbar+pu is 200 events per file so need 5 for 1000 events
+process.source    = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(
+"/store/relval/CMSSW_7_3_0/RelValTTbar_13/GEN-SIM-DIGI-RAW-HLTDEBUG/PU25ns_MCRUN2_73_V7_71XGENSIM-v1/00000/044157C8-A181-E411-AC04-002354EF3BD2.root",
+"/store/relval/CMSSW_7_3_0/RelValTTbar_13/GEN-SIM-DIGI-RAW-HLTDEBUG/PU25ns_MCRUN2_73_V7_71XGENSIM-v1/00000/0A963931-A181-E411-B4C5-0026189438DC.root",
+"/store/relval/CMSSW_7_3_0/RelValTTbar_13/GEN-SIM-DIGI-RAW-HLTDEBUG/PU25ns_MCRUN2_73_V7_71XGENSIM-v1/00000/145BE1DC-A181-E411-816D-0025905A609E.root",
+"/store/relval/CMSSW_7_3_0/RelValTTbar_13/GEN-SIM-DIGI-RAW-HLTDEBUG/PU25ns_MCRUN2_73_V7_71XGENSIM-v1/00000/14DDEDD0-A181-E411-9476-0026189438F8.root",
+"/store/relval/CMSSW_7_3_0/RelValTTbar_13/GEN-SIM-DIGI-RAW-HLTDEBUG/PU25ns_MCRUN2_73_V7_71XGENSIM-v1/00000/18F85F36-A181-E411-8AF4-0025905B85D6.root"
+    )
+)
+
+# ME1/1A is  u n g a n g e d  postls1
+
+process.CSCGeometryESModule.useGangedStripsInME1a = False
+
+# Turn off some flags for CSCRecHitD that are turned ON in default config
+
+process.csc2DRecHits.readBadChannels = cms.bool(False)
+process.csc2DRecHits.CSCUseGasGainCorrections = cms.bool(False)
+
+# Switch input for CSCRecHitD to  s i m u l a t e d  digis
+
+process.csc2DRecHits.wireDigiTag  = cms.InputTag("simMuonCSCDigis","MuonCSCWireDigi")
+process.csc2DRecHits.stripDigiTag = cms.InputTag("simMuonCSCDigis","MuonCSCStripDigi")
+
+# '5' is the RU algo
+process.cscSegments.algo_type = cms.int32(5)
+
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
+# --- Differences found by CSCSegAlgoRU::checkFit go to cout
+process.MessageLogger.categories.append("CSCSegAlgoRU")
+process.MessageLogger.destinations = cms.untracked.vstring("cout")
+process.MessageLogger.cout = cms.untracked.PSet(
+    threshold = cms.untracked.string("INFO"),
+    default   = cms.untracked.PSet( limit = cms.untracked.int32(0)  ),
+    FwkReport = cms.untracked.PSet( limit = cms.untracked.int32(-1), reportEvery = cms.untracked.int32(100) ),
+    CSCSegAlgoRU = cms.untracked.PSet( limit = cms.untracked.int32(-1) )
+)
+
+# Path and EndPath def
+process.reco = cms.Path(process.csc2DRecHits * process.cscSegments)
+process.endjob = cms.EndPath(process.endOfProcess)
+
+# Schedule definition
+process.schedule = cms.Schedule(process.reco, process.endjob)
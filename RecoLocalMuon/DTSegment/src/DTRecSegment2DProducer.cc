@@ -26,6 +26,8 @@ using namespace edm;
 
 #include "RecoLocalMuon/DTSegment/src/DTRecSegment2DAlgoFactory.h"
 
+#include "tbb/parallel_for.h"
+
 /* C++ Headers */
 #include <string>
 using namespace std;
@@ -50,6 +52,13 @@ DTRecSegment2DProducer::DTRecSegment2DProducer(const edm::ParameterSet& pset) {
   if(debug) cout << "the Reco2D AlgoName is " << theAlgoName << endl;
   theAlgo = DTRecSegment2DAlgoFactory::get()->create(theAlgoName,
                                                      pset.getParameter<ParameterSet>("Reco2DAlgoConfig"));
+
+  // Number of algorithm instances reconstructing the superlayers concurrently
+  // (the printouts of the debug mode need the serial loop)
+  const int nConcurrentAlgos = pset.existsAs<int>("nConcurrentAlgos") ? pset.getParameter<int>("nConcurrentAlgos") : 1;
+  for (int i = 1; i < nConcurrentAlgos && !debug; ++i)
+    theOtherAlgos.emplace_back(DTRecSegment2DAlgoFactory::get()->create(theAlgoName,
+                                                                        pset.getParameter<ParameterSet>("Reco2DAlgoConfig")));
 }
 
 /// Destructor
@@ -77,6 +86,12 @@ void DTRecSegment2DProducer::produce(edm::Event& event, const
   // Create the pointer to the collection which will store the rechits
   auto segments = std::make_unique<DTRecSegment2DCollection>();
 
+  if (!theOtherAlgos.empty()) {
+    produceConcurrently(*dtGeom, *allHits, setup, *segments);
+    event.put(std::move(segments));
+    return;
+  }
+
   // Iterate through all hit collections ordered by LayerId
   DTRecHitCollection::id_iterator dtLayerIt;
   DTSuperLayerId oldSlId;
@@ -111,3 +126,36 @@ void DTRecSegment2DProducer::produce(edm::Event& event, const
 }
 
 
+
+void DTRecSegment2DProducer::produceConcurrently(const DTGeometry& dtGeom, const DTRecHitCollection& allHits,
+                                                 const edm::EventSetup& setup, DTRecSegment2DCollection& segments) {
+  vector<DTRecSegment2DBaseAlgo*> algos(1, theAlgo);
+  for (auto const& algo : theOtherAlgos) {
+    algo->setES(setup);
+    algos.push_back(algo.get());
+  }
+
+  // The superlayers with hits, in the order of the serial loop
+  vector<DTSuperLayerId> superLayers;
+  for (auto dtLayerIt = allHits.id_begin(); dtLayerIt != allHits.id_end(); ++dtLayerIt){
+    const DTSuperLayerId SLId = (*dtLayerIt).superlayerId();
+    if (superLayers.empty() || superLayers.back() != SLId) superLayers.push_back(SLId);
+  }
+
+  // Each instance of the algorithm takes one superlayer every algos.size(),
+  // and keeps its segments until they are all put in the superlayer order
+  vector<OwnVector<DTSLRecSegment2D> > slSegments(superLayers.size());
+  tbb::parallel_for(size_t(0), algos.size(), [&](size_t i) {
+      for (size_t isl = i; isl < superLayers.size(); isl += algos.size()) {
+        DTRecHitCollection::range range =
+          allHits.get(DTRangeMapAccessor::layersBySuperLayer(superLayers[isl]));
+        vector<DTRecHit1DPair> pairs(range.first,range.second);
+        slSegments[isl] = algos[i]->reconstruct(dtGeom.superLayer(superLayers[isl]), pairs);
+      }
+    });
+
+  for (size_t isl = 0; isl < superLayers.size(); ++isl) {
+    if (!slSegments[isl].empty() )
+      segments.put(superLayers[isl], slSegments[isl].begin(), slSegments[isl].end());
+  }
+}
@@ -4,6 +4,9 @@
 /** \class DTRecSegment2DProducer
  *
  * Producer for DT segment in one projection.
+ *
+ * With nConcurrentAlgos > 1, as many instances of the algorithm reconstruct
+ * the superlayers concurrently; the segments are put in the same order.
  *  
  * \author Stefano Lacaprara - INFN Legnaro <stefano.lacaprara@pd.infn.it>
  * \author Riccardo Bellan - INFN TO <riccardo.bellan@cern.ch>
@@ -13,6 +16,7 @@
 /* Base Class Headers */
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "DataFormats/DTRecHit/interface/DTRecHitCollection.h"
+#include "DataFormats/DTRecHit/interface/DTRecSegment2DCollection.h"
 
 namespace edm {
   class ParameterSet;
@@ -21,8 +25,11 @@ namespace edm {
 }
 
 class DTRecSegment2DBaseAlgo;
+class DTGeometry;
 
 /* C++ Headers */
+#include <memory>
+#include <vector>
 
 /* ====================================================================== */
 
@@ -49,8 +56,13 @@ class DTRecSegment2DProducer : public edm::stream::EDProducer<> {
   // Switch on verbosity
   bool debug;
 
+  void produceConcurrently(const DTGeometry& dtGeom, const DTRecHitCollection& allHits,
+			   const edm::EventSetup& setup, DTRecSegment2DCollection& segments);
+
   // The 2D-segments reconstruction algorithm
   DTRecSegment2DBaseAlgo* theAlgo;
+  // The other instances, for the concurrent reconstruction
+  std::vector<std::unique_ptr<DTRecSegment2DBaseAlgo> > theOtherAlgos;
 
   //static std::string theAlgoName;
   edm::EDGetTokenT<DTRecHitCollection> recHits1DToken_;
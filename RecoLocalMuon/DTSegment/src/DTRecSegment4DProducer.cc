@@ -20,6 +20,8 @@
 
 #include "Geometry/Records/interface/MuonGeometryRecord.h"
 
+#include "tbb/parallel_for.h"
+
 using namespace edm;
 using namespace std;
 
@@ -43,6 +45,13 @@ DTRecSegment4DProducer::DTRecSegment4DProducer(const ParameterSet& pset){
   if(debug) cout << "the Reco4D AlgoName is " << theReco4DAlgoName << endl;
   the4DAlgo = DTRecSegment4DAlgoFactory::get()->create(theReco4DAlgoName,
 						       pset.getParameter<ParameterSet>("Reco4DAlgoConfig"));
+
+  // Number of algorithm instances reconstructing the chambers concurrently
+  // (the printouts of the debug mode need the serial loop)
+  const int nConcurrentAlgos = pset.existsAs<int>("nConcurrentAlgos") ? pset.getParameter<int>("nConcurrentAlgos") : 1;
+  for (int i = 1; i < nConcurrentAlgos && !debug; ++i)
+    theOther4DAlgos.emplace_back(DTRecSegment4DAlgoFactory::get()->create(theReco4DAlgoName,
+									  pset.getParameter<ParameterSet>("Reco4DAlgoConfig")));
 }
 
 /// Destructor
@@ -73,6 +82,12 @@ void DTRecSegment4DProducer::produce(Event& event, const EventSetup& setup){
   // Percolate the setup
   the4DAlgo->setES(setup);
 
+  if (!theOther4DAlgos.empty()) {
+    produceConcurrently(all1DHits, all2DSegments, setup, *segments4DCollection);
+    event.put(std::move(segments4DCollection));
+    return;
+  }
+
   // Iterate over all hit collections ordered by layerId
   DTRecHitCollection::id_iterator dtLayerIt;
 
@@ -112,3 +127,40 @@ void DTRecSegment4DProducer::produce(Event& event, const EventSetup& setup){
   // Load the output in the Event
   event.put(std::move(segments4DCollection));
 }
+
+void DTRecSegment4DProducer::produceConcurrently(const Handle<DTRecHitCollection>& all1DHits,
+						 const Handle<DTRecSegment2DCollection>& all2DSegments,
+						 const EventSetup& setup,
+						 DTRecSegment4DCollection& segments4DCollection){
+
+  vector<DTRecSegment4DBaseAlgo*> algos(1, the4DAlgo);
+  for (auto const& algo : theOther4DAlgos) {
+    algo->setES(setup);
+    algos.push_back(algo.get());
+  }
+
+  // The chambers with hits, in the order of the serial loop
+  vector<DTChamberId> chambers;
+  for (auto dtLayerIt = all1DHits->id_begin(); dtLayerIt != all1DHits->id_end(); ++dtLayerIt){
+    const DTChamberId chId = (*dtLayerIt).chamberId();
+    if (chambers.empty() || chambers.back() != chId) chambers.push_back(chId);
+  }
+
+  // Each instance of the algorithm takes one chamber every algos.size(),
+  // and keeps its segments until they are all put in the chamber order
+  vector<OwnVector<DTRecSegment4D> > segments4D(chambers.size());
+  tbb::parallel_for(size_t(0), algos.size(), [&](size_t i) {
+      DTRecSegment4DBaseAlgo* algo = algos[i];
+      for (size_t ich = i; ich < chambers.size(); ich += algos.size()) {
+	algo->setChamber(chambers[ich]);
+	algo->setDTRecHit1DContainer(all1DHits);
+	algo->setDTRecSegment2DContainer(all2DSegments);
+	segments4D[ich] = algo->reconstruct();
+      }
+    });
+
+  for (size_t ich = 0; ich < chambers.size(); ++ich) {
+    if (!segments4D[ich].empty() )
+      segments4DCollection.put(chambers[ich], segments4D[ich].begin(), segments4D[ich].end());
+  }
+}
@@ -4,12 +4,20 @@
 /** \class DTRecSegment4DProducer
  *  Builds the segments in the DT chambers.
  *
+ *  With nConcurrentAlgos > 1, as many instances of the algorithm reconstruct
+ *  the chambers concurrently; the segments are put in the same order.
+ *
  * \author Riccardo Bellan - INFN Torino <riccardo.bellan@cern.ch>
  */
 
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "DataFormats/DTRecHit/interface/DTRecHitCollection.h"
 #include "DataFormats/DTRecHit/interface/DTRecSegment2DCollection.h"
+#include "DataFormats/DTRecHit/interface/DTRecSegment4DCollection.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+#include <memory>
+#include <vector>
 
 namespace edm {
   class ParameterSet;
@@ -36,6 +44,11 @@ protected:
 
 private:
 
+  void produceConcurrently(const edm::Handle<DTRecHitCollection>& all1DHits,
+			   const edm::Handle<DTRecSegment2DCollection>& all2DSegments,
+			   const edm::EventSetup& setup,
+			   DTRecSegment4DCollection& segments4DCollection);
+
   // Switch on verbosity
   bool debug;
 
@@ -44,6 +57,8 @@ private:
   edm::EDGetTokenT<DTRecSegment2DCollection> recHits2DToken_;
   // The 4D-segments reconstruction algorithm
   DTRecSegment4DBaseAlgo* the4DAlgo;
+  // The other instances, for the concurrent reconstruction
+  std::vector<std::unique_ptr<DTRecSegment4DBaseAlgo> > theOther4DAlgos;
 };
 #endif
 
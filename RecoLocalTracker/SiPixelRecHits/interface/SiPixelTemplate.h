@@ -76,6 +76,7 @@
 //  V10.11 - Allow subdetector ID=5 for FPix R2P2 [allows better internal labeling of templates]
 //  V10.12 - Enforce minimum signal size in pixel charge uncertainty calculation
 //  V10.13 - Update the variable size [SI_PIXEL_TEMPLATE_USE_BOOST] option so that it works with VI's enhancements
+//  V10.14 - Locate the angular interpolation bins by binary search on the cotbeta/cotalpha node arrays
 
 
 
@@ -92,6 +93,7 @@
 
 #include<vector>
 #include<cassert>
+#include<algorithm>
 #include "boost/multi_array.hpp"
 
 #ifndef SI_PIXEL_TEMPLATE_STANDALONE
@@ -540,6 +542,15 @@ public:
    
 private:
    
+   // Find the grid interval [grid[i],grid[i+1]) containing x (grid[0] <= x < grid[n-1]) and the linear
+   // interpolation ratio inside it. Binary search on the node arrays filled once per store by postInit:
+   // they are contiguous, while the cotbeta/cotalpha in the entries are several kB apart.
+   static int gridInterval(const float* grid, int n, float x, float& ratio) {
+      int i = std::upper_bound(grid, grid+n, x) - grid - 1;
+      ratio = (x - grid[i])/(grid[i+1] - grid[i]);
+      return i;
+   }
+   
    // Keep current template interpolaion parameters
    
    int id_current_;           //!< current id
@@ -78,6 +78,7 @@
 //  V10.11 - Allow subdetector ID=5 for FPix R2P2 [allows better internal labeling of templates]
 //  V10.12 - Enforce minimum signal size in pixel charge uncertainty calculation
 //  V10.13 - Update the variable size [SI_PIXEL_TEMPLATE_USE_BOOST] option so that it works with VI's enhancements
+//  V10.14 - Locate the angular interpolation bins by binary search on the cotbeta/cotalpha node arrays
 
 
 
@@ -1135,15 +1136,7 @@ bool SiPixelTemplate::interpolate(int id, float cotalpha, float cotbeta, float l
          
          if(cotb >= thePixelTemp_[index_id_].enty[0].cotbeta) {
             
-            for (i=0; i<Ny-1; ++i) {
-               
-               if( thePixelTemp_[index_id_].enty[i].cotbeta <= cotb && cotb < thePixelTemp_[index_id_].enty[i+1].cotbeta) {
-                  
-                  ilow = i;
-                  yratio = (cotb - thePixelTemp_[index_id_].enty[i].cotbeta)/(thePixelTemp_[index_id_].enty[i+1].cotbeta - thePixelTemp_[index_id_].enty[i].cotbeta);
-                  break;
-               }
-            }
+            ilow = gridInterval(thePixelTemp_[index_id_].cotbetaY, Ny, cotb, yratio);
          } else { success_ = false; }
       }
       
@@ -1277,15 +1270,7 @@ bool SiPixelTemplate::interpolate(int id, float cotalpha, float cotbeta, float l
          
       } else if(abs_cotb_ >= thePixelTemp_[index_id_].entx[0][0].cotbeta) {
          
-         for (i=0; i<Nyx-1; ++i) {
-            
-            if( thePixelTemp_[index_id_].entx[i][0].cotbeta <= abs_cotb_ && abs_cotb_ < thePixelTemp_[index_id_].entx[i+1][0].cotbeta) {
-               
-               iylow = i;
-               yxratio = (abs_cotb_ - thePixelTemp_[index_id_].entx[i][0].cotbeta)/(thePixelTemp_[index_id_].entx[i+1][0].cotbeta - thePixelTemp_[index_id_].entx[i][0].cotbeta);
-               break;
-            }
-         }
+         iylow = gridInterval(thePixelTemp_[index_id_].cotbetaX, Nyx, abs_cotb_, yxratio);
       }
       
       iyhigh=iylow + 1;
@@ -1303,15 +1288,7 @@ bool SiPixelTemplate::interpolate(int id, float cotalpha, float cotbeta, float l
          
          if(cota >= thePixelTemp_[index_id_].entx[0][0].cotalpha) {
             
-            for (i=0; i<Nxx-1; ++i) {
-               
-               if( thePixelTemp_[index_id_].entx[0][i].cotalpha <= cota && cota < thePixelTemp_[index_id_].entx[0][i+1].cotalpha) {
-                  
-                  ilow = i;
-                  xxratio = (cota - thePixelTemp_[index_id_].entx[0][i].cotalpha)/(thePixelTemp_[index_id_].entx[0][i+1].cotalpha - thePixelTemp_[index_id_].entx[0][i].cotalpha);
-                  break;
-               }
-            }
+            ilow = gridInterval(thePixelTemp_[index_id_].cotalphaX, Nxx, cota, xxratio);
          } else { success_ = false; }
       }
       
@@ -2862,15 +2839,7 @@ void SiPixelTemplate::temperrors(int id, float cotalpha, float cotbeta, int qBin
       
       if(cotb >= thePixelTemp_[index].enty[0].cotbeta) {
          
-         for (i=0; i<Ny-1; ++i) {
-            
-            if( thePixelTemp_[index].enty[i].cotbeta <= cotb && cotb < thePixelTemp_[index].enty[i+1].cotbeta) {
-               
-               ilow = i;
-               yratio = (cotb - thePixelTemp_[index].enty[i].cotbeta)/(thePixelTemp_[index].enty[i+1].cotbeta - thePixelTemp_[index].enty[i].cotbeta);
-               break;
-            }
-         }
+         ilow = gridInterval(thePixelTemp_[index].cotbetaY, Ny, cotb, yratio);
       }
    }
    
@@ -2895,15 +2864,7 @@ void SiPixelTemplate::temperrors(int id, float cotalpha, float cotbeta, int qBin
       
    } else if(acotb >= thePixelTemp_[index].entx[0][0].cotbeta) {
       
-      for (i=0; i<Nyx-1; ++i) {
-         
-         if( thePixelTemp_[index].entx[i][0].cotbeta <= acotb && acotb < thePixelTemp_[index].entx[i+1][0].cotbeta) {
-            
-            iylow = i;
-            yxratio = (acotb - thePixelTemp_[index].entx[i][0].cotbeta)/(thePixelTemp_[index].entx[i+1][0].cotbeta - thePixelTemp_[index].entx[i][0].cotbeta);
-            break;
-         }
-      }
+      iylow = gridInterval(thePixelTemp_[index].cotbetaX, Nyx, acotb, yxratio);
    }
    
    iyhigh=iylow + 1;
@@ -2920,15 +2881,7 @@ void SiPixelTemplate::temperrors(int id, float cotalpha, float cotbeta, int qBin
       
       if(cotalpha >= thePixelTemp_[index].entx[0][0].cotalpha) {
          
-         for (i=0; i<Nxx-1; ++i) {
-            
-            if( thePixelTemp_[index].entx[0][i].cotalpha <= cotalpha && cotalpha < thePixelTemp_[index].entx[0][i+1].cotalpha) {
-               
-               ilow = i;
-               xxratio = (cotalpha - thePixelTemp_[index].entx[0][i].cotalpha)/(thePixelTemp_[index].entx[0][i+1].cotalpha - thePixelTemp_[index].entx[0][i].cotalpha);
-               break;
-            }
-         }
+         ilow = gridInterval(thePixelTemp_[index].cotalphaX, Nxx, cotalpha, xxratio);
       }
    }
    
@@ -3050,15 +3003,7 @@ void SiPixelTemplate::qbin_dist(int id, float cotalpha, float cotbeta, float qbi
       
       if(cotb >= thePixelTemp_[index].enty[0].cotbeta) {
          
-         for (i=0; i<Ny-1; ++i) {
-            
-            if( thePixelTemp_[index].enty[i].cotbeta <= cotb && cotb < thePixelTemp_[index].enty[i+1].cotbeta) {
-               
-               ilow = i;
-               yratio = (cotb - thePixelTemp_[index].enty[i].cotbeta)/(thePixelTemp_[index].enty[i+1].cotbeta - thePixelTemp_[index].enty[i].cotbeta);
-               break;
-            }
-         }
+         ilow = gridInterval(thePixelTemp_[index].cotbetaY, Ny, cotb, yratio);
       }
    }
    
@@ -3080,15 +3025,7 @@ void SiPixelTemplate::qbin_dist(int id, float cotalpha, float cotbeta, float qbi
       
    } else if(acotb >= thePixelTemp_[index].entx[0][0].cotbeta) {
       
-      for (i=0; i<Nyx-1; ++i) {
-         
-         if( thePixelTemp_[index].entx[i][0].cotbeta <= acotb && acotb < thePixelTemp_[index].entx[i+1][0].cotbeta) {
-            
-            iylow = i;
-            yxratio = (acotb - thePixelTemp_[index].entx[i][0].cotbeta)/(thePixelTemp_[index].entx[i+1][0].cotbeta - thePixelTemp_[index].entx[i][0].cotbeta);
-            break;
-         }
-      }
+      iylow = gridInterval(thePixelTemp_[index].cotbetaX, Nyx, acotb, yxratio);
    }
    
    iyhigh=iylow + 1;
@@ -3105,15 +3042,7 @@ void SiPixelTemplate::qbin_dist(int id, float cotalpha, float cotbeta, float qbi
       
       if(cotalpha >= thePixelTemp_[index].entx[0][0].cotalpha) {
          
-         for (i=0; i<Nxx-1; ++i) {
-            
-            if( thePixelTemp_[index].entx[0][i].cotalpha <= cotalpha && cotalpha < thePixelTemp_[index].entx[0][i+1].cotalpha) {
-               
-               ilow = i;
-               xxratio = (cotalpha - thePixelTemp_[index].entx[0][i].cotalpha)/(thePixelTemp_[index].entx[0][i+1].cotalpha - thePixelTemp_[index].entx[0][i].cotalpha);
-               break;
-            }
-         }
+         ilow = gridInterval(thePixelTemp_[index].cotalphaX, Nxx, cotalpha, xxratio);
       }
    }
    
@@ -3366,7 +3295,6 @@ void SiPixelTemplate::vavilov_pars(double& mpv, double& sigma, double& kappa)
 
 {
    // Local variables 
-   int i;
    int ilow, ihigh, Ny;
    float yratio, cotb, cotalpha0, arg;
    
@@ -3403,15 +3331,7 @@ void SiPixelTemplate::vavilov_pars(double& mpv, double& sigma, double& kappa)
       
       if(cotb >= thePixelTemp_[index_id_].enty[0].cotbeta) {
          
-         for (i=0; i<Ny-1; ++i) { 
-            
-            if( thePixelTemp_[index_id_].enty[i].cotbeta <= cotb && cotb < thePixelTemp_[index_id_].enty[i+1].cotbeta) {
-               
-               ilow = i;
-               yratio = (cotb - thePixelTemp_[index_id_].enty[i].cotbeta)/(thePixelTemp_[index_id_].enty[i+1].cotbeta - thePixelTemp_[index_id_].enty[i].cotbeta);
-               break;			 
-            }
-         }
+         ilow = gridInterval(thePixelTemp_[index_id_].cotbetaY, Ny, cotb, yratio);
       } 
    }
    
@@ -3444,7 +3364,6 @@ void SiPixelTemplate::vavilov2_pars(double& mpv, double& sigma, double& kappa)
 
 {
    // Local variables 
-   int i;
    int ilow, ihigh, Ny;
    float yratio, cotb, cotalpha0, arg;
    
@@ -3481,15 +3400,7 @@ void SiPixelTemplate::vavilov2_pars(double& mpv, double& sigma, double& kappa)
       
       if(cotb >= thePixelTemp_[index_id_].enty[0].cotbeta) {
          
-         for (i=0; i<Ny-1; ++i) { 
-            
-            if( thePixelTemp_[index_id_].enty[i].cotbeta <= cotb && cotb < thePixelTemp_[index_id_].enty[i+1].cotbeta) {
-               
-               ilow = i;
-               yratio = (cotb - thePixelTemp_[index_id_].enty[i].cotbeta)/(thePixelTemp_[index_id_].enty[i+1].cotbeta - thePixelTemp_[index_id_].enty[i].cotbeta);
-               break;			 
-            }
-         }
+         ilow = gridInterval(thePixelTemp_[index_id_].cotbetaY, Ny, cotb, yratio);
       } 
    }
    
@@ -133,6 +133,10 @@ namespace {
     
     StripClusterizerAlgorithm & clusterizer;
     SiStripRawProcessingAlgorithms & rawAlgos;
+
+    // the raw processing algorithms (pedestal, CMN, APV restorer) keep state:
+    // in on-demand mode dets can be filled concurrently, so serialize them
+    std::mutex rawAlgosMutex;
     
     
     // March 2012: add flag for disabling APVe check in configuration
@@ -405,6 +409,7 @@ try { // edmNew::CapacityExaustedException
 	
 	// unpack
 	std::vector<int16_t> digis;
+	digis.reserve(256);
 	while (unpacker.hasData()) {
 	  digis.push_back(unpacker.adc());
 	  unpacker++;
@@ -417,7 +422,10 @@ try { // edmNew::CapacityExaustedException
 	//rawAlgos_->subtractorCMN->subtract( id, digis);
 	//rawAlgos_->suppressor->suppress( digis, zsdigis);
 	uint16_t firstAPV = ipair*2;
-	rawAlgos.SuppressVirginRawData(id, firstAPV,digis, zsdigis);
+	{
+	  std::lock_guard<std::mutex> guard(rawAlgosMutex);
+	  rawAlgos.SuppressVirginRawData(id, firstAPV,digis, zsdigis);
+	}
  	for( edm::DetSet<SiStripDigi>::const_iterator it = zsdigis.begin(); it!=zsdigis.end(); it++) {
 	  clusterizer.stripByStripAdd(state, it->strip(), it->adc(), record);
 	}
@@ -430,6 +438,7 @@ try { // edmNew::CapacityExaustedException
 	
 	// unpack
 	std::vector<int16_t> digis;
+	digis.reserve(256);
 	while (unpacker.hasData()) {
 	  digis.push_back(unpacker.adc());
 	  unpacker++;
@@ -441,7 +450,10 @@ try { // edmNew::CapacityExaustedException
 	//rawAlgos_->subtractorCMN->subtract( id, digis);
 	//rawAlgos_->suppressor->suppress( digis, zsdigis);
 	uint16_t firstAPV = ipair*2;
-	rawAlgos.SuppressProcessedRawData(id, firstAPV,digis, zsdigis);
+	{
+	  std::lock_guard<std::mutex> guard(rawAlgosMutex);
+	  rawAlgos.SuppressProcessedRawData(id, firstAPV,digis, zsdigis);
+	}
 	for( edm::DetSet<SiStripDigi>::const_iterator it = zsdigis.begin(); it!=zsdigis.end(); it++) {
 	  clusterizer.stripByStripAdd(state, it->strip(), it->adc(), record);
 	}
@@ -0,0 +1,119 @@
+#ifndef RECOLOCALTRACKER_SISTRIPZEROSUPPRESSION_SISTRIPAPVBLOCKALGOS_H
+#define RECOLOCALTRACKER_SISTRIPZEROSUPPRESSION_SISTRIPAPVBLOCKALGOS_H
+
+/*
+ * Kernels working on one APV (a fixed block of 128 strips).
+ * The block size is a compile time constant: the scratch copies live on the stack
+ * and the element-wise loops have a known trip count, so the compiler unrolls and
+ * vectorizes them. Results are identical to the generic std::vector versions.
+ *
+ * For integer ADCs the order statistics (median, percentile) are computed by counting
+ * in a histogram spanning [min,max] of the APV instead of a partial sort:
+ * min/max and the histogram reset are vectorized, the rest is a short linear scan.
+ */
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace sistrip {
+  namespace apvblock {
+
+    constexpr unsigned int nStrips = 128;
+
+    namespace detail {
+
+      // above this (max-min) the histogram scan gets longer than a partial sort
+      constexpr int maxHistogramRange = 4096;
+
+      // k-th and (k+1)-th smallest values of the APV (partial sort)
+      template<typename T>
+      inline void select(const T * apv, unsigned int k, T & vk, T & vk1) {
+        std::array<T,nStrips> tmp;
+        std::copy(apv, apv+nStrips, tmp.begin());
+        if (k+1 >= nStrips) {
+          vk = vk1 = *std::max_element(tmp.begin(), tmp.end());
+          return;
+        }
+        auto next = tmp.begin() + k+1;
+        std::nth_element(tmp.begin(), next, tmp.end());
+        vk1 = *next;
+        vk = *std::max_element(tmp.begin(), next);
+      }
+
+      // as above, counting for integer types
+      template<typename T>
+      inline void select(const T * apv, unsigned int k, T & vk, T & vk1, std::true_type) {
+        T min = apv[0], max = apv[0];
+        for (unsigned int i=0; i<nStrips; ++i) {
+          min = std::min(min,apv[i]);
+          max = std::max(max,apv[i]);
+        }
+        const int range = int(max)-int(min);
+        if (range >= maxHistogramRange) { select(apv,k,vk,vk1); return; }
+
+        uint8_t counts[maxHistogramRange];  // at most 128 entries per bin
+        std::memset(counts, 0, range+1);
+        for (unsigned int i=0; i<nStrips; ++i) ++counts[int(apv[i])-int(min)];
+
+        int bin = 0;
+        unsigned int nBelow = counts[0];
+        while (nBelow <= k) nBelow += counts[++bin];
+        vk = T(int(min)+bin);
+        if (nBelow > k+1 || k+1 >= nStrips) { vk1 = vk; return; }
+        while (!counts[++bin]) ;
+        vk1 = T(int(min)+bin);
+      }
+
+      template<typename T>
+      inline void select(const T * apv, unsigned int k, T & vk, T & vk1, std::false_type) {
+        select(apv,k,vk,vk1);
+      }
+
+    }
+
+    // median of the 128 strips, same convention as SiStripCommonModeNoiseSubtractor::median:
+    // for an even sample the average of the two central values
+    template<typename T>
+    inline float median(const T * apv) {
+      T low, high;
+      detail::select(apv, nStrips/2-1, low, high, std::is_integral<T>());
+      return ( low + high ) / 2.;
+    }
+
+    // value at the given percentile, same convention as PercentileCMNSubtractor::percentile
+    template<typename T>
+    inline float percentile(const T * apv, double pct) {
+      T value, next;
+      detail::select(apv, int(nStrips*pct/100.0), value, next, std::is_integral<T>());
+      return value;
+    }
+
+    // common mode subtraction
+    template<typename T>
+    inline void subtract(T * __restrict__ apv, float offset) {
+      for (unsigned int i=0; i<nStrips; ++i)
+        apv[i] = static_cast<T>(apv[i]-offset);
+    }
+
+    // subtract a (restored) baseline, keeping the median level
+    inline void subtractBaseline(int16_t * __restrict__ apv, const int16_t * __restrict__ baseline, float median) {
+      for (unsigned int i=0; i<nStrips; ++i)
+        apv[i] -= baseline[i] - median;
+    }
+
+    // number of strips at or above the given adc (e.g. saturated strips)
+    template<typename T>
+    inline unsigned int countAtLeast(const T * apv, T adc) {
+      unsigned int n=0;
+      for (unsigned int i=0; i<nStrips; ++i)
+        n += (apv[i]>=adc);
+      return n;
+    }
+
+  }
+}
+
+#endif
@@ -1,10 +1,12 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/IteratedMedianCMNSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripAPVBlockAlgos.h"
 
 #include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
 #include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
 #include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
 #include "CalibTracker/Records/interface/SiStripQualityRcd.h"
 #include <cmath>
+#include <algorithm>
 
 void IteratedMedianCMNSubtractor::init(const edm::EventSetup& es){
   uint32_t n_cache_id = es.get<SiStripNoisesRcd>().cacheIdentifier();
@@ -31,7 +33,6 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
   SiStripNoises::Range detNoiseRange = noiseHandle->getRange(detId);
   SiStripQuality::Range detQualityRange = qualityHandle->getRange(detId);
 
-  typename std::vector<T>::iterator fs,ls;
   float offset = 0;  
   std::vector< std::pair<float,float> > subset;
   subset.reserve(128);
@@ -60,14 +61,10 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
     // and recalculate offset on remaining strips
     for ( int ii = 0; ii<iterations_-1; ++ii )
     {
-      std::vector< std::pair<float,float> >::iterator si = subset.begin();
-      while(  si != subset.end() )
-      {
-        if( si->first-offset > cut_to_avoid_signal_*si->second )  
-          si = subset.erase(si);
-        else
-          ++si;
-      }
+      // single pass compaction: the median does not depend on the order of the remaining strips
+      subset.erase( std::remove_if( subset.begin(), subset.end(),
+                                    [&](const std::pair<float,float> & si) { return si.first-offset > cut_to_avoid_signal_*si.second; } ),
+                    subset.end() );
       if ( subset.empty() ) break;
       offset = pairMedian(subset);
     }        
@@ -75,12 +72,7 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
     _vmedians.push_back(std::pair<short,float>(APV,offset));
     
     // remove offset
-    fs = digis.begin()+(APV-firstAPV)*128;
-    ls = digis.begin()+(APV-firstAPV+1)*128;
-    while (fs < ls) {
-      *fs = static_cast<T>(*fs-offset);
-      fs++;
-    }
+    sistrip::apvblock::subtract(digis.data()+(APV-firstAPV)*128, offset);
 
   }
 }
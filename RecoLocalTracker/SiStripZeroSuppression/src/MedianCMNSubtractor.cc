@@ -1,4 +1,5 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/MedianCMNSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripAPVBlockAlgos.h"
 
 void MedianCMNSubtractor::subtract(const uint32_t& detId,const uint16_t& firstAPV, std::vector<int16_t>& digis) {subtract_(detId,firstAPV,digis);}
 void MedianCMNSubtractor::subtract(const uint32_t& detId,const uint16_t& firstAPV, std::vector<float>& digis) {subtract_(detId,firstAPV, digis);}
@@ -8,25 +9,18 @@ inline
 void MedianCMNSubtractor::
 subtract_(const uint32_t& detId,const uint16_t& firstAPV, std::vector<T>& digis){
   
-  std::vector<T> tmp;  tmp.reserve(128);  
-  typename std::vector<T>::iterator  
-    strip( digis.begin() ), 
-    end(   digis.end()   ),
-    endAPV;
+  T * strip = digis.data();
+  T * end = strip + digis.size();
   
   _vmedians.clear();
   
   while( strip < end ) {
-    endAPV = strip+128; tmp.clear();
-    tmp.insert(tmp.end(),strip,endAPV);
-    const float offset = median(tmp);
+    const float offset = sistrip::apvblock::median(strip);
 
-    _vmedians.push_back(std::pair<short,float>((strip-digis.begin())/128+firstAPV,offset));
+    _vmedians.push_back(std::pair<short,float>((strip-digis.data())/128+firstAPV,offset));
     
-    while (strip < endAPV) {
-      *strip = static_cast<T>(*strip-offset);
-      strip++;
-    }
+    sistrip::apvblock::subtract(strip,offset);
+    strip += sistrip::apvblock::nStrips;
 
   }
 }
@@ -1,5 +1,6 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripAPVRestorer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripAPVBlockAlgos.h"
 
 #include <cmath>
 #include <iostream>
@@ -155,10 +156,8 @@ int16_t SiStripAPVRestorer::BaselineFollowerInspect(const uint16_t& firstAPV, st
       float MeanAPVCM = MeanCM_;
       if(useRealMeanCM_&&itCMMap!= MeanCMmap_.end()) MeanAPVCM =(itCMMap->second)[APV];
     
-      singleAPVdigi.clear(); 
-      for(int16_t strip = (APV-firstAPV)*128; strip < (APV-firstAPV+1)*128; ++strip){
-        singleAPVdigi.push_back(digis[strip]); 
-      }
+      auto firstStrip = digis.begin() + (APV-firstAPV)*128;
+      singleAPVdigi.assign(firstStrip, firstStrip+128);
    
    
       float DeltaCM = median_[APV] - MeanAPVCM; 
@@ -184,10 +183,6 @@ int16_t SiStripAPVRestorer::BaselineFollowerInspect(const uint16_t& firstAPV, st
 template<typename T>
 inline
 int16_t SiStripAPVRestorer::BaselineAndSaturationInspect(const uint16_t& firstAPV, std::vector<T>& digis){
-  std::vector<T> singleAPVdigi;
-  singleAPVdigi.clear();
-  
-  
   int16_t nAPVflagged = 0;
   
   CMMap::iterator itCMMap;
@@ -199,13 +194,7 @@ int16_t SiStripAPVRestorer::BaselineAndSaturationInspect(const uint16_t& firstAP
      float MeanAPVCM = MeanCM_;
      if(useRealMeanCM_&&itCMMap!= MeanCMmap_.end()) MeanAPVCM =(itCMMap->second)[APV];
     
-     singleAPVdigi.clear();
-   
-     uint16_t nSatStrip =0;
-     for(int16_t strip = (APV-firstAPV)*128; strip < (APV-firstAPV+1)*128; ++strip){
-        singleAPVdigi.push_back(digis[strip]); 
-        if(digis[strip] >=1023) ++nSatStrip;
-      }
+     uint16_t nSatStrip = sistrip::apvblock::countAtLeast(digis.data()+(APV-firstAPV)*128, T(1023));
          
      float DeltaCM = median_[APV] -MeanAPVCM; 
     
@@ -324,9 +313,7 @@ void SiStripAPVRestorer::BaselineFollowerRestore(const uint16_t& APVn, const uin
   } else {
     //median=0;
     DigiMap  smoothedpoints;
-    std::vector<int16_t> singleAPVdigi;
-    singleAPVdigi.clear(); 
-    for(int16_t strip = (APVn-firstAPV)*128; strip < (APVn-firstAPV+1)*128; ++strip) singleAPVdigi.push_back(digis[strip]); 
+    std::vector<int16_t> singleAPVdigi(digis.begin()+(APVn-firstAPV)*128, digis.begin()+(APVn-firstAPV+1)*128);
     this->FlatRegionsFinder(singleAPVdigi,smoothedpoints, APVn);
     this->BaselineFollower(smoothedpoints, baseline, median);		
     
@@ -338,9 +325,7 @@ void SiStripAPVRestorer::BaselineFollowerRestore(const uint16_t& APVn, const uin
   
   //============================= subtracting the baseline =============================================
   
-  for(int16_t itStrip= 0 ; itStrip< 128; ++itStrip){
-    digis[(APVn-firstAPV)*128+itStrip] -= baseline[itStrip] - median;
-  }
+  sistrip::apvblock::subtractBaseline(digis.data()+(APVn-firstAPV)*128, baseline.data(), median);
   
 		
   //============================= storing baseline to the map =============================================	
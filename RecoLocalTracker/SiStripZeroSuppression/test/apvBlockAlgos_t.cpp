@@ -0,0 +1,100 @@
+// compare the fixed-size APV kernels with the generic std::vector implementations
+// and time both on pedestal-subtracted virgin-raw like APVs (baseline, common mode, hits)
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripAPVBlockAlgos.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+  template<typename T>
+  float refMedian(std::vector<T> sample) {
+    auto mid = sample.begin() + sample.size()/2;
+    std::nth_element(sample.begin(), mid, sample.end());
+    if( sample.size() & 1 ) return *mid;
+    return ( *std::max_element(sample.begin(), mid) + *mid ) / 2.;
+  }
+
+  template<typename T>
+  float refPercentile(std::vector<T> sample, double pct) {
+    auto mid = sample.begin() + int(sample.size()*pct/100.0);
+    std::nth_element(sample.begin(), mid, sample.end());
+    return *mid;
+  }
+
+  template<typename T>
+  std::vector<T> makeModule(std::mt19937 & gen, unsigned int nAPV) {
+    std::normal_distribution<float> noise(0.,4.);
+    std::uniform_real_distribution<float> cm(100.,160.);
+    std::uniform_int_distribution<int> hit(0,20);
+    std::uniform_real_distribution<float> wide(-5000.,5000.);
+    std::vector<T> digis;
+    for (unsigned int iapv=0; iapv<nAPV; ++iapv) {
+      float base = cm(gen);
+      // a few APVs with a very wide adc range (beyond the counting histogram)
+      bool isWide = hit(gen)==0;
+      for (unsigned int i=0; i<sistrip::apvblock::nStrips; ++i) {
+        float adc = isWide ? wide(gen) : base + noise(gen) + (hit(gen)==0 ? 300.f : 0.f);
+        digis.push_back(static_cast<T>(std::min(adc,1023.f)));
+      }
+    }
+    return digis;
+  }
+
+  template<typename T>
+  int check(const char * name) {
+    std::mt19937 gen(42);
+    int nFail = 0;
+    const unsigned int nModules = 20000, nAPV = 6;
+    std::vector<std::vector<T>> modules;
+    for (unsigned int i=0; i<nModules; ++i) modules.push_back(makeModule<T>(gen,nAPV));
+
+    // equivalence
+    for (auto const & digis : modules) {
+      for (unsigned int iapv=0; iapv<nAPV; ++iapv) {
+        auto b = digis.begin()+iapv*128;
+        std::vector<T> apv(b,b+128);
+        if (refMedian(apv) != sistrip::apvblock::median(apv.data())) ++nFail;
+        if (refPercentile(apv,25.) != sistrip::apvblock::percentile(apv.data(),25.) ||
+            refPercentile(apv,99.) != sistrip::apvblock::percentile(apv.data(),99.)) ++nFail;
+        auto off = refMedian(apv);
+        std::vector<T> ref(apv);
+        for (auto & s : ref) s = static_cast<T>(s-off);
+        sistrip::apvblock::subtract(apv.data(),off);
+        if (ref != apv) ++nFail;
+      }
+    }
+
+    // timing of median + common mode subtraction
+    auto copyRef = modules;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (auto & digis : copyRef) {
+      for (auto strip = digis.begin(); strip < digis.end(); ) {
+        auto endAPV = strip+128;
+        float off = refMedian(std::vector<T>(strip,endAPV));
+        while (strip < endAPV) { *strip = static_cast<T>(*strip-off); ++strip; }
+      }
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    auto copyNew = modules;
+    for (auto & digis : copyNew) {
+      for (T * strip = digis.data(); strip < digis.data()+digis.size(); strip += 128)
+        sistrip::apvblock::subtract(strip, sistrip::apvblock::median(strip));
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    if (copyRef != copyNew) ++nFail;
+
+    std::cout << name << ": " << nModules*nAPV << " APVs, generic "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t1-t0).count() << " us, fixed-size "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count() << " us, "
+              << nFail << " mismatches" << std::endl;
+    return nFail;
+  }
+}
+
+int main() {
+  int nFail = check<int16_t>("int16_t") + check<float>("float");
+  return nFail==0 ? 0 : 1;
+}
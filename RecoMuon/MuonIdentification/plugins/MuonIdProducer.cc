@@ -144,6 +144,12 @@ muIsoExtractorCalo_(nullptr),muIsoExtractorTrack_(nullptr),muIsoExtractorJet_(nu
    edm::InputTag rpcHitTag("rpcRecHits");
    rpcHitToken_ = consumes<RPCRecHitCollection>(rpcHitTag);
    
+   // the associator uses the trajectories propagated with the same propagator
+   usePropagatedTrajectories_ = iConfig.existsAs<edm::InputTag>("propagatedTrajectories");
+   if (usePropagatedTrajectories_) {
+     propagatedTrajectoriesToken_ = consumes<PropagatedTrajectories>(iConfig.getParameter<edm::InputTag>("propagatedTrajectories"));
+   }
+   
 
    //Consumes... UGH
    inputCollectionTypes_.resize(inputCollectionLabels_.size());
@@ -257,6 +263,12 @@ void MuonIdProducer::init(edm::Event& iEvent, const edm::EventSetup& iSetup)
 
    iEvent.getByToken(rpcHitToken_, rpcHitHandle_);
    if (fillGlobalTrackQuality_) iEvent.getByToken(glbQualToken_, glbQualHandle_);
+   if (usePropagatedTrajectories_) {
+     iEvent.getByToken(propagatedTrajectoriesToken_, propagatedTrajectoriesHandle_);
+     if (propagatedTrajectoriesHandle_->propagator() != "SteppingHelixPropagatorAny")
+       throw cms::Exception("ConfigurationError") << "The propagated trajectories were propagated with "
+         << propagatedTrajectoriesHandle_->propagator() << " instead of SteppingHelixPropagatorAny";
+   }
 
 }
 
@@ -803,7 +815,10 @@ void MuonIdProducer::fillMuonId(edm::Event& iEvent, const edm::EventSetup& iSetu
    else throw cms::Exception("FatalError") << "Failed to fill muon id information for a muon with undefined references to tracks";
 
 
-   TrackDetMatchInfo info = trackAssociator_.associate(iEvent, iSetup, *track, parameters_, direction);
+   TrackDetMatchInfo info = usePropagatedTrajectories_ ?
+     trackAssociator_.associate(iEvent, iSetup, aMuon.track().isNonnull() ? aMuon.track() : aMuon.standAloneMuon(),
+                                *propagatedTrajectoriesHandle_, parameters_, direction) :
+     trackAssociator_.associate(iEvent, iSetup, *track, parameters_, direction);
 
    LogTrace("MuonIdentification") << "RecoMuon/MuonIdProducer :: fillMuonId :: fillEnergy = "<<fillEnergy_;
 
@@ -1317,6 +1332,7 @@ void MuonIdProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptio
   desc.setAllowAnything();
   
   desc.add<bool>("arbitrateTrackerMuons",false);
+  desc.addOptional<edm::InputTag>("propagatedTrajectories")->setComment("PropagatedTrajectoryProducer with the same TrackAssociatorParameters");
 
   edm::ParameterSetDescription descTrkAsoPar;
   descTrkAsoPar.add<edm::InputTag>("GEMSegmentCollectionLabel",edm::InputTag("gemSegments"));
@@ -226,6 +226,11 @@ class MuonIdProducer : public edm::stream::EDProducer<> {
    edm::Handle<RPCRecHitCollection> rpcHitHandle_;
    edm::Handle<edm::ValueMap<reco::MuonQuality> > glbQualHandle_;
    
+   // trajectories of the inner tracks propagated beforehand (optional)
+   bool usePropagatedTrajectories_;
+   edm::EDGetTokenT<PropagatedTrajectories> propagatedTrajectoriesToken_;
+   edm::Handle<PropagatedTrajectories> propagatedTrajectoriesHandle_;
+   
    MuonCaloCompatibility muonCaloCompatibility_;
    reco::isodeposit::IsoDepositExtractor* muIsoExtractorCalo_;
    reco::isodeposit::IsoDepositExtractor* muIsoExtractorTrack_;
@@ -149,122 +149,153 @@ void Basic2DGenericPFlowClusterizer::
 growPFClusters(const reco::PFCluster& topo,
 	       const std::vector<bool>& seedable,
 	       const unsigned toleranceScaling,
-	       const unsigned iter,
+	       unsigned iter,
 	       double diff,
 	       reco::PFClusterCollection& clusters) const {
-  if( iter >= _maxIterations ) {
-    LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
-      <<"reached " << _maxIterations << " iterations, terminated position "
-      << "fit with diff = " << diff;
-  }      
-  if( iter >= _maxIterations || 
-      diff <= _stoppingTolerance*toleranceScaling) return;
-  // reset the rechits in this cluster, keeping the previous position    
-  std::vector<reco::PFCluster::REPPoint> clus_prev_pos;  
-  for( auto& cluster : clusters) {
-    const reco::PFCluster::REPPoint& repp = cluster.positionREP();
-    clus_prev_pos.emplace_back(repp.rho(),repp.eta(),repp.phi());
-    if( _convergencePosCalc ) {
-      if( clusters.size() == 1 && _allCellsPosCalc ) {
-	_allCellsPosCalc->calculateAndSetPosition(cluster);
-      } else {
-	_positionCalc->calculateAndSetPosition(cluster);
-      }
-    }
-    cluster.resetHitsAndFractions();
+  // the rechit quantities used in the fractions do not change between 
+  // iterations: look them up once, in arrays indexed like the topo cluster
+  const auto& topoFractions = topo.recHitFractions();
+  const unsigned nhits = topoFractions.size();
+  std::vector<double> hitX(nhits), hitY(nhits), hitZ(nhits), hitNorm(nhits);
+  std::vector<uint32_t> hitId(nhits);
+  std::vector<char> hitSeedable(nhits);
+  for( unsigned ih = 0; ih < nhits; ++ih ) {
+    const reco::PFRecHitRef& refhit = topoFractions[ih].recHitRef();
+    const math::XYZPoint& pos = refhit->position();
+    hitX[ih] = pos.x(); hitY[ih] = pos.y(); hitZ[ih] = pos.z();
+    hitId[ih] = refhit->detId();
+    hitSeedable[ih] = seedable[refhit.key()];
+    hitNorm[ih] = recHitEnergyNorm(*refhit);
   }
-  // loop over topo cluster and grow current PFCluster hypothesis 
-  std::vector<double> dist2, frac;
-  double fractot = 0;
-  for( const reco::PFRecHitFraction& rhf : topo.recHitFractions() ) {
-    const reco::PFRecHitRef& refhit = rhf.recHitRef();
-    int cell_layer = (int)refhit->layer();
-    if( cell_layer == PFLayer::HCAL_BARREL2 && 
-	std::abs(refhit->positionREP().eta()) > 0.34 ) {
-      cell_layer *= 100;
-    }  
-
-    math::XYZPoint topocellpos_xyz(refhit->position());
-    dist2.clear(); frac.clear(); fractot = 0;
-
-    double recHitEnergyNorm=0.;
-    auto const& recHitEnergyNormDepthPair = _recHitEnergyNorms.find(cell_layer)->second;
 
-    for (unsigned int j=0; j<recHitEnergyNormDepthPair.second.size(); ++j) {
-      int depth=recHitEnergyNormDepthPair.first[j];
+  const unsigned nclus = clusters.size();
+  std::vector<reco::PFCluster::REPPoint> clus_prev_pos(nclus);
+  std::vector<double> clusX(nclus), clusY(nclus), clusZ(nclus), clusE(nclus);
+  std::vector<uint32_t> clusSeed(nclus);
+  std::vector<double> dist2(nclus), frac(nclus);
+  std::vector<float> expo(nclus);
 
-      if( ( cell_layer == PFLayer::HCAL_BARREL1 && refhit->depth()== depth)
-	  || ( cell_layer == PFLayer::HCAL_ENDCAP && refhit->depth()== depth)
-	  || ( cell_layer != PFLayer::HCAL_ENDCAP && cell_layer != PFLayer::HCAL_BARREL1)
-	  ) recHitEnergyNorm = recHitEnergyNormDepthPair.second[j];
+  for( ;; ++iter ) {
+    if( iter >= _maxIterations ) {
+      LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
+	<<"reached " << _maxIterations << " iterations, terminated position "
+	<< "fit with diff = " << diff;
+    }      
+    if( iter >= _maxIterations || 
+	diff <= _stoppingTolerance*toleranceScaling) return;
+    // reset the rechits in this cluster, keeping the previous position    
+    for( unsigned i = 0; i < nclus; ++i ) {
+      reco::PFCluster& cluster = clusters[i];
+      const reco::PFCluster::REPPoint& repp = cluster.positionREP();
+      clus_prev_pos[i] = reco::PFCluster::REPPoint(repp.rho(),repp.eta(),repp.phi());
+      if( _convergencePosCalc ) {
+	if( nclus == 1 && _allCellsPosCalc ) {
+	  _allCellsPosCalc->calculateAndSetPosition(cluster);
+	} else {
+	  _positionCalc->calculateAndSetPosition(cluster);
+	}
+      }
+      cluster.resetHitsAndFractions();
+      const math::XYZPoint& pos = cluster.position();
+      clusX[i] = pos.x(); clusY[i] = pos.y(); clusZ[i] = pos.z();
+      clusE[i] = cluster.energy();
+      clusSeed[i] = cluster.seed();
     }
-
-    // add rechits to clusters, calculating fraction based on distance
-    for( auto& cluster : clusters ) {      
-      const math::XYZPoint& clusterpos_xyz = cluster.position();
-      const math::XYZVector deltav = clusterpos_xyz - topocellpos_xyz;
-      const double d2 = deltav.Mag2()/_showerSigma2;
-      dist2.emplace_back( d2 );
-      if( d2 > 100 ) {
-	LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
-	  << "Warning! :: pfcluster-topocell distance is too large! d= "
-	  << d2;
+    // loop over topo cluster and grow current PFCluster hypothesis 
+    for( unsigned ih = 0; ih < nhits; ++ih ) {
+      const double hx = hitX[ih], hy = hitY[ih], hz = hitZ[ih];
+      for( unsigned i = 0; i < nclus; ++i ) {
+	const double dx = clusX[i] - hx;
+	const double dy = clusY[i] - hy;
+	const double dz = clusZ[i] - hz;
+	dist2[i] = (dx*dx + dy*dy + dz*dz)/_showerSigma2;
+      }
+      for( unsigned i = 0; i < nclus; ++i ) {
+	expo[i] = vdt::fast_expf( -0.5*dist2[i] );
       }
 
       // fraction assignment logic
-      double fraction;
-      if( refhit->detId() == cluster.seed() && _excludeOtherSeeds ) {
-	fraction = 1.0;	
-      } else if ( seedable[refhit.key()] && _excludeOtherSeeds ) {
-	fraction = 0.0;
-      } else {
-	fraction = cluster.energy()/recHitEnergyNorm * vdt::fast_expf( -0.5*d2 );
-      }      
-      fractot += fraction;
-      frac.emplace_back(fraction);
-    }
-    for( unsigned i = 0; i < clusters.size(); ++i ) {      
-      if( fractot > _minFracTot || 
-	  ( refhit->detId() == clusters[i].seed() && fractot > 0.0 ) ) {
-	frac[i]/=fractot;
-      } else {
-	continue;
+      double fractot = 0;
+      for( unsigned i = 0; i < nclus; ++i ) {
+	if( dist2[i] > 100 ) {
+	  LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
+	    << "Warning! :: pfcluster-topocell distance is too large! d= "
+	    << dist2[i];
+	}
+	double fraction;
+	if( hitId[ih] == clusSeed[i] && _excludeOtherSeeds ) {
+	  fraction = 1.0;	
+	} else if ( hitSeedable[ih] && _excludeOtherSeeds ) {
+	  fraction = 0.0;
+	} else {
+	  fraction = clusE[i]/hitNorm[ih] * expo[i];
+	}      
+	fractot += fraction;
+	frac[i] = fraction;
       }
-      // if the fraction has been set to 0, the cell 
-      // is now added to the cluster - careful ! (PJ, 19/07/08)
-      // BUT KEEP ONLY CLOSE CELLS OTHERWISE MEMORY JUST EXPLOSES
-      // (PJ, 15/09/08 <- similar to what existed before the 
-      // previous bug fix, but keeps the close seeds inside, 
-      // even if their fraction was set to zero.)
-      // Also add a protection to keep the seed in the cluster 
-      // when the latter gets far from the former. These cases
-      // (about 1% of the clusters) need to be studied, as 
-      // they create fake photons, in general.
-      // (PJ, 16/09/08) 
-      if( dist2[i] < 100.0 || frac[i] > 0.9999 ) {	
-	clusters[i].addRecHitFraction(reco::PFRecHitFraction(refhit,frac[i]));
+      for( unsigned i = 0; i < nclus; ++i ) {      
+	if( fractot > _minFracTot || 
+	    ( hitId[ih] == clusSeed[i] && fractot > 0.0 ) ) {
+	  frac[i]/=fractot;
+	} else {
+	  continue;
+	}
+	// if the fraction has been set to 0, the cell 
+	// is now added to the cluster - careful ! (PJ, 19/07/08)
+	// BUT KEEP ONLY CLOSE CELLS OTHERWISE MEMORY JUST EXPLOSES
+	// (PJ, 15/09/08 <- similar to what existed before the 
+	// previous bug fix, but keeps the close seeds inside, 
+	// even if their fraction was set to zero.)
+	// Also add a protection to keep the seed in the cluster 
+	// when the latter gets far from the former. These cases
+	// (about 1% of the clusters) need to be studied, as 
+	// they create fake photons, in general.
+	// (PJ, 16/09/08) 
+	if( dist2[i] < 100.0 || frac[i] > 0.9999 ) {	
+	  clusters[i].addRecHitFraction(reco::PFRecHitFraction(topoFractions[ih].recHitRef(),frac[i]));
+	}
       }
     }
-  }
-  // recalculate positions and calculate convergence parameter
-  double diff2 = 0.0;  
-  for( unsigned i = 0; i < clusters.size(); ++i ) {
-    if( _convergencePosCalc ) {
-      _convergencePosCalc->calculateAndSetPosition(clusters[i]);
-    } else {
-      if( clusters.size() == 1 && _allCellsPosCalc ) {
-	_allCellsPosCalc->calculateAndSetPosition(clusters[i]);
+    // recalculate positions and calculate convergence parameter
+    double diff2 = 0.0;  
+    for( unsigned i = 0; i < nclus; ++i ) {
+      if( _convergencePosCalc ) {
+	_convergencePosCalc->calculateAndSetPosition(clusters[i]);
       } else {
-	_positionCalc->calculateAndSetPosition(clusters[i]);
+	if( nclus == 1 && _allCellsPosCalc ) {
+	  _allCellsPosCalc->calculateAndSetPosition(clusters[i]);
+	} else {
+	  _positionCalc->calculateAndSetPosition(clusters[i]);
+	}
       }
+      const double delta2 = 
+	reco::deltaR2(clusters[i].positionREP(),clus_prev_pos[i]);    
+      if( delta2 > diff2 ) diff2 = delta2;
     }
-    const double delta2 = 
-      reco::deltaR2(clusters[i].positionREP(),clus_prev_pos[i]);    
-    if( delta2 > diff2 ) diff2 = delta2;
+    diff = std::sqrt(diff2);
+  }
+}
+
+double Basic2DGenericPFlowClusterizer::
+recHitEnergyNorm(const reco::PFRecHit& hit) const {
+  int cell_layer = (int)hit.layer();
+  if( cell_layer == PFLayer::HCAL_BARREL2 && 
+      std::abs(hit.positionREP().eta()) > 0.34 ) {
+    cell_layer *= 100;
+  }  
+
+  double recHitEnergyNorm=0.;
+  auto const& recHitEnergyNormDepthPair = _recHitEnergyNorms.find(cell_layer)->second;
+
+  for (unsigned int j=0; j<recHitEnergyNormDepthPair.second.size(); ++j) {
+    int depth=recHitEnergyNormDepthPair.first[j];
+
+    if( ( cell_layer == PFLayer::HCAL_BARREL1 && hit.depth()== depth)
+	|| ( cell_layer == PFLayer::HCAL_ENDCAP && hit.depth()== depth)
+	|| ( cell_layer != PFLayer::HCAL_ENDCAP && cell_layer != PFLayer::HCAL_BARREL1)
+	) recHitEnergyNorm = recHitEnergyNormDepthPair.second[j];
   }
-  diff = std::sqrt(diff2);
-  dist2.clear(); frac.clear(); clus_prev_pos.clear();// avoid badness
-  growPFClusters(topo,seedable,toleranceScaling,iter+1,diff,clusters);
+  return recHitEnergyNorm;
 }
 
 void Basic2DGenericPFlowClusterizer::
@@ -44,9 +44,11 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
   void growPFClusters(const reco::PFCluster&,
 		      const std::vector<bool>&,
 		      const unsigned toleranceScaling,
-		      const unsigned iter,
+		      unsigned iter,
 		      double dist,
 		      reco::PFClusterCollection&) const;
+
+  double recHitEnergyNorm(const reco::PFRecHit&) const;
   
   void prunePFClusters(reco::PFClusterCollection&) const;
 };
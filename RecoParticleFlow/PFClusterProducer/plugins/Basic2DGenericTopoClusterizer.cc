@@ -32,6 +32,8 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
   std::sort(seeds.begin(),seeds.end(),
             [&](unsigned int i, unsigned int j) { return hits[i].energy()>hits[j].energy();});  
   
+  _passThresholds.assign(hits.size(),kUnknown);
+
   reco::PFCluster temp;
   for( auto seed : seeds ) {    
     if( !rechitMask[seed] || !seedable[seed] || used[seed] ) continue;    
@@ -41,13 +43,8 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
   }
 }
 
-void Basic2DGenericTopoClusterizer::
-buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
-		 const std::vector<bool>& rechitMask,
-		 unsigned int kcell,
-		 std::vector<bool>& used,		 
-		 reco::PFCluster& topocluster) {
-  auto const & cell = (*input)[kcell];
+bool Basic2DGenericTopoClusterizer::
+passThresholds(const reco::PFRecHit& cell) const {
   int cell_layer = (int)cell.layer();
   if( cell_layer == PFLayer::HCAL_BARREL2 && 
       std::abs(cell.positionREP().eta()) > 0.34 ) {
@@ -68,34 +65,58 @@ buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
 
   }
 
-  if( cell.energy() < thresholdE ||
-      cell.pt2() < thresholdPT2  ) {
-    LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
-      << "RecHit " << cell.detId() << " with enegy "
-      << cell.energy() << " GeV was rejected!." << std::endl;
-    return;
-  }
+  return !( cell.energy() < thresholdE || cell.pt2() < thresholdPT2 );
+}
+
+// depth-first traversal with an explicit stack, the hits are added in the
+// same order as with the recursion over the neighbours
+void Basic2DGenericTopoClusterizer::
+buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
+		 const std::vector<bool>& rechitMask,
+		 unsigned int kcell,
+		 std::vector<bool>& used,		 
+		 reco::PFCluster& topocluster) {
+  auto const & hits = *input;
 
+  // a hit that fails the thresholds is not used and may be reached again
+  auto visit = [&](unsigned int k) {
+    auto const & cell = hits[k];
+    if( _passThresholds[k] == kUnknown ) 
+      _passThresholds[k] = passThresholds(cell) ? kPass : kFail;
+    if( _passThresholds[k] == kFail ) {
+      LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
+	<< "RecHit " << cell.detId() << " with enegy "
+	<< cell.energy() << " GeV was rejected!." << std::endl;
+      return;
+    }
+    used[k] = true;
+    auto ref = makeRefhit(input,k);
+    topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
+    _stack.push_back({k,0});
+  };
 
-  auto k = kcell;
-  used[k] = true;
-  auto ref = makeRefhit(input,k);
-  topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
-  
-  auto const & neighbours = 
-    ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
-  
-  for( auto nb : neighbours ) {
+  _stack.clear();
+  visit(kcell);
+  while( !_stack.empty() ) {
+    auto & frame = _stack.back();
+    auto const & cell = hits[frame.hit];
+    auto const & neighbours = 
+      ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
+    if( frame.next == neighbours.size() ) {
+      _stack.pop_back();
+      continue;
+    }
+    auto nb = neighbours.begin()[frame.next++];
     if( used[nb] || !rechitMask[nb] ) {
       LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
       	<< "  RecHit " << cell.detId() << "\'s" 
-	<< " neighbor RecHit " << input->at(nb).detId() 
+	<< " neighbor RecHit " << hits[nb].detId() 
 	<< " with enegy " 
-	<< input->at(nb).energy() << " GeV was rejected!" 
+	<< hits[nb].energy() << " GeV was rejected!" 
 	<< " Reasons : " << used[nb] << " (used) " 
 	<< !rechitMask[nb] << " (masked)." << std::endl;
       continue;
     }
-    buildTopoCluster(input,rechitMask,nb,used,topocluster);
+    visit(nb); // may reallocate the stack, frame is not used after this
   }
 }
@@ -22,6 +22,14 @@ class Basic2DGenericTopoClusterizer : public InitialClusteringStepBase {
   
  private:  
   const bool _useCornerCells;
+
+  // per-event scratch, indexed by rechit
+  enum ThresholdState : char { kUnknown = 0, kPass, kFail };
+  std::vector<char> _passThresholds;
+  struct Frame { unsigned int hit; unsigned int next; }; // hit and next neighbour to visit
+  std::vector<Frame> _stack;
+
+  bool passThresholds(const reco::PFRecHit&) const;
   void buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>&,
 			const std::vector<bool>&, // masked rechits
 			unsigned int, //present rechit
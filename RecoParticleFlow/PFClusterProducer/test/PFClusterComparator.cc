@@ -23,12 +23,18 @@ PFClusterComparator::PFClusterComparator(const edm::ParameterSet& iConfig) {
   inputTagPFClustersCompare_ 
     = iConfig.getParameter<InputTag>("PFClustersCompare");
 
+  tokenPFClusters_ = consumes<PFClusterCollection>(inputTagPFClusters_);
+  tokenPFClustersCompare_ = consumes<PFClusterCollection>(inputTagPFClustersCompare_);
+
   verbose_ = 
     iConfig.getUntrackedParameter<bool>("verbose",false);
 
   printBlocks_ = 
     iConfig.getUntrackedParameter<bool>("printBlocks",false);
 
+  failOnDifference_ = 
+    iConfig.getUntrackedParameter<bool>("failOnDifference",false);
+
   log10E_old = fs_->make<TH1F>("log10E_old","log10(E cluster)",500,-5,5);
   log10E_new = fs_->make<TH1F>("log10E_new","log10(E cluster)",500,-5,5);
   deltaEnergy = fs_->make<TH1F>("delta_energy","E_{old} - E_{new}",5000,-5,5);
@@ -65,16 +71,19 @@ PFClusterComparator::beginRun(const edm::Run& run,
 void PFClusterComparator::analyze(const Event& iEvent, 
 				  const EventSetup& iSetup) {
   std::map<unsigned,unsigned> detId_count;
+  unsigned nDifferences = 0;
     
   // get PFClusters
 
   Handle<PFClusterCollection> pfClusters;
   fetchCandidateCollection(pfClusters, 
+			   tokenPFClusters_, 
 			   inputTagPFClusters_, 
 			   iEvent );
 
   Handle<PFClusterCollection> pfClustersCompare;
   fetchCandidateCollection(pfClustersCompare, 
+			   tokenPFClustersCompare_, 
 			   inputTagPFClustersCompare_, 
 			   iEvent );
 
@@ -82,6 +91,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
   
   std::cout << "There are " << pfClusters->size() << " PFClusters in the original cluster collection." << std::endl;
   std::cout << "There are " << pfClustersCompare->size() << " PFClusters in the new cluster collection." << std::endl;
+  if( pfClusters->size() != pfClustersCompare->size() ) ++nDifferences;
   
   std::cout << std::flush << "---- COMPARING OLD TO NEW ----"
 	    << std::endl  << std::flush;
@@ -112,6 +122,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
 	deltaZ->Fill((cluster.position().z() - clustercomp.position().z())/cluster.position().z());
 	
 	if( denergy/std::abs(cluster.energy()) >  1e-5 ) {
+	  ++nDifferences;
 	  std::cout << "   " << cluster.seed() 
 		    << " Energies different by larger than tolerance! "
 		    << "( "<< denergy << " )"
@@ -121,6 +132,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
 		    << clustercomp.energy() << " GeV" << std::endl;	  
 	}
 	if( dcenergy/std::abs(cluster.correctedEnergy()) >  1e-5 ) {
+	  ++nDifferences;
 	  std::cout << "   " << cluster.seed() 
 		    << " Corrected energies different by larger than tolerance! "
 		    << "( "<< dcenergy << " )"
@@ -131,6 +143,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
 	}
 	std::cout << std::flush;
 	if( dx/std::abs(cluster.position().x()) > 1e-5 ) {
+	  ++nDifferences;
 	  std::cout << "***" << cluster.seed() 
 		    << " X's different by larger than tolerance! "
 		    << "( "<< dx << " )"
@@ -141,6 +154,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
 	}
 	std::cout << std::flush;
 	if( dy/std::abs(cluster.position().y()) > 1e-5 ) {
+	  ++nDifferences;
 	  std::cout << "---" << cluster.seed() 
 		    << " Y's different by larger than tolerance! "
 		    << "( "<< dy << " )"
@@ -151,6 +165,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
 	}
 	std::cout << std::flush;
 	if( dz/std::abs(cluster.position().z()) > 1e-5 ) {
+	  ++nDifferences;
 	  std::cout << "+++" << cluster.seed() 
 		    << " Z's different by larger than tolerance! "
 		    << "( "<< dz << " )"
@@ -163,6 +178,7 @@ void PFClusterComparator::analyze(const Event& iEvent,
       }      
     }
     if( !foundmatch ) {      
+      ++nDifferences;
       std::cout << "Seed in old clusters and not new: " 
 		<< cluster << std::endl;
     }
@@ -184,21 +200,29 @@ void PFClusterComparator::analyze(const Event& iEvent,
       }      
     }
     if( !foundmatch ) {      
+      ++nDifferences;
       std::cout << "Seed in new clusters and not old: " 
 		<< cluster << std::endl;
     }
   }
   std::cout << std::flush;
+
+  if( failOnDifference_ && nDifferences > 0 ) {
+    throw cms::Exception("PFClusterComparator")
+      << nDifferences << " differences between the PFClusters "
+      << inputTagPFClusters_ << " and " << inputTagPFClustersCompare_;
+  }
 }
 
 
   
 void 
 PFClusterComparator::fetchCandidateCollection(Handle<reco::PFClusterCollection>& c, 
+					    const EDGetTokenT<reco::PFClusterCollection>& token, 
 					    const InputTag& tag, 
 					    const Event& iEvent) const {
   
-  bool found = iEvent.getByLabel(tag, c);
+  bool found = iEvent.getByToken(token, c);
   
   if(!found ) {
     ostringstream  err;
@@ -40,6 +40,7 @@ class PFClusterComparator : public edm::EDAnalyzer {
   
   void 
     fetchCandidateCollection(edm::Handle<reco::PFClusterCollection>& c, 
+			     const edm::EDGetTokenT<reco::PFClusterCollection>& token, 
 			     const edm::InputTag& tag, 
 			     const edm::Event& iSetup) const;
 
@@ -51,6 +52,8 @@ class PFClusterComparator : public edm::EDAnalyzer {
   /// PFClusters in which we'll look for pile up particles 
   edm::InputTag   inputTagPFClusters_;
   edm::InputTag   inputTagPFClustersCompare_;
+  edm::EDGetTokenT<reco::PFClusterCollection> tokenPFClusters_;
+  edm::EDGetTokenT<reco::PFClusterCollection> tokenPFClustersCompare_;
   
   edm::Service<TFileService> fs_;
   TH1F *log10E_old, *log10E_new, *deltaEnergy;
@@ -65,6 +68,9 @@ class PFClusterComparator : public edm::EDAnalyzer {
   /// print the blocks associated to a given candidate ?
   bool   printBlocks_;
 
+  /// throw if the collections differ ?
+  bool   failOnDifference_;
+
 };
 
 #endif
@@ -1,62 +1,54 @@
 import FWCore.ParameterSet.Config as cms
 
-process = cms.Process("ANALYSIS")
-process.maxEvents = cms.untracked.PSet(
-    input = cms.untracked.int32(-1)
-    )
-process.source = cms.Source(
-    "PoolSource",
-    secondaryFileNames = cms.untracked.vstring(
-    '/store/relval/CMSSW_7_1_0_pre3/RelValTTbar_13/GEN-SIM-RECO/POSTLS171_V1-v1/00000/76897917-C0A1-E311-A852-02163E00EA9A.root',
-    '/store/relval/CMSSW_7_1_0_pre3/RelValTTbar_13/GEN-SIM-RECO/POSTLS171_V1-v1/00000/7AAC4BC0-C3A1-E311-A8BF-02163E00EAEA.root',
-    '/store/relval/CMSSW_7_1_0_pre3/RelValTTbar_13/GEN-SIM-RECO/POSTLS171_V1-v1/00000/9C3661D6-C3A1-E311-BC51-02163E00E997.root',
-    '/store/relval/CMSSW_7_1_0_pre3/RelValTTbar_13/GEN-SIM-RECO/POSTLS171_V1-v1/00000/B660879E-B9A1-E311-BFBE-02163E00A0FF.root'
-    ),
-    fileNames = cms.untracked.vstring(
-    '/store/group/phys_egamma/lgray/TTBarPU25ns_reRECO-step4_RECO_EI/step4_RECO_EI-76897917-C0A1-E311-A852-02163E00EA9A.root',
-    '/store/group/phys_egamma/lgray/TTBarPU25ns_reRECO-step4_RECO_EI/step4_RECO_EI-7AAC4BC0-C3A1-E311-A8BF-02163E00EAEA.root',
-    '/store/group/phys_egamma/lgray/TTBarPU25ns_reRECO-step4_RECO_EI/step4_RECO_EI-9C3661D6-C3A1-E311-BC51-02163E00E997.root',
-    '/store/group/phys_egamma/lgray/TTBarPU25ns_reRECO-step4_RECO_EI/step4_RECO_EI-B660879E-B9A1-E311-BFBE-02163E00A0FF.root'
-    )
-    #dropDescendantsOfDroppedBranches=cms.untracked.bool(False),
-    #inputCommands=cms.untracked.vstring(
-    #'keep *',
-    #'drop recoPFRecHits_*_*_*'
-    #)
-)
-
-process.TFileService = cms.Service('TFileService',
-                                   fileName = cms.string('clusterValid_ttbar.root')
-                                   )
+# Reruns the PF rechits and clusters from the calorimeter rechits of a RECO
+# file, once with the production clusterizers and once with the previous
+# recursive implementations (Basic2DGeneric*Reference plugins of this
+# directory), and fails if the PFClusters differ.
 
-process.preshowerClusterCompare = cms.EDAnalyzer(
-    "PFClusterComparator",
-    PFClusters = cms.InputTag("particleFlowClusterPS",'','RECO'),
-    PFClustersCompare = cms.InputTag("particleFlowClusterPS",'','reRECO'),
-    verbose = cms.untracked.bool(True),
-    printBlocks = cms.untracked.bool(True)
-)
+from Configuration.StandardSequences.Eras import eras
+process = cms.Process("ANALYSIS",eras.Run2_2017)
 
-process.ecalClusterCompare = cms.EDAnalyzer(
-    "PFClusterComparator",
-    PFClusters = cms.InputTag("particleFlowClusterECAL",'','RECO'),
-    PFClustersCompare = cms.InputTag("particleFlowClusterECAL",'','reRECO'),
-    verbose = cms.untracked.bool(True),
-    printBlocks = cms.untracked.bool(True)
-)
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(100)
+    )
 
-process.hcalClusterCompare = cms.EDAnalyzer(
-    "PFClusterComparator",
-    PFClusters = cms.InputTag("particleFlowClusterHCAL",'','RECO'),
-    PFClustersCompare = cms.InputTag("particleFlowClusterHCAL",'','reRECO'),
-    verbose = cms.untracked.bool(True),
-    printBlocks = cms.untracked.bool(True)
+from PhysicsTools.PatAlgos.patInputFiles_cff import filesRelValTTbarGENSIMRECO
+process.source = cms.Source("PoolSource",
+                            fileNames = filesRelValTTbarGENSIMRECO
 )
 
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
 
+process.load("RecoParticleFlow.PFClusterProducer.particleFlowCluster_cff")
 
-process.p = cms.Path( process.preshowerClusterCompare +
-                      process.ecalClusterCompare      +
-                      process.hcalClusterCompare        )
-
+process.TFileService = cms.Service('TFileService',
+                                   fileName = cms.string('clusterValid_ttbar.root')
+                                   )
 
+process.p = cms.Path( process.particleFlowRecHitECAL +
+                      process.particleFlowRecHitPS   +
+                      process.particleFlowRecHitHBHE +
+                      process.particleFlowRecHitHO   +
+                      process.particleFlowRecHitHF     )
+
+for name in ['ECALUncorrected','PS','HBHE','HO','HF']:
+    clusters = getattr(process,'particleFlowCluster'+name)
+    reference = clusters.clone()
+    reference.initialClusteringStep.algoName = 'Basic2DGenericTopoClusterizerReference'
+    reference.pfClusterBuilder.algoName = 'Basic2DGenericPFlowClusterizerReference'
+    setattr(process,'particleFlowCluster'+name+'Reference',reference)
+    compare = cms.EDAnalyzer(
+        "PFClusterComparator",
+        PFClusters = cms.InputTag('particleFlowCluster'+name+'Reference'),
+        PFClustersCompare = cms.InputTag('particleFlowCluster'+name),
+        verbose = cms.untracked.bool(True),
+        printBlocks = cms.untracked.bool(True),
+        failOnDifference = cms.untracked.bool(True)
+        )
+    setattr(process,'compareClusters'+name,compare)
+    process.p += clusters + reference + compare
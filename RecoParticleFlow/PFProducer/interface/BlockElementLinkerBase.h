@@ -22,6 +22,36 @@ class BlockElementLinkerBase {
   virtual double testLink( const reco::PFBlockElement*,
 			   const reco::PFBlockElement* ) const = 0;
 
+  // optional eta-phi window for the link candidate search: when a linker
+  // returns true, testLink can only succeed for elements whose linkPosition
+  // differ by less than deltaEta in eta and deltaPhi in phi
+  virtual bool linkWindow( double& deltaEta, double& deltaPhi ) const
+  { return false; }
+
+  // position of an element used with linkWindow; false if the element has
+  // none, it is then tested against all the elements of the other type
+  virtual bool linkPosition( const reco::PFBlockElement*,
+			     double& eta, double& phi ) const
+  { return false; }
+
+  // optional per-element prefilter for the link candidate search: false if
+  // testLink cannot succeed between this element and any other one
+  virtual bool linkCandidate( const reco::PFBlockElement* ) const
+  { return true; }
+
+  // optional link candidates from the KD-tree: when a linker returns true
+  // for one of its two types, testLink can only succeed if the (valid)
+  // multilinks of the element of this type contain the multilinkKey of the
+  // other element
+  virtual bool multilinksCarrier( reco::PFBlockElement::Type ) const
+  { return false; }
+
+  // (phi, eta) under which an element is listed in the multilinks of the
+  // carrier; false if it can't be listed
+  virtual bool multilinkKey( const reco::PFBlockElement*,
+			     double& phi, double& eta ) const
+  { return false; }
+
   const std::string& name() const { return _linkerName; }
   
  private:
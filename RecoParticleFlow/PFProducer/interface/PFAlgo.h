@@ -65,6 +65,12 @@ class PFAlgo {
   void setMuonHandle(const edm::Handle<reco::MuonCollection>&);
   void setDebug( bool debug ) {debug_ = debug; connector_.setDebug(debug_);}
 
+  /// process the blocks concurrently, each into its own candidate buffer,
+  /// the buffers being concatenated in the order of the serial processing.
+  /// Not used with the PFElectronAlgo or PFPhotonAlgo, which keep state 
+  /// between blocks, or in debug mode. processBlock is not called in this mode.
+  void setParallelBlocks( bool parallel ) {parallelBlocks_ = parallel;}
+
   void setParameters(double nSigmaECAL,
                      double nSigmaHCAL, 
                      const boost::shared_ptr<PFEnergyCalibration>& calibration,
@@ -244,11 +250,19 @@ class PFAlgo {
   virtual void processBlock( const reco::PFBlockRef& blockref,
                              std::list<reco::PFBlockRef>& hcalBlockRefs, 
                              std::list<reco::PFBlockRef>& ecalBlockRefs ); 
+
+  /// reconstruct the particles of one block, adding them to pfCandidates
+  void reconstructBlock( const reco::PFBlockRef& blockref,
+                         reco::PFCandidateCollection& pfCandidates );
+
+  /// reconstruct the blocks concurrently, see setParallelBlocks
+  void reconstructBlocksParallel( const std::vector<reco::PFBlockRef>& blockRefs );
   
   /// Reconstruct a charged particle from a track
-  /// Returns the index of the newly created candidate in pfCandidates_
+  /// Returns the index of the newly created candidate in pfCandidates
   /// Michalis added a flag here to treat muons inside jets
-  unsigned reconstructTrack( const reco::PFBlockElement& elt,bool allowLoose= false);
+  unsigned reconstructTrack( reco::PFCandidateCollection& pfCandidates,
+                             const reco::PFBlockElement& elt,bool allowLoose= false);
 
   /// Reconstruct a neutral particle from a cluster. 
   /// If chargedEnergy is specified, the neutral 
@@ -256,7 +270,8 @@ class PFAlgo {
   /// larger than the chargedEnergy. In this case, the energy of the 
   /// neutral particle is cluster energy - chargedEnergy
 
-  unsigned reconstructCluster( const reco::PFCluster& cluster,
+  unsigned reconstructCluster( reco::PFCandidateCollection& pfCandidates,
+                               const reco::PFCluster& cluster,
                                double particleEnergy,
 			       bool useDirection = false,
 			       double particleX=0.,
@@ -335,6 +350,7 @@ class PFAlgo {
   bool               useHO_;
   int                algo_;
   bool               debug_;
+  bool               parallelBlocks_;
 
   /// Variables for PFElectrons
   std::string mvaWeightFileEleID_;
@@ -123,6 +123,11 @@ class PFBlockAlgo {
 
   /// sets debug printout flag
   void setDebug( bool debug ) {debug_ = debug;}
+
+  /// find the link candidates of each element (from the KD-tree multilinks,
+  /// or with eta-phi grids where the linkers define a window), test them and
+  /// build the blocks concurrently
+  void setParallelLinking( bool parallel ) {parallelLinking_ = parallel;}
   
   /// \return collection of blocks
   /*   const  reco::PFBlockCollection& blocks() const {return *blocks_;} */
@@ -136,6 +141,13 @@ class PFBlockAlgo {
   
  private:
   
+  /// findBlocks with setParallelLinking(true): the blocks are ordered by
+  /// their first element, and the elements within a block by index
+  void findBlocksParallel();
+
+  /// fill a block with the given elements, in this order
+  void buildBlock(reco::PFBlock& block, const std::vector<unsigned>& elements) const;
+
   /// compute missing links in the blocks 
   /// (the recursive procedure does not build all links)  
   void packLinks(reco::PFBlock& block, 
@@ -161,6 +173,8 @@ class PFBlockAlgo {
   
   /// if true, debug printouts activated
   bool   debug_;
+
+  bool   parallelLinking_;
   
   friend std::ostream& operator<<(std::ostream&, const PFBlockAlgo&);
   bool useHO_;
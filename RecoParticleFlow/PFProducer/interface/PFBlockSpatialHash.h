@@ -0,0 +1,68 @@
+#ifndef RecoParticleFlow_PFProducer_PFBlockSpatialHash_h
+#define RecoParticleFlow_PFProducer_PFBlockSpatialHash_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// \brief Eta-phi grid used by PFBlockAlgo to find the link candidates
+/*!
+  Cells are at least as large as the (deltaEta, deltaPhi) window of the linker,
+  so that two positions closer than the window are always in the same or in
+  adjacent cells (phi wraps around). The entries are sorted by cell once after
+  all insertions, a query visits the (up to) 3x3 cells around a position.
+*/
+
+class PFBlockSpatialHash {
+
+ public:
+  PFBlockSpatialHash(double deltaEta, double deltaPhi) {
+    // a small margin, the grid is only a prefilter
+    cellEta_ = 1.001*deltaEta;
+    nPhi_ = std::max(1, int(2.*M_PI/(1.001*deltaPhi)));
+    if( nPhi_ < 3 ) nPhi_ = 1;
+    cellPhi_ = 2.*M_PI/nPhi_;
+  }
+
+  void insert(unsigned index, double eta, double phi) {
+    entries_.emplace_back(key(etaBin(eta),phiBin(phi)),index);
+  }
+
+  /// to be called after the last insert and before the first query
+  void build() { std::sort(entries_.begin(),entries_.end()); }
+
+  /// calls f(index) for the entries in the cells around (eta, phi)
+  template<typename F>
+  void forEachNeighbour(double eta, double phi, F f) const {
+    const int ieta = etaBin(eta);
+    const int iphi = phiBin(phi);
+    const int nPhiNeighbours = std::min(3,nPhi_);
+    for( int deta = -1; deta <= 1; ++deta ) {
+      for( int dphi = 0; dphi < nPhiNeighbours; ++dphi ) {
+        const int jphi = (iphi + dphi - nPhiNeighbours/2 + nPhi_) % nPhi_;
+        const int64_t k = key(ieta+deta,jphi);
+        auto first = std::lower_bound(entries_.begin(),entries_.end(),
+                                      std::make_pair(k,0u));
+        for( ; first != entries_.end() && first->first == k; ++first ) {
+          f(first->second);
+        }
+      }
+    }
+  }
+
+ private:
+  int etaBin(double eta) const { return int(std::floor(eta/cellEta_)); }
+  int phiBin(double phi) const {
+    const int bin = int(std::floor((phi+M_PI)/cellPhi_)) % nPhi_;
+    return bin < 0 ? bin + nPhi_ : bin;
+  }
+  int64_t key(int ieta, int iphi) const { return int64_t(ieta)*nPhi_ + iphi; }
+
+  double cellEta_, cellPhi_;
+  int nPhi_;
+  std::vector<std::pair<int64_t,unsigned> > entries_;
+};
+
+#endif
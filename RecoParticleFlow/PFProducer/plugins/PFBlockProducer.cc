@@ -26,6 +26,10 @@ PFBlockProducer::PFBlockProducer(const edm::ParameterSet& iConfig) {
   bool debug_ = 
     iConfig.getUntrackedParameter<bool>("debug",false);  
   pfBlockAlgo_.setDebug(debug_);  
+
+  const bool parallelLinking = 
+    iConfig.existsAs<bool>("parallelLinking") && iConfig.getParameter<bool>("parallelLinking");
+  pfBlockAlgo_.setParallelLinking(parallelLinking);
       
   edm::ConsumesCollector coll = consumesCollector();
   const std::vector<edm::ParameterSet>& importers
@@ -48,6 +48,12 @@ PFCandidateChecker::PFCandidateChecker(const edm::ParameterSet& iConfig) {
   rankByPt_ = 
     iConfig.getUntrackedParameter<bool>("rankByPt",false);
 
+  failOnDifference_ = 
+    iConfig.getUntrackedParameter<bool>("failOnDifference",false);
+
+  compareElementsInBlocks_ = 
+    iConfig.getUntrackedParameter<bool>("compareElementsInBlocks",false);
+
   entry_ = 0;
 
 
@@ -101,14 +107,16 @@ PFCandidateChecker::analyze(const Event& iEvent,
       sort(pfReReco.begin(),pfReReco.end(),greaterPt);
     }
   
-  unsigned minSize = pfReco.size() < pfReReco.size() ? pfReco.size() : pfReReco.size();
+  const unsigned sizeReco = pfCandidatesReco->size();
+  const unsigned sizeReReco = pfCandidatesReReco->size();
+  unsigned minSize = sizeReco < sizeReReco ? sizeReco : sizeReReco;
   bool differentCand = false;
-  bool differentSize = pfReco.size() != pfReReco.size();
+  bool differentSize = sizeReco != sizeReReco;
   if ( differentSize ) 
     std::cout << "+++WARNING+++ PFCandidate size changed for entry " 
 	      << entry_ << " !" << endl
-	      << " - RECO    size : " << pfReco.size() << endl 
-	      << " - Re-RECO size : " << pfReReco.size() << endl;
+	      << " - RECO    size : " << sizeReco << endl 
+	      << " - Re-RECO size : " << sizeReReco << endl;
 
   unsigned npr = 0;
   for( unsigned i=0; i<minSize; i++ ) {
@@ -119,9 +127,14 @@ PFCandidateChecker::analyze(const Event& iEvent,
     double deltaE = (candReReco.energy()-candReco.energy())/(candReReco.energy()+candReco.energy());
     double deltaEta = candReReco.eta()-candReco.eta();
     double deltaPhi = candReReco.phi()-candReco.phi();
+    bool differentId = candReReco.charge() != candReco.charge() ||
+      candReReco.pdgId() != candReco.pdgId();
+    bool differentElements = compareElementsInBlocks_ &&
+      !sameElementsInBlocks(candReco, candReReco);
     if ( fabs(deltaE) > deltaEMax_ ||
 	 fabs(deltaEta) > deltaEtaMax_ ||
-	 fabs(deltaPhi) > deltaPhiMax_ ) { 
+	 fabs(deltaPhi) > deltaPhiMax_ ||
+	 differentId || differentElements ) { 
       differentCand = true;
       std::cout << "+++WARNING+++ PFCandidate " << i 
 		<< " changed  for entry " << entry_ << " ! " << std::endl 
@@ -129,7 +142,13 @@ PFCandidateChecker::analyze(const Event& iEvent,
 		<< " - Re-RECO  : " << candReReco << std::endl
 		<< " DeltaE   = : " << deltaE << std::endl
 		<< " DeltaEta = : " << deltaEta << std::endl
-		<< " DeltaPhi = : " << deltaPhi << std::endl << std::endl;
+		<< " DeltaPhi = : " << deltaPhi << std::endl;
+      if ( differentId ) 
+	std::cout << " Charge   = : " << candReco.charge() << " -> " << candReReco.charge() << std::endl
+		  << " PdgId    = : " << candReco.pdgId() << " -> " << candReReco.pdgId() << std::endl;
+      if ( differentElements ) 
+	std::cout << " Elements in blocks differ" << std::endl;
+      std::cout << std::endl;
       if (printBlocks_) {
 	std::cout << "Elements in Block for RECO: " <<std::endl;
 	printElementsInBlocks(candReco);
@@ -141,8 +160,13 @@ PFCandidateChecker::analyze(const Event& iEvent,
   }
   
   if ( differentSize || differentCand ) { 
-    printJets(*pfJetsReco, *pfJetsReReco);
-    printMet(pfReco, pfReReco);
+    if ( pfJetsReco.isValid() && pfJetsReReco.isValid() )
+      printJets(*pfJetsReco, *pfJetsReReco);
+    printMet(*pfCandidatesReco, *pfCandidatesReReco);
+    if ( failOnDifference_ )
+      throw cms::Exception("PFCandidateChecker")
+	<< "different candidates in " << inputTagPFCandidatesReco_ 
+	<< " and " << inputTagPFCandidatesReReco_ << " for entry " << entry_;
   }
 
   ++entry_;
@@ -211,6 +235,20 @@ void PFCandidateChecker::printJets(const PFJetCollection& pfJetsReco,
 }
 
 
+bool PFCandidateChecker::sameElementsInBlocks(const PFCandidate& candReco,
+					       const PFCandidate& candReReco) const {
+
+  const PFCandidate::ElementsInBlocks& elementsReco = candReco.elementsInBlocks();
+  const PFCandidate::ElementsInBlocks& elementsReReco = candReReco.elementsInBlocks();
+  if ( elementsReco.size() != elementsReReco.size() ) return false;
+  for ( unsigned i = 0; i < elementsReco.size(); ++i ) {
+    if ( elementsReco[i].first != elementsReReco[i].first ||
+	 elementsReco[i].second != elementsReReco[i].second ) return false;
+  }
+  return true;
+}
+
+
 void PFCandidateChecker::printElementsInBlocks(const PFCandidate& cand,
 						ostream& out) const {
   if(!out) return;
@@ -50,6 +50,9 @@ class PFCandidateChecker : public edm::stream::EDAnalyzer<> {
   void printElementsInBlocks(const reco::PFCandidate& cand,
 			     std::ostream& out=std::cout) const;
 
+  bool sameElementsInBlocks(const reco::PFCandidate& candReco,
+			    const reco::PFCandidate& candReReco) const;
+
 
   
   /// PFCandidates in which we'll look for pile up particles 
@@ -72,6 +75,13 @@ class PFCandidateChecker : public edm::stream::EDAnalyzer<> {
   /// rank the candidates by Pt
   bool rankByPt_;
 
+  /// throw on the first event with different candidates ?
+  bool failOnDifference_;
+
+  /// compare the block elements of the candidates ?
+  /// (only meaningful if both collections are made from the same blocks)
+  bool compareElementsInBlocks_;
+
   /// Counter
   unsigned entry_;
 
@@ -399,6 +399,10 @@ PFProducer::PFProducer(const edm::ParameterSet& iConfig) {
 
   pfAlgo_->setDebug( debug_ );
 
+  const bool parallelBlocks = 
+    iConfig.existsAs<bool>("parallelBlocks") && iConfig.getParameter<bool>("parallelBlocks");
+  pfAlgo_->setParallelBlocks( parallelBlocks );
+
 }
 
 
@@ -14,6 +14,15 @@ public:
   ( const reco::PFBlockElement*,
     const reco::PFBlockElement* ) const override;
 
+  // the link requires a distance below 0.2 between the cluster positions
+  bool linkWindow(double& deltaEta, double& deltaPhi) const override {
+    deltaEta = deltaPhi = 0.2;
+    return true;
+  }
+
+  bool linkPosition(const reco::PFBlockElement* elem,
+                    double& eta, double& phi) const override;
+
 private:
   bool _useKDTree,_debug;
 };
@@ -22,6 +31,16 @@ DEFINE_EDM_PLUGIN(BlockElementLinkerFactory,
 		  ECALAndHCALLinker, 
 		  "ECALAndHCALLinker");
 
+bool ECALAndHCALLinker::linkPosition
+  ( const reco::PFBlockElement* elem, double& eta, double& phi ) const {
+  const reco::PFClusterRef& ref = 
+    static_cast<const reco::PFBlockElementCluster*>(elem)->clusterRef();
+  if( ref.isNull() ) return false;
+  eta = ref->positionREP().Eta();
+  phi = ref->positionREP().Phi();
+  return true;
+}
+
 double ECALAndHCALLinker::testLink
   ( const reco::PFBlockElement* elem1,
     const reco::PFBlockElement* elem2) const {  
@@ -16,6 +16,15 @@ public:
   double testLink( const reco::PFBlockElement*,
 		   const reco::PFBlockElement* ) const override;
 
+  // the KD-tree lists the linked ECAL clusters in the PS clusters
+  bool multilinksCarrier( reco::PFBlockElement::Type type ) const override {
+    return _useKDTree && ( type == reco::PFBlockElement::PS1 ||
+			   type == reco::PFBlockElement::PS2 );
+  }
+
+  bool multilinkKey( const reco::PFBlockElement* elem,
+		     double& phi, double& eta ) const override;
+
 private:
   bool _useKDTree,_debug;
 };
@@ -44,6 +53,17 @@ linkPrefilter( const reco::PFBlockElement* elem1,
   return (_useKDTree ? result : true);
 }
 
+bool PreshowerAndECALLinker::
+multilinkKey( const reco::PFBlockElement* elem,
+	      double& phi, double& eta ) const {
+  const reco::PFClusterRef& ecalref = 
+    static_cast<const reco::PFBlockElementCluster*>(elem)->clusterRef();
+  if( ecalref.isNull() ) return false;
+  phi = ecalref->positionREP().Phi();
+  eta = ecalref->positionREP().Eta();
+  return true;
+}
+
 double PreshowerAndECALLinker::
 testLink( const reco::PFBlockElement* elem1,
 	  const reco::PFBlockElement* elem2) const {  
@@ -17,6 +17,14 @@ public:
   double testLink( const reco::PFBlockElement*,
 		   const reco::PFBlockElement* ) const override;
 
+  // the KD-tree lists the linked ECAL clusters in the tracks
+  bool multilinksCarrier( reco::PFBlockElement::Type type ) const override {
+    return _useKDTree && type == reco::PFBlockElement::TRACK;
+  }
+
+  bool multilinkKey( const reco::PFBlockElement* elem,
+		     double& phi, double& eta ) const override;
+
 private:
   const bool _useKDTree,_debug;
 };
@@ -41,6 +49,17 @@ linkPrefilter( const reco::PFBlockElement* elem1,
   return (_useKDTree ? result : true);  
 }
 
+bool TrackAndECALLinker::
+multilinkKey( const reco::PFBlockElement* elem,
+	      double& phi, double& eta ) const {
+  const reco::PFClusterRef& clusterref = 
+    static_cast<const reco::PFBlockElementCluster*>(elem)->clusterRef();
+  if( clusterref.isNull() ) return false;
+  phi = clusterref->positionREP().Phi();
+  eta = clusterref->positionREP().Eta();
+  return true;
+}
+
 double TrackAndECALLinker::
 testLink( const reco::PFBlockElement* elem1,
 	  const reco::PFBlockElement* elem2 ) const {  
@@ -17,6 +17,14 @@ public:
   ( const reco::PFBlockElement*,
     const reco::PFBlockElement* ) const override;
 
+  // the KD-tree lists the linked tracks in the HCAL clusters
+  bool multilinksCarrier( reco::PFBlockElement::Type type ) const override {
+    return _useKDTree && type == reco::PFBlockElement::HCAL;
+  }
+
+  bool multilinkKey( const reco::PFBlockElement* elem,
+		     double& phi, double& eta ) const override;
+
 private:
   bool _useKDTree,_debug;
 };
@@ -25,6 +33,18 @@ DEFINE_EDM_PLUGIN(BlockElementLinkerFactory,
 		  TrackAndHCALLinker, 
 		  "TrackAndHCALLinker");
 
+bool TrackAndHCALLinker::multilinkKey
+  ( const reco::PFBlockElement* elem, double& phi, double& eta ) const {
+  const reco::PFRecTrackRef& trackref = 
+    static_cast<const reco::PFBlockElementTrack*>(elem)->trackRefPF();
+  if( trackref.isNull() ) return false;
+  const reco::PFTrajectoryPoint& tkAtHCALEnt =
+    trackref->extrapolatedPoint( reco::PFTrajectoryPoint::HCALEntrance );
+  phi = tkAtHCALEnt.positionREP().Phi();
+  eta = tkAtHCALEnt.positionREP().Eta();
+  return true;
+}
+
 double TrackAndHCALLinker::testLink
   ( const reco::PFBlockElement* elem1,
     const reco::PFBlockElement* elem2) const {  
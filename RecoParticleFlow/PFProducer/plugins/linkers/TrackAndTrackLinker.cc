@@ -17,6 +17,11 @@ public:
   double testLink( const reco::PFBlockElement*,
 		   const reco::PFBlockElement* ) const override;
 
+  // both tracks need a displaced vertex, conversion or V0
+  bool linkCandidate( const reco::PFBlockElement* elem ) const override {
+    return elem->isLinkedToDisplacedVertex();
+  }
+
 private:
   bool _useKDTree,_debug;
 };
@@ -6,6 +6,10 @@ particleFlowBlock = cms.EDProducer(
     verbose = cms.untracked.bool(False),
     # Debug flag
     debug = cms.untracked.bool(False),
+    # link candidates of each element from the KD-tree multilinks or eta-phi
+    # grids, concurrent link tests and block building; the blocks are then
+    # ordered by their first element
+    parallelLinking = cms.bool(False),
     
     #define what we are importing into particle flow
     #from the various subdetectors
@@ -16,6 +16,9 @@ particleFlowTmp = cms.EDProducer("PFProducer",
     # Algorithm type ?
     algoType = cms.uint32(0),
 
+    # reconstruct the blocks concurrently, the candidates keep the serial order
+    parallelBlocks = cms.bool(False),
+
     # Verbose and debug flags
     verbose = cms.untracked.bool(False),
     debug = cms.untracked.bool(False),
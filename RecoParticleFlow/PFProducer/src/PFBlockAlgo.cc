@@ -1,5 +1,6 @@
 #include "RecoParticleFlow/PFProducer/interface/PFBlockAlgo.h"
 #include "RecoParticleFlow/PFProducer/interface/Utils.h"
+#include "RecoParticleFlow/PFProducer/interface/PFBlockSpatialHash.h"
 #include "RecoParticleFlow/PFClusterTools/interface/LinkByRecHit.h"
 #include "DataFormats/ParticleFlowReco/interface/PFBlock.h"
 #include "DataFormats/TrackReco/interface/Track.h"
@@ -9,8 +10,13 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
+#include <tuple>
 #include "TMath.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 using namespace std;
 using namespace reco;
 
@@ -58,6 +64,91 @@ namespace {
       --count_;
     }
   };
+
+  // candidate partners of the elements of one type (the drivers) among the
+  // elements of the other type linked by a linker, see findBlocksParallel:
+  // - from the KD-tree multilinks of the drivers if the linker uses them,
+  // - within the eta-phi window of the linker through a grid if it has one,
+  // - otherwise all the partners passing the linker's linkCandidate
+  class LinkCandidates {
+  public:
+    typedef std::pair<unsigned,unsigned> Range;
+
+    LinkCandidates(const BlockElementLinkerBase& linker,
+		   const std::vector<reco::PFBlockElement*>& elements,
+		   unsigned type1, Range range1, unsigned type2, Range range2) :
+      linker_(&linker), elements_(&elements), sameType_(type1 == type2),
+      driverType_(type1), mode_(kAll) {
+      double deltaEta, deltaPhi, eta, phi;
+      if( linker.multilinksCarrier(static_cast<PFBlockElement::Type>(type1)) ||
+	  linker.multilinksCarrier(static_cast<PFBlockElement::Type>(type2)) ) {
+	mode_ = kMultilinks;
+	if( !linker.multilinksCarrier(static_cast<PFBlockElement::Type>(type1)) ) {
+	  driverType_ = type2;
+	  range2 = range1;
+	}
+	for( unsigned j = range2.first; j < range2.second; ++j ) {
+	  if( linker.multilinkKey(elements[j],phi,eta) ) keys_.emplace_back(phi,eta,j);
+	}
+	std::sort(keys_.begin(),keys_.end());
+      } else if( linker.linkWindow(deltaEta,deltaPhi) ) {
+	mode_ = kWindow;
+	grid_ = std::make_unique<PFBlockSpatialHash>(deltaEta,deltaPhi);
+      }
+      for( unsigned j = range2.first; j < range2.second; ++j ) {
+	if( !linker.linkCandidate(elements[j]) ) continue;
+	partners_.push_back(j);
+	if( mode_ != kWindow ) continue;
+	if( linker.linkPosition(elements[j],eta,phi) ) grid_->insert(j,eta,phi);
+	else noPosition_.push_back(j);
+      }
+      if( grid_ ) grid_->build();
+    }
+
+    const BlockElementLinkerBase& linker() const { return *linker_; }
+    unsigned driverType() const { return driverType_; }
+
+    /// calls f(j) once for each candidate partner j of the driver i, with
+    /// j > i for the links of a type with itself
+    template<typename F>
+    void forEachCandidate(unsigned i, F f) const {
+      const PFBlockElement* elem = (*elements_)[i];
+      if( !linker_->linkCandidate(elem) ) return;
+      auto emit = [&](unsigned j) { if( j != i && ( !sameType_ || j > i ) ) f(j); };
+      if( mode_ == kMultilinks && elem->isMultilinksValide() ) {
+	for( const auto& ml : elem->getMultilinks() ) {
+	  auto key = std::lower_bound(keys_.begin(),keys_.end(),
+				      std::make_tuple(ml.first,ml.second,0u));
+	  for( ; key != keys_.end() && std::get<0>(*key) == ml.first &&
+		 std::get<1>(*key) == ml.second; ++key ) {
+	    emit(std::get<2>(*key));
+	  }
+	}
+	return;
+      }
+      double eta, phi;
+      if( mode_ == kWindow && linker_->linkPosition(elem,eta,phi) ) {
+	grid_->forEachNeighbour(eta,phi,emit);
+	for( unsigned j : noPosition_ ) emit(j);
+	return;
+      }
+      // no multilinks or no position: all the partners
+      for( unsigned j : partners_ ) emit(j);
+    }
+
+  private:
+    enum Mode { kAll, kWindow, kMultilinks };
+
+    const BlockElementLinkerBase* linker_;
+    const std::vector<reco::PFBlockElement*>* elements_;
+    bool sameType_;
+    unsigned driverType_;
+    Mode mode_;
+    std::vector<unsigned> partners_, noPosition_;
+    std::unique_ptr<PFBlockSpatialHash> grid_;
+    /// (phi, eta, index) of the partners, sorted
+    std::vector<std::tuple<double,double,unsigned> > keys_;
+  };
 }
 
 
@@ -67,6 +158,7 @@ namespace {
 PFBlockAlgo::PFBlockAlgo() : 
   blocks_( new reco::PFBlockCollection ),  
   debug_(false),
+  parallelLinking_(false),
   elementTypes_( {
         INIT_ENTRY(PFBlockElement::TRACK),
 	INIT_ENTRY(PFBlockElement::PS1),
@@ -162,6 +254,11 @@ void PFBlockAlgo::findBlocks() {
   else                blocks_.reset( new reco::PFBlockCollection );
   blocks_->reserve(elements_.size());
 
+  if( parallelLinking_ ) {
+    findBlocksParallel();
+    return;
+  }
+
   QuickUnion qu(bare_elements_.size());
   const auto elem_size = bare_elements_.size();
   for( unsigned i = 0; i < elem_size; ++i ) {
@@ -198,41 +295,123 @@ void PFBlockAlgo::findBlocks() {
     blocksmap.emplace(key,i);
   }
 
-  PFBlockLink::Type linktype = PFBlockLink::NONE;
-  PFBlock::LinkTest linktest = PFBlock::LINKTEST_RECHIT;
+  std::vector<unsigned> block_elements;
   for( auto key : keys ) {
     blocks_->push_back( reco::PFBlock() );
     auto range = blocksmap.equal_range(key);
-    auto& the_block = blocks_->back();
-    ElementList::value_type::pointer p1(bare_elements_[range.first->second]);
-    the_block.addElement(p1);
-    const unsigned block_size = blocksmap.count(key) + 1;
-    //reserve up to 1M or 8MB; pay rehash cost for more
-    std::unordered_map<std::pair<unsigned int,unsigned int>, PFBlockLink > links(min(1000000u,block_size*block_size));
-    auto itr = range.first;
-    ++itr;
-    for( ; itr != range.second; ++itr ) {
-      ElementList::value_type::pointer p2(bare_elements_[itr->second]);
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();        
-      the_block.addElement(p2);
-      linktest = PFBlock::LINKTEST_RECHIT; //rechit by default 
-      linktype = static_cast<PFBlockLink::Type>(1<<(type1-1)|1<<(type2-1));
-      const unsigned index = linkTestSquare_[type1][type2];
-      if( nullptr != linkTests_[index] ) {
-        const double dist = linkTests_[index]->testLink(p1,p2);
-        links.emplace( std::make_pair(p1->index(), p2->index()) ,
-                       PFBlockLink( linktype, linktest, dist,
-                                    p1->index(), p2->index() ) );
-      }
+    block_elements.clear();
+    for( auto itr = range.first; itr != range.second; ++itr ) {
+      block_elements.push_back(itr->second);
     }
-    packLinks( the_block, links );    
+    buildBlock( blocks_->back(), block_elements );
   }
   
   bare_elements_.clear();
   elements_.clear();
 }
 
+void PFBlockAlgo::findBlocksParallel() {
+  constexpr unsigned rowsize = reco::PFBlockElement::kNBETypes;
+  const unsigned nElements = bare_elements_.size();
+
+  // elements are sorted by type
+  std::array<std::pair<unsigned,unsigned>,rowsize> typeRanges;
+  typeRanges.fill(std::make_pair(0u,0u));
+  for( unsigned i = 0; i < nElements; ++i ) {
+    auto& range = typeRanges[bare_elements_[i]->type()];
+    if( range.first == range.second ) range.first = i;
+    range.second = i+1;
+  }
+
+  // candidate finders of the linked types, by type of the driving elements
+  std::vector<std::vector<LinkCandidates> > candidatesByType(rowsize);
+  for( unsigned type1 = 0; type1 < rowsize; ++type1 ) {
+    for( unsigned type2 = type1; type2 < rowsize; ++type2 ) {
+      const auto& linker = linkTests_[linkTestSquare_[type1][type2]];
+      if( !linker ) continue;
+      const auto range1 = typeRanges[type1];
+      const auto range2 = typeRanges[type2];
+      if( range1.first == range1.second || range2.first == range2.second ) continue;
+      LinkCandidates candidates(*linker,bare_elements_,type1,range1,type2,range2);
+      const unsigned driver = candidates.driverType();
+      candidatesByType[driver].push_back(std::move(candidates));
+    }
+  }
+
+  // each element tests its candidates, every pair is generated once and the
+  // linkers link two elements whatever their order, so a pair is tested in
+  // one direction (lower index first, as the serial loop does first)
+  std::vector<std::vector<unsigned> > linkedTo(nElements);
+  tbb::parallel_for(tbb::blocked_range<unsigned>(0,nElements,64),
+                    [&](const tbb::blocked_range<unsigned>& r) {
+    for( unsigned i = r.begin(); i != r.end(); ++i ) {
+      for( const auto& candidates : candidatesByType[bare_elements_[i]->type()] ) {
+        const auto& linker = candidates.linker();
+        candidates.forEachCandidate(i,[&](unsigned j) {
+            auto p1(bare_elements_[std::min(i,j)]), p2(bare_elements_[std::max(i,j)]);
+            if( linker.linkPrefilter(p1,p2) && linker.testLink(p1,p2) > -0.5 ) {
+              linkedTo[i].push_back(j);
+            }
+          });
+      }
+    }
+  });
+
+  QuickUnion qu(nElements);
+  for( unsigned i = 0; i < nElements; ++i ) {
+    for( unsigned j : linkedTo[i] ) {
+      if( !qu.connected(i,j) ) qu.unite(i,j);
+    }
+  }
+
+  // blocks in the order of their first element
+  std::vector<std::vector<unsigned> > block_elements;
+  std::vector<int> block_of_root(bare_elements_.size(),-1);
+  for( unsigned i = 0; i < bare_elements_.size(); ++i ) {
+    const unsigned root = qu.find(i);
+    if( block_of_root[root] < 0 ) {
+      block_of_root[root] = block_elements.size();
+      block_elements.emplace_back();
+    }
+    block_elements[block_of_root[root]].push_back(i);
+  }
+
+  blocks_->resize(block_elements.size());
+  tbb::parallel_for(size_t(0),block_elements.size(),[&](size_t ib) {
+      buildBlock( (*blocks_)[ib], block_elements[ib] );
+    });
+
+  bare_elements_.clear();
+  elements_.clear();
+}
+
+void PFBlockAlgo::buildBlock(reco::PFBlock& the_block, 
+                             const std::vector<unsigned>& block_elements) const {
+  PFBlockLink::Type linktype = PFBlockLink::NONE;
+  PFBlock::LinkTest linktest = PFBlock::LINKTEST_RECHIT;
+  ElementList::value_type::pointer p1(bare_elements_[block_elements.front()]);
+  the_block.addElement(p1);
+  const unsigned block_size = block_elements.size() + 1;
+  //reserve up to 1M or 8MB; pay rehash cost for more
+  std::unordered_map<std::pair<unsigned int,unsigned int>, PFBlockLink > links(min(1000000u,block_size*block_size));
+  for( unsigned k = 1; k < block_elements.size(); ++k ) {
+    ElementList::value_type::pointer p2(bare_elements_[block_elements[k]]);
+    const PFBlockElement::Type type1 = p1->type();
+    const PFBlockElement::Type type2 = p2->type();        
+    the_block.addElement(p2);
+    linktest = PFBlock::LINKTEST_RECHIT; //rechit by default 
+    linktype = static_cast<PFBlockLink::Type>(1<<(type1-1)|1<<(type2-1));
+    const unsigned index = linkTestSquare_[type1][type2];
+    if( nullptr != linkTests_[index] ) {
+      const double dist = linkTests_[index]->testLink(p1,p2);
+      links.emplace( std::make_pair(p1->index(), p2->index()) ,
+                     PFBlockLink( linktype, linktest, dist,
+                                  p1->index(), p2->index() ) );
+    }
+  }
+  packLinks( the_block, links );    
+}
+
 void 
 PFBlockAlgo::packLinks( reco::PFBlock& block, 
 			   const std::unordered_map<std::pair<unsigned int,unsigned int>,PFBlockLink>& links ) const {
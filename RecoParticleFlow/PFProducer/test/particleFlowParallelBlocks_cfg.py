@@ -0,0 +1,58 @@
+import FWCore.ParameterSet.Config as cms
+
+# Reruns the particle-flow reconstruction from the blocks of a RECO file, once
+# serially and once with the blocks reconstructed concurrently, and fails if
+# the two candidate collections differ (kinematics, charge, pdgId, block
+# elements or order).
+
+process = cms.Process("PFPARALLEL")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(100)
+)
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(0)
+)
+
+from PhysicsTools.PatAlgos.patInputFiles_cff import filesRelValTTbarGENSIMRECO
+process.source = cms.Source("PoolSource",
+                            fileNames = filesRelValTTbarGENSIMRECO
+)
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
+
+process.load("RecoParticleFlow.PFProducer.particleFlow_cfi")
+process.particleFlowSerial = process.particleFlowTmp.clone(
+    muons = cms.InputTag("muons"),
+    parallelBlocks = cms.bool(False)
+    )
+process.particleFlowParallel = process.particleFlowSerial.clone(
+    parallelBlocks = cms.bool(True)
+    )
+
+process.particleFlowCandidateChecker = cms.EDAnalyzer(
+    "PFCandidateChecker",
+    pfCandidatesReco = cms.InputTag("particleFlowSerial"),
+    pfCandidatesReReco = cms.InputTag("particleFlowParallel"),
+    pfJetsReco = cms.InputTag("ak4PFJets"),
+    pfJetsReReco = cms.InputTag("ak4PFJets"),
+    deltaEMax = cms.double(0.),
+    deltaEtaMax = cms.double(0.),
+    deltaPhiMax = cms.double(0.),
+    rankByPt = cms.untracked.bool(False),
+    compareElementsInBlocks = cms.untracked.bool(True),
+    failOnDifference = cms.untracked.bool(True)
+    )
+
+process.p = cms.Path(
+    process.particleFlowSerial+
+    process.particleFlowParallel+
+    process.particleFlowCandidateChecker
+    )
@@ -17,6 +17,7 @@
 #include "RecoTauTag/RecoTau/interface/RecoTauQualityCuts.h"
 
 #include <algorithm> 
+#include <cmath>
 
 namespace reco { namespace tau {
 
@@ -48,6 +49,11 @@ class RecoTauBuilderCombinatoricPlugin : public RecoTauBuilderPlugin
     uint32_t maxPFCHs_;
     uint32_t nCharged_;
     uint32_t nPiZeros_;
+    // optional pre-selection of the combinations, applied before the PFTau is built
+    // (a negative maximum means no cut)
+    double minMass_;
+    double maxMass_;
+    int maxAbsCharge_;
   };
   std::vector<decayModeInfo> decayModesToBuild_;
 
@@ -79,6 +85,12 @@ RecoTauBuilderCombinatoricPlugin::RecoTauBuilderCombinatoricPlugin(const edm::Pa
     info.nPiZeros_ = decayMode->getParameter<uint32_t>("nPiZeros");
     info.maxPFCHs_ = decayMode->getParameter<uint32_t>("maxTracks");
     info.maxPiZeros_ = decayMode->getParameter<uint32_t>("maxPiZeros");
+    info.minMass_ = ( decayMode->existsAs<double>("minMass") ) ?
+      decayMode->getParameter<double>("minMass") : 0.;
+    info.maxMass_ = ( decayMode->existsAs<double>("maxMass") ) ?
+      decayMode->getParameter<double>("maxMass") : -1.;
+    info.maxAbsCharge_ = ( decayMode->existsAs<int>("maxAbsCharge") ) ?
+      decayMode->getParameter<int>("maxAbsCharge") : -1;
     decayModesToBuild_.push_back(info);
   }
 
@@ -213,6 +225,22 @@ RecoTauBuilderCombinatoricPlugin::operator()(
   /// Apply quality cuts to the regional junk around the jet.  Note that the
   /// particle contents of the junk is exclusive to the jet content.
   PFCandPtrs regionalJunk = qcuts_.filterCandRefs(regionalExtras);
+
+  // Cross cleaning predicates and PF object type selectors that only depend on the jet,
+  // shared by all the combinations of all the decay modes
+  //  to select neutral PFCandidates within jet
+  xclean::CrossCleanPtrs<ChargedHadronList::const_iterator> pfChargedHadronXCleaner_allChargedHadrons(chargedHadrons.begin(), chargedHadrons.end());
+  xclean::CrossCleanPtrs<PiZeroList::const_iterator> piZeroXCleaner(piZeros.begin(), piZeros.end());
+  typedef xclean::PredicateAND<xclean::CrossCleanPtrs<ChargedHadronList::const_iterator>, xclean::CrossCleanPtrs<PiZeroList::const_iterator> > pfCandXCleanerType;
+  pfCandXCleanerType pfCandXCleaner_allChargedHadrons(pfChargedHadronXCleaner_allChargedHadrons, piZeroXCleaner);
+
+  // to select the different PF object types of the regional junk objects to add
+  xclean::FilterPFCandByParticleId
+    pfchCandSelector(reco::PFCandidate::h);
+  xclean::FilterPFCandByParticleId
+    pfgammaCandSelector(reco::PFCandidate::gamma);
+  xclean::FilterPFCandByParticleId
+    pfnhCandSelector(reco::PFCandidate::h0);
     
   // Loop over the decay modes we want to build
   for ( std::vector<decayModeInfo>::const_iterator decayMode = decayModesToBuild_.begin();
@@ -249,6 +277,17 @@ RecoTauBuilderCombinatoricPlugin::operator()(
     // Loop over the different combinations of tracks
     for ( ChargedHadronCombo::iterator trackCombo = trackCombos.begin();
 	  trackCombo != trackCombos.end(); ++trackCombo ) {
+      // Reject the combination if its charge is out of range,
+      // before the pi0s are cross-cleaned and combined with it
+      reco::Candidate::LorentzVector trackComboP4;
+      int trackComboCharge = 0;
+      for ( ChargedHadronCombo::combo_iterator chargedHadron = trackCombo->combo_begin();
+	    chargedHadron != trackCombo->combo_end(); ++chargedHadron ) {
+	trackComboP4 += chargedHadron->p4();
+	trackComboCharge += chargedHadron->charge();
+      }
+      if ( decayMode->maxAbsCharge_ >= 0 && std::abs(trackComboCharge) > decayMode->maxAbsCharge_ ) continue;
+
       xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator> signalPiZeroXCleaner(
           trackCombo->combo_begin(), trackCombo->combo_end(), 
 	  xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator>::kRemoveChargedDaughterOverlaps);
@@ -269,9 +308,37 @@ RecoTauBuilderCombinatoricPlugin::operator()(
       
       // Build our piZero combo generator     
       PiZeroCombo piZeroCombos(signalPiZero_begin, signalPiZero_end, piZerosToBuild);
+
+      // The isolation pi0s and charged PFCandidates only depend on the track combination
+      xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator> isolationPiZeroXCleaner(
+        trackCombo->combo_begin(), trackCombo->combo_end(), 
+	xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator>::kRemoveChargedAndNeutralDaughterOverlaps);
+      PiZeroList precleanedIsolationPiZeros = isolationPiZeroXCleaner(piZeros);
+
+      // Cross cleaning predicate: Remove any PFCandidatePtrs that are contained within existing ChargedHadrons or PiZeros.  
+      // The predicate will return false for any object that overlaps with chargedHadrons or cleanPiZeros.
+      //  to select charged PFCandidates within jet that are not signalPFChargedHadrons 
+      typedef xclean::CrossCleanPtrs<ChargedHadronCombo::combo_iterator> pfChargedHadronXCleanerType;
+      pfChargedHadronXCleanerType pfChargedHadronXCleaner_comboChargedHadrons(trackCombo->combo_begin(), trackCombo->combo_end());
+
       // Loop over the different combinations of PiZeros
       for ( PiZeroCombo::iterator piZeroCombo = piZeroCombos.begin();
             piZeroCombo != piZeroCombos.end(); ++piZeroCombo ) {
+        // Reject the combination if its mass is out of range, before the tau is built.
+        // N.B. the mass of the tau can differ a little from the one of the sum
+        // of its charged hadrons and pi0s (PFGammas are removed from the charged hadrons
+        // that overlap with the pi0s), so the mass window needs to be looser than the
+        // selections applied to the taus later on
+        if ( decayMode->minMass_ > 0. || decayMode->maxMass_ >= 0. ) {
+          reco::Candidate::LorentzVector comboP4 = trackComboP4;
+          for ( PiZeroCombo::combo_iterator signalPiZero = piZeroCombo->combo_begin();
+                signalPiZero != piZeroCombo->combo_end(); ++signalPiZero ) {
+            comboP4 += signalPiZero->p4();
+          }
+          if ( decayMode->minMass_ > 0. && comboP4.mass() < decayMode->minMass_ ) continue;
+          if ( decayMode->maxMass_ >= 0. && comboP4.mass() > decayMode->maxMass_ ) continue;
+        }
+
         // Output tau
         RecoTauConstructor tau(
           jet, getPFCands(), true, 
@@ -285,12 +352,7 @@ RecoTauBuilderCombinatoricPlugin::operator()(
             RecoTauConstructor::kSignal,
             RecoTauConstructor::kGamma, 2*piZerosToBuild); // k-factor = 2
         tau.reservePiZero(RecoTauConstructor::kSignal, piZerosToBuild);
-	
-	xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator> isolationPiZeroXCleaner(
-          trackCombo->combo_begin(), trackCombo->combo_end(), 
-	  xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator>::kRemoveChargedAndNeutralDaughterOverlaps);
 
-	PiZeroList precleanedIsolationPiZeros = isolationPiZeroXCleaner(piZeros);
 	std::set<reco::CandidatePtr> toRemove;
 	for ( PiZeroCombo::combo_iterator signalPiZero = piZeroCombo->combo_begin();
 	      signalPiZero != piZeroCombo->combo_end(); ++signalPiZero ) {
@@ -351,18 +413,8 @@ RecoTauBuilderCombinatoricPlugin::operator()(
         using namespace reco::tau::cone;
         PFCandPtrDRFilter isolationConeFilter(tau.p4(), -0.1, isolationConeSize_);
 
-        // Cross cleaning predicate: Remove any PFCandidatePtrs that are contained within existing ChargedHadrons or PiZeros.  
-	// The predicate will return false for any object that overlaps with chargedHadrons or cleanPiZeros.
-	//  1.) to select charged PFCandidates within jet that are not signalPFChargedHadrons 
-	typedef xclean::CrossCleanPtrs<ChargedHadronCombo::combo_iterator> pfChargedHadronXCleanerType;
-	pfChargedHadronXCleanerType pfChargedHadronXCleaner_comboChargedHadrons(trackCombo->combo_begin(), trackCombo->combo_end());
-	// And this cleaning filter predicate with our Iso cone filter
+        // Combine the cross cleaning predicates with our Iso cone filter
         xclean::PredicateAND<PFCandPtrDRFilter, pfChargedHadronXCleanerType> pfCandFilter_comboChargedHadrons(isolationConeFilter, pfChargedHadronXCleaner_comboChargedHadrons);
-	//  2.) to select neutral PFCandidates within jet
-	xclean::CrossCleanPtrs<ChargedHadronList::const_iterator> pfChargedHadronXCleaner_allChargedHadrons(chargedHadrons.begin(), chargedHadrons.end());
-	xclean::CrossCleanPtrs<PiZeroList::const_iterator> piZeroXCleaner(piZeros.begin(), piZeros.end());
-	typedef xclean::PredicateAND<xclean::CrossCleanPtrs<ChargedHadronList::const_iterator>, xclean::CrossCleanPtrs<PiZeroList::const_iterator> > pfCandXCleanerType;
-        pfCandXCleanerType pfCandXCleaner_allChargedHadrons(pfChargedHadronXCleaner_allChargedHadrons, piZeroXCleaner);
         // And this cleaning filter predicate with our Iso cone filter
         xclean::PredicateAND<PFCandPtrDRFilter, pfCandXCleanerType> pfCandFilter_allChargedHadrons(isolationConeFilter, pfCandXCleaner_allChargedHadrons);
 
@@ -374,13 +426,6 @@ RecoTauBuilderCombinatoricPlugin::operator()(
         typedef xclean::PredicateAND<xclean::FilterPFCandByParticleId,
 	    PFCandPtrDRFilter> RegionalJunkConeAndIdFilter;
 
-        xclean::FilterPFCandByParticleId
-          pfchCandSelector(reco::PFCandidate::h);
-        xclean::FilterPFCandByParticleId
-          pfgammaCandSelector(reco::PFCandidate::gamma);
-        xclean::FilterPFCandByParticleId
-          pfnhCandSelector(reco::PFCandidate::h0);
-
         RegionalJunkConeAndIdFilter pfChargedJunk(
             pfchCandSelector, // select charged stuff from junk
             isolationConeFilter); // only take those in iso cone
@@ -22,6 +22,12 @@ Author: Evan K. Friis, UC Davis
 # So for decay mode 11 (3 tracks, 1 pizero), with 10 for both
 #
 # (10 choose 3) * (10 choose 1) = 1200!
+#
+# The combinations can be pre-selected before the taus are built,
+# with the optional parameters of each decay mode (no cut by default)
+#   minMass = cms.double(...), maxMass = cms.double(...) : mass window of the
+#     sum of the charged hadrons and pizeros (to be looser than the later selections)
+#   maxAbsCharge = cms.int32(...) : maximum |charge| of the charged hadrons
 
 # Configurations for the different decay modes
 
@@ -11,6 +11,7 @@
 #include "TrackingTools/PatternTools/interface/TempTrajectory.h"
 
 class CkfDebugger;
+class CkfNavigationCache;
 class Chi2MeasurementEstimatorBase;
 class DetGroup;
 class FreeTrajectoryState;
@@ -138,6 +139,9 @@ public:
 
   StateAndLayers findStateAndLayers(const TrajectorySeed& seed, const TempTrajectory& traj) const;
 
+  /** Layers to be explored next, from the navigation school or from the per-event cache if enabled */
+  std::vector<const DetLayer*> nextLayers(const DetLayer & layer, const FreeTrajectoryState & fts, PropagationDirection dir) const;
+
  private:
   void seedMeasurements(const TrajectorySeed& seed, TempTrajectory & result) const;
 
@@ -174,6 +178,7 @@ public:
   //  TrajectoryFilter*              theMaxHitsCondition;
   std::unique_ptr<TrajectoryFilter> theFilter; /** Filter used at end of complete tracking */
   std::unique_ptr<TrajectoryFilter> theInOutFilter; /** Filter used at end of in-out tracking */
+  std::unique_ptr<CkfNavigationCache> theNavigationCache; /** optional, see cacheNavigation */
 
   // for EventSetup
   const std::string theUpdatorName;
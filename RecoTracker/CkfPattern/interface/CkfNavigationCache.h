@@ -0,0 +1,66 @@
+#ifndef RecoTracker_CkfPattern_CkfNavigationCache_H
+#define RecoTracker_CkfPattern_CkfNavigationCache_H
+
+#include "TrackingTools/DetLayers/interface/NavigationSchool.h"
+#include "TrackingTools/TrajectoryState/interface/FreeTrajectoryState.h"
+#include "DataFormats/GeometrySurface/interface/PropagationDirection.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class DetLayer;
+
+/** Per-event memo of NavigationSchool::nextLayers for the trajectory builders.
+ *  Candidates expanded from the same parent reach a layer with nearly identical states
+ *  and are navigated to the same next layers: the query is keyed on the layer,
+ *  the direction, the in/out flags used by the navigation and a quantized state
+ *  (position phi/z/r, momentum eta/phi, q/pt), and answered from the cache on a match.
+ *  The bins are much smaller than the layer tolerances of the navigation.
+ *  Queries and hits are counted; clear() reports them at the end of each event.
+ */
+class CkfNavigationCache {
+public:
+  typedef std::vector<const DetLayer*> Layers;
+
+  CkfNavigationCache() : nQueries(0), nHits(0), nTotQueries(0), nTotHits(0) {}
+  ~CkfNavigationCache();
+
+  Layers nextLayers(NavigationSchool const & navigation, const DetLayer & layer,
+                    const FreeTrajectoryState & fts, PropagationDirection dir);
+
+  /// forget the cached answers (to be called for each event)
+  void clear();
+
+  unsigned long long queries() const { return nTotQueries+nQueries; }
+  unsigned long long hits() const { return nTotHits+nHits; }
+
+private:
+  struct Key {
+    int32_t layer;
+    int32_t flags;
+    int32_t bins[6];
+    bool operator==(Key const & rh) const {
+      if (layer!=rh.layer || flags!=rh.flags) return false;
+      for (int i=0; i<6; ++i) if (bins[i]!=rh.bins[i]) return false;
+      return true;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(Key const & k) const {
+      std::size_t h = std::size_t(k.layer)*0x9E3779B97F4A7C15ULL ^ std::size_t(k.flags);
+      for (int i=0; i<6; ++i) h = (h ^ std::size_t(uint32_t(k.bins[i]))) * 0x100000001B3ULL;
+      return h;
+    }
+  };
+
+  static Key makeKey(const DetLayer & layer, const FreeTrajectoryState & fts, PropagationDirection dir);
+
+  std::mutex theMutex;  // the builders may be shared by concurrent seeds
+  std::unordered_map<Key,Layers,KeyHash> theCache;
+  unsigned long long nQueries, nHits;
+  unsigned long long nTotQueries, nTotHits;
+};
+
+#endif
@@ -37,7 +37,10 @@ GroupedCkfTrajectoryBuilder = cms.PSet(
 #    propagatorOpposite = cms.string('PropagatorWithMaterialParabolicMfOpposite'),
     # Out-in tracking will not be attempted unless this many hits
     # are on track after in-out tracking phase.
-    minNrOfHitsForRebuild = cms.int32(5)
+    minNrOfHitsForRebuild = cms.int32(5),
+    # Reuse the next-layer navigation of candidates with (almost) the same
+    # state within the event; the hit rate is reported by the MessageLogger.
+    cacheNavigation = cms.bool(False)
 )
 
 
@@ -1,4 +1,5 @@
 #include "RecoTracker/CkfPattern/interface/BaseCkfTrajectoryBuilder.h"
+#include "RecoTracker/CkfPattern/interface/CkfNavigationCache.h"
 
 #include "RecoTracker/MeasurementDet/interface/MeasurementTracker.h"
 #include "RecoTracker/MeasurementDet/interface/MeasurementTrackerEvent.h"
@@ -43,6 +44,8 @@ BaseCkfTrajectoryBuilder::BaseCkfTrajectoryBuilder(const edm::ParameterSet& conf
   theRecHitBuilderName(conf.getParameter<std::string>("TTRHBuilder"))
 {
   if (conf.exists("clustersToSkip")) edm::LogError("BaseCkfTrajectoryBuilder") << "ERROR: " << typeid(*this).name() << " has a clustersToSkip parameter set";
+  if (conf.existsAs<bool>("cacheNavigation") && conf.getParameter<bool>("cacheNavigation"))
+    theNavigationCache = std::make_unique<CkfNavigationCache>();
 }
 
 
@@ -218,15 +221,22 @@ BaseCkfTrajectoryBuilder::findStateAndLayers(const TrajectorySeed& seed, const T
       
       TSOS currentState(trajectoryStateTransform::transientState(ptod,surface,forwardPropagator(seed)->magneticField()));      
       const DetLayer* lastLayer = theMeasurementTracker->geometricSearchTracker()->detLayer(id);      
-      return StateAndLayers(currentState,theNavigationSchool->nextLayers(*lastLayer,*currentState.freeState(), traj.direction()) );
+      return StateAndLayers(currentState,nextLayers(*lastLayer,*currentState.freeState(), traj.direction()) );
     }
   else
     {  
       TSOS const & currentState = traj.lastMeasurement().updatedState();
-      return StateAndLayers(currentState,theNavigationSchool->nextLayers(*traj.lastLayer(), *currentState.freeState(), traj.direction()) );
+      return StateAndLayers(currentState,nextLayers(*traj.lastLayer(), *currentState.freeState(), traj.direction()) );
     }
 }
 
+std::vector<const DetLayer*>
+BaseCkfTrajectoryBuilder::nextLayers(const DetLayer & layer, const FreeTrajectoryState & fts, PropagationDirection dir) const
+{
+  return theNavigationCache ? theNavigationCache->nextLayers(*theNavigationSchool, layer, fts, dir)
+                            : theNavigationSchool->nextLayers(layer, fts, dir);
+}
+
 void BaseCkfTrajectoryBuilder::setData(const MeasurementTrackerEvent *data) 
 {
     // possibly do some sanity check here
@@ -263,6 +273,7 @@ void BaseCkfTrajectoryBuilder::setEvent(const edm::Event& iEvent, const edm::Eve
   theTTRHBuilder = recHitBuilderHandle.product();
 
   setData(data);
+  if(theNavigationCache) theNavigationCache->clear();
   if(theFilter) theFilter->setEvent(iEvent, iSetup);
   if(theInOutFilter) theInOutFilter->setEvent(iEvent, iSetup);
   setEvent_(iEvent, iSetup);
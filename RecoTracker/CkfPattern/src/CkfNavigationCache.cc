@@ -0,0 +1,71 @@
+#include "RecoTracker/CkfPattern/interface/CkfNavigationCache.h"
+
+#include "TrackingTools/DetLayers/interface/DetLayer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <cmath>
+
+namespace {
+  // bin widths of the quantized state
+  constexpr float posPhiBin = 0.005f;  // rad
+  constexpr float posZBin   = 0.5f;    // cm
+  constexpr float posRBin   = 0.5f;    // cm
+  constexpr float momEtaBin = 0.005f;
+  constexpr float momPhiBin = 0.005f;  // rad
+  constexpr float qOverPtBin = 0.01f;  // 1/GeV
+
+  inline int32_t bin(float x, float width) { return int32_t(std::floor(x/width)); }
+}
+
+CkfNavigationCache::Key
+CkfNavigationCache::makeKey(const DetLayer & layer, const FreeTrajectoryState & fts, PropagationDirection dir) {
+  auto const position = fts.position();
+  auto const momentum = fts.momentum();
+
+  // the discrete choices taken by the navigation before looking at the layers
+  bool isInOutTrackBarrel = position.x()*momentum.x()+position.y()*momentum.y() > 0;
+  bool isInOutTrackFWD = momentum.z()*position.z() > 0;
+  bool positiveZ = momentum.z() > 0;
+
+  Key k;
+  k.layer = layer.seqNum();
+  k.flags = int(dir) | (isInOutTrackBarrel<<4) | (isInOutTrackFWD<<5) | (positiveZ<<6);
+  k.bins[0] = bin(position.barePhi(), posPhiBin);
+  k.bins[1] = bin(position.z(), posZBin);
+  k.bins[2] = bin(position.perp(), posRBin);
+  k.bins[3] = bin(momentum.eta(), momEtaBin);
+  k.bins[4] = bin(momentum.barePhi(), momPhiBin);
+  k.bins[5] = bin(fts.charge()/momentum.perp(), qOverPtBin);
+  return k;
+}
+
+CkfNavigationCache::Layers
+CkfNavigationCache::nextLayers(NavigationSchool const & navigation, const DetLayer & layer,
+                               const FreeTrajectoryState & fts, PropagationDirection dir) {
+  auto const key = makeKey(layer, fts, dir);
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    ++nQueries;
+    auto p = theCache.find(key);
+    if (p!=theCache.end()) { ++nHits; return p->second; }
+  }
+  auto && layers = navigation.nextLayers(layer, fts, dir);
+  std::lock_guard<std::mutex> lock(theMutex);
+  theCache.emplace(key,layers);
+  return layers;
+}
+
+void CkfNavigationCache::clear() {
+  std::lock_guard<std::mutex> lock(theMutex);
+  LogDebug("CkfPattern") << "navigation cache: " << nHits << " hits in " << nQueries << " queries, "
+                         << theCache.size() << " entries";
+  nTotQueries += nQueries; nTotHits += nHits;
+  nQueries = nHits = 0;
+  theCache.clear();
+}
+
+CkfNavigationCache::~CkfNavigationCache() {
+  if (queries()==0) return;
+  edm::LogInfo("CkfPattern") << "navigation cache: " << hits() << " hits in " << queries() << " queries ("
+                             << 100.*hits()/queries() << "%)";
+}
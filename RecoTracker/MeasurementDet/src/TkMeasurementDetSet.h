@@ -2,6 +2,8 @@
 #define StMeasurementDetSet_H
 
 #include<vector>
+#include<atomic>
+#include<thread>
 class TkStripMeasurementDet;
 class TkStripMeasurementDet;
 class TkPixelMeasurementDet;
@@ -156,7 +158,7 @@ public:
     activeThisEvent_(cond.nDet(), true),
     detSet_(cond.nDet()),
     detIndex_(cond.nDet(),-1),
-    ready_(cond.nDet(),true),
+    ready_(cond.nDet()),
     theRawInactiveStripDetIds_(),
     stripDefined_(0), 
     stripUpdated_(0), 
@@ -177,7 +179,7 @@ public:
   }
 
   void update(int i, int j ) {
-    assert(j>=0); assert(empty_[i]); assert(ready_[i]); 
+    assert(j>=0); assert(empty_[i]); assert(ready_[i]==toBeSet); 
     detIndex_[i] = j;
     empty_[i] = false;
     incReady();
@@ -199,7 +201,7 @@ public:
   void setEmpty() {
     printStat();
     std::fill(empty_.begin(),empty_.end(),true);
-    std::fill(ready_.begin(),ready_.end(),true);
+    for (auto & r : ready_) r = toBeSet;
     std::fill(detIndex_.begin(),detIndex_.end(),-1);
     std::fill(activeThisEvent_.begin(), activeThisEvent_.end(),true);
     incTot(size());
@@ -212,7 +214,7 @@ public:
   edm::Handle<edmNew::DetSetVector<SiStripCluster> > & handle() {  return handle_; }
   const edm::Handle<edmNew::DetSetVector<SiStripCluster> > & handle() const {  return handle_; }
   // StripDetset & detSet(int i) { return detSet_[i]; }
-  const StripDetset & detSet(int i) const { if (ready_[i]) const_cast<StMeasurementDetSet*>(this)->getDetSet(i);     return detSet_[i]; }
+  const StripDetset & detSet(int i) const { if (ready_[i]!=isSet) const_cast<StMeasurementDetSet*>(this)->getDetSet(i);     return detSet_[i]; }
   
 
   //// ------- pieces for on-demand unpacking -------- 
@@ -230,19 +232,28 @@ public:
 
 private:
 
+  // the same MeasurementTrackerEvent is used concurrently by several modules:
+  // only one thread sets a given det (triggering the on-demand unpacking), the others wait for it
   void getDetSet(int i) {
+    char expected = toBeSet;
+    if (!ready_[i].compare_exchange_strong(expected,beingSet)) {
+      while (ready_[i]!=isSet) std::this_thread::yield();
+      return;
+    }
     if(detIndex_[i]>=0) {
       detSet_[i].set(*handle_,handle_->item(detIndex_[i]));
-      empty_[i]=false; // better be false already
+      // empty_[i] is already false (see update)
       incAct();
     }  else { // we should not be here
       detSet_[i] = StripDetset();
-      empty_[i]=true;  
+      // empty_[i] is already true (see setEmpty)
     }
-    ready_[i]=false;
+    ready_[i]=isSet;
     incSet();
   }
 
+  enum ReadyState : char { toBeSet=0, beingSet=1, isSet=2 };
+
 
   friend class  MeasurementTrackerImpl;
 
@@ -259,7 +270,7 @@ private:
   // full reco
   std::vector<StripDetset> detSet_;
   std::vector<int> detIndex_;
-  std::vector<bool> ready_; // to be cleaned
+  std::vector<std::atomic<char>> ready_; // to be cleaned (see ReadyState)
   
  
   // note: not aligned to the index
@@ -0,0 +1,55 @@
+#ifndef DAClusterizerTrackBlocks_h
+#define DAClusterizerTrackBlocks_h
+
+/**
+
+ Description: per-vertex sums over tracks for the deterministic annealing clusterizers,
+              computed in fixed-size blocks of tracks that run concurrently.
+
+        The blocks do not depend on the number of threads and their partial sums are
+        added in block order, so the result is reproducible. With a single block
+        (small events) the sums are exactly the ones of the plain track loop.
+
+ */
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace daclusterizer {
+
+  // tracks per block, large enough to amortize the scheduling
+  constexpr unsigned int trackBlockSize = 512;
+
+  /**
+   *  kernel(iBegin, iEnd, sums, eiCache, ei) accumulates tracks [iBegin,iEnd) into
+   *  sums (nSums arrays of nv entries, zero-initialized); eiCache and ei are scratch
+   *  arrays of nv entries private to the block.
+   *  result receives nSums*nv entries.
+   */
+  template<typename Kernel>
+  inline void accumulateOverTrackBlocks(unsigned int nt, unsigned int nv, unsigned int nSums,
+                                        double * __restrict__ result, Kernel const & kernel) {
+    const unsigned int nBlocks = (nt + trackBlockSize - 1) / trackBlockSize;
+    const unsigned int nResult = nSums*nv;
+    const unsigned int blockStride = nResult + 2*nv;
+    std::vector<double> buffer(std::size_t(std::max(nBlocks,1U))*blockStride, 0.);
+
+    auto runBlock = [&](unsigned int ib) {
+      double * b = buffer.data() + std::size_t(ib)*blockStride;
+      kernel(ib*trackBlockSize, std::min(nt, (ib+1)*trackBlockSize), b, b+nResult, b+nResult+nv);
+    };
+    if (nBlocks > 1) tbb::parallel_for(0U, nBlocks, runBlock);
+    else if (nBlocks == 1) runBlock(0);
+
+    std::copy(buffer.begin(), buffer.begin()+nResult, result);
+    for (unsigned int ib = 1; ib < nBlocks; ++ib) {
+      const double * __restrict__ b = buffer.data() + std::size_t(ib)*blockStride;
+      for (unsigned int j = 0; j < nResult; ++j) result[j] += b[j];
+    }
+  }
+
+}
+
+#endif
@@ -18,11 +18,20 @@
 
 #include "RecoVertex/VertexTools/interface/GeometricAnnealing.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+namespace {
+  // clusters fitted by each task with one copy of the fitter
+  constexpr size_t fitGrainSize = 4;
+}
+
 PrimaryVertexProducer::PrimaryVertexProducer(const edm::ParameterSet& conf)
   :theConfig(conf)
 {
 
   fVerbose   = conf.getUntrackedParameter<bool>("verbose", false);
+  fParallelFits = conf.existsAs<bool>("parallelFits") ? conf.getParameter<bool>("parallelFits") : false;
 
   trkToken = consumes<reco::TrackCollection>(conf.getParameter<edm::InputTag>("TrackLabel"));
   bsToken = consumes<reco::BeamSpot>(conf.getParameter<edm::InputTag>("beamSpotLabel"));
@@ -189,15 +198,13 @@ PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
     reco::VertexCollection & vColl = (*result);
 
 
-    std::vector<TransientVertex> pvs;
-    for (std::vector< std::vector<reco::TransientTrack> >::const_iterator iclus
-	   = clusters.begin(); iclus != clusters.end(); iclus++) {
-      
+    // fit one cluster with the given fitter
+    auto fitCluster = [&](VertexFitter<5> const & fitter, std::vector<reco::TransientTrack> const & clus) {
       double meantime = 0.;
       double expv_x2 = 0.;
       double normw = 0.;  
       if( f4D ) {
-        for( const auto& tk : *iclus ) {
+        for( const auto& tk : clus ) {
           const double time = tk.timeExt();
           const double inverr = 1.0/tk.dtErrorExt();
           const double w = inverr*inverr;
@@ -212,32 +219,50 @@ PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
 
 
       TransientVertex v; 
-      if( algorithm->useBeamConstraint && validBS &&((*iclus).size()>1) ){
+      if( algorithm->useBeamConstraint && validBS &&(clus.size()>1) ){
         
-	v = algorithm->fitter->vertex(*iclus, beamSpot);
+	v = fitter.vertex(clus, beamSpot);
 	
         if( f4D ) {
           if( v.isValid() ) {
             auto err = v.positionError().matrix4D();
-            err(3,3) = time_var/(double)iclus->size();        
+            err(3,3) = time_var/(double)clus.size();        
             v = TransientVertex(v.position(),meantime,err,v.originalTracks(),v.totalChiSquared());
           }
         }
 	
-      }else if( !(algorithm->useBeamConstraint) && ((*iclus).size()>1) ) {
+      }else if( !(algorithm->useBeamConstraint) && (clus.size()>1) ) {
               
-	v = algorithm->fitter->vertex(*iclus);
+	v = fitter.vertex(clus);
         
         if( f4D ) {
           if( v.isValid() ) {
             auto err = v.positionError().matrix4D();
-            err(3,3) = time_var/(double)iclus->size();          
+            err(3,3) = time_var/(double)clus.size();          
             v = TransientVertex(v.position(),meantime,err,v.originalTracks(),v.totalChiSquared());
           }
         }
 	
       }// else: no fit ==> v.isValid()=False
+      return v;
+    };
+
+    // the clusters are disjoint and each fit starts from scratch: they can be done concurrently,
+    // each range of clusters with its own copy of the fitter (which keeps its annealing state)
+    std::vector<TransientVertex> fitted(clusters.size());
+    if (fParallelFits && clusters.size()>1) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, clusters.size(), fitGrainSize),
+                        [&](const tbb::blocked_range<size_t>& r) {
+                          std::unique_ptr<VertexFitter<5> > fitter(algorithm->fitter->clone());
+                          for (size_t i = r.begin(); i != r.end(); ++i) fitted[i] = fitCluster(*fitter, clusters[i]);
+                        });
+    } else {
+      for (size_t i = 0; i < clusters.size(); ++i) fitted[i] = fitCluster(*(algorithm->fitter), clusters[i]);
+    }
 
+    std::vector<TransientVertex> pvs;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      TransientVertex const & v = fitted[i];
 
       if (fVerbose){
 	if (v.isValid()) {
@@ -245,10 +270,10 @@ PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
           if (f4D) std::cout << ",t";
           std::cout << "=" << v.position().x() <<" " << v.position().y() << " " <<  v.position().z();
           if (f4D) std::cout << " " << v.time();
-          std::cout  << " cluster size = " << (*iclus).size() << std::endl;
+          std::cout  << " cluster size = " << clusters[i].size() << std::endl;
         }
 	else{
-	  std::cout <<"Invalid fitted vertex,  cluster size=" << (*iclus).size() << std::endl;
+	  std::cout <<"Invalid fitted vertex,  cluster size=" << clusters[i].size() << std::endl;
 	}
       }
 
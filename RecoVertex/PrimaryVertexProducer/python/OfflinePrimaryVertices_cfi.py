@@ -8,6 +8,8 @@ offlinePrimaryVertices = cms.EDProducer(
     verbose = cms.untracked.bool(False),
     TrackLabel = cms.InputTag("generalTracks"),
     beamSpotLabel = cms.InputTag("offlineBeamSpot"),
+    # fit the vertex candidates concurrently (same result as the serial fits)
+    parallelFits = cms.bool(False),
     
     TkFilterParameters = cms.PSet(
         algorithm=cms.string('filter'),
@@ -8,6 +8,9 @@
 #include <limits>
 #include <iomanip>
 #include "FWCore/Utilities/interface/isFinite.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerTrackBlocks.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "vdt/vdtMath.h"
 
 using namespace std;
@@ -190,7 +193,8 @@ double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
   // define kernels
   auto kernel_calc_exp_arg = [ beta, nv ] ( const unsigned int itrack,
 					     track_t const& tracks,
-					     vertex_t const& vertices ) {
+					     vertex_t const& vertices,
+					     double * __restrict__ ei_cache ) {
     
     const auto track_z = tracks.z_[itrack];
     const auto track_t = tracks.t_[itrack];
@@ -201,77 +205,86 @@ double DAClusterizerInZT_vect::update(double beta, track_t & gtracks,
     for ( unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
       const auto mult_resz = track_z - vertices.z_[ivertex];
       const auto mult_rest = track_t - vertices.t_[ivertex];
-      vertices.ei_cache_[ivertex] = botrack_dz2 * ( mult_resz * mult_resz ) + botrack_dt2 * ( mult_rest * mult_rest );
+      ei_cache[ivertex] = botrack_dz2 * ( mult_resz * mult_resz ) + botrack_dt2 * ( mult_rest * mult_rest );
     }
   };
   
-  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices) -> double
+  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices, const double * __restrict__ ei) -> double
     {
       double ZTemp = Z_init;
       for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {	
-	ZTemp += vertices.pk_[ivertex] * vertices.ei_[ivertex];
+	ZTemp += vertices.pk_[ivertex] * ei[ivertex];
       }
       return ZTemp;
     };
 
+  // accumulates into sums = { se, nuz, nut, swz, swt, szz, stt, szt }
   auto kernel_calc_normalization = [ beta, nv ] (const unsigned int track_num,
-						  track_t & tks_vec,
-						  vertex_t & y_vec ) {
+						  track_t const& tks_vec,
+						  vertex_t const& y_vec,
+						  const double * __restrict__ ei,
+						  double * __restrict__ sums ) {
     auto tmp_trk_pi = tks_vec.pi_[track_num];
     auto o_trk_Z_sum = 1./tks_vec.Z_sum_[track_num];
     auto o_trk_err_z = tks_vec.dz2_[track_num];
     auto o_trk_err_t = tks_vec.dt2_[track_num];
     auto tmp_trk_z = tks_vec.z_[track_num];
     auto tmp_trk_t = tks_vec.t_[track_num];
+    double * __restrict__ se = sums;
+    double * __restrict__ nuz = sums + nv;
+    double * __restrict__ nut = sums + 2*nv;
+    double * __restrict__ swz = sums + 3*nv;
+    double * __restrict__ swt = sums + 4*nv;
+    double * __restrict__ szz = sums + 5*nv;
+    double * __restrict__ stt = sums + 6*nv;
+    double * __restrict__ szt = sums + 7*nv;
 
 
     // auto-vectorized
     for (unsigned int k = 0; k < nv; ++k) {
       // parens are important for numerical stability
-      y_vec.se_[k] +=  tmp_trk_pi*( y_vec.ei_[k] * o_trk_Z_sum );      
-      const auto w = tmp_trk_pi * (y_vec.pk_[k] * y_vec.ei_[k] * o_trk_Z_sum);  // p_{ik}
+      se[k] +=  tmp_trk_pi*( ei[k] * o_trk_Z_sum );      
+      const auto w = tmp_trk_pi * (y_vec.pk_[k] * ei[k] * o_trk_Z_sum);  // p_{ik}
       const auto wz = w * o_trk_err_z; 
       const auto wt = w * o_trk_err_t; 
-      y_vec.nuz_[k] += wz;
-      y_vec.nut_[k] += wt;
-      y_vec.swz_[k] += wz * tmp_trk_z;
-      y_vec.swt_[k] += wt * tmp_trk_t;
+      nuz[k] += wz;
+      nut[k] += wt;
+      swz[k] += wz * tmp_trk_z;
+      swt[k] += wt * tmp_trk_t;
       /* this is really only needed when we want to get Tc too, mayb better to do it elsewhere? */
       const auto dsz = (tmp_trk_z - y_vec.z[k]) * o_trk_err_z;
       const auto dst = (tmp_trk_t - y_vec.t[k]) * o_trk_err_t;
-      y_vec.szz_[k] += w * dsz * dsz;
-      y_vec.stt_[k] += w * dst * dst;
-      y_vec.szt_[k] += w * dsz * dst;
+      szz[k] += w * dsz * dsz;
+      stt[k] += w * dst * dst;
+      szt[k] += w * dsz * dst;
     }
   };
   
-  
-  for (auto ivertex = 0U; ivertex < nv; ++ivertex) {
-    gvertices.se_[ivertex] = 0.0;
-    gvertices.nuz_[ivertex] = 0.0;
-    gvertices.nut_[ivertex] = 0.0;
-    gvertices.swz_[ivertex] = 0.0;
-    gvertices.swt_[ivertex] = 0.0;
-    gvertices.szz_[ivertex] = 0.0;
-    gvertices.stt_[ivertex] = 0.0;
-    gvertices.szt_[ivertex] = 0.0;
-  }
-  
-   
-  // loop over tracks
-  for (auto itrack = 0U; itrack < nt; ++itrack) {
-    kernel_calc_exp_arg(itrack, gtracks, gvertices);
-    local_exp_list(gvertices.ei_cache_, gvertices.ei_, nv);
-        
-    gtracks.Z_sum_[itrack] = kernel_add_Z(gvertices);
-    if (edm::isNotFinite(gtracks.Z_sum_[itrack])) gtracks.Z_sum_[itrack] = 0.0;
-    // used in the next major loop to follow
-    sumpi += gtracks.pi_[itrack];
-    
-    if (gtracks.Z_sum_[itrack] > 1.e-100){
-      kernel_calc_normalization(itrack, gtracks, gvertices);
+  // loop over tracks, in blocks running concurrently
+  auto kernel_track_block = [&] (unsigned int ibegin, unsigned int iend,
+				  double * __restrict__ sums, double * __restrict__ ei_cache, double * __restrict__ ei) {
+    for (auto itrack = ibegin; itrack < iend; ++itrack) {
+      kernel_calc_exp_arg(itrack, gtracks, gvertices, ei_cache);
+      local_exp_list(ei_cache, ei, nv);
+      
+      gtracks.Z_sum_[itrack] = kernel_add_Z(gvertices, ei);
+      if (edm::isNotFinite(gtracks.Z_sum_[itrack])) gtracks.Z_sum_[itrack] = 0.0;
+      
+      if (gtracks.Z_sum_[itrack] > 1.e-100){
+	kernel_calc_normalization(itrack, gtracks, gvertices, ei, sums);
+      }
     }
-  }
+  };
+
+  std::vector<double> sums(8*nv);
+  daclusterizer::accumulateOverTrackBlocks(nt, nv, 8, sums.data(), kernel_track_block);
+  double * const vertexSums[8] = { gvertices.se_, gvertices.nuz_, gvertices.nut_, gvertices.swz_,
+				   gvertices.swt_, gvertices.szz_, gvertices.stt_, gvertices.szt_ };
+  for (unsigned int j = 0; j < 8; ++j)
+    std::copy(sums.begin()+j*nv, sums.begin()+(j+1)*nv, vertexSums[j]);
+
+  // used in the next major loop to follow
+  for (auto itrack = 0U; itrack < nt; ++itrack) sumpi += gtracks.pi_[itrack];
   
   // now update z, t, and pk
   auto kernel_calc_zt = [  sumpi, nv, this, useRho0 ] (vertex_t & vertices ) -> double {
@@ -457,24 +470,23 @@ DAClusterizerInZT_vect::purge(vertex_t & y, track_t & tks, double & rho0, const
   double sumpmin = nt;
   unsigned int k0 = nv;
   
-  int nUnique = 0;
-  double sump = 0;
-
-  std::vector<double> inverse_zsums(nt), arg_cache(nt), eik_cache(nt);
-  double * pinverse_zsums;
-  double * parg_cache;
-  double * peik_cache;
-  pinverse_zsums = inverse_zsums.data();
-  parg_cache = arg_cache.data();
-  peik_cache = eik_cache.data();
+  std::vector<double> inverse_zsums(nt);
+  const double * pinverse_zsums = inverse_zsums.data();
   for(unsigned i = 0; i < nt; ++i) {
     inverse_zsums[i] = tks.Z_sum_[i] > eps ? 1./tks.Z_sum_[i] : 0.0;
   }
 
-  for (unsigned int k = 0; k < nv; ++k) {
+  // the vertices are independent: evaluate them concurrently, then choose in order
+  std::vector<double> sumps(nv);
+  std::vector<int> nUniques(nv);
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nv), [&](tbb::blocked_range<unsigned int> const & r) {
+  std::vector<double> arg_cache(nt), eik_cache(nt);
+  double * parg_cache = arg_cache.data();
+  double * peik_cache = eik_cache.data();
+  for (unsigned int k = r.begin(); k < r.end(); ++k) {
     
-    nUnique = 0;
-    sump = 0;
+    int nUnique = 0;
+    double sump = 0;
 
     const double pmax = y.pk_[k] / (y.pk_[k] + rho0 * local_exp(-beta * dzCutOff_* dzCutOff_));
     const double pcut = uniquetrkweight_ * pmax;
@@ -495,11 +507,16 @@ DAClusterizerInZT_vect::purge(vertex_t & y, track_t & tks, double & rho0, const
       nUnique += ( ( p > pcut ) & ( tks.pi_[i] > 0 ) );
     }
 
-    if ((nUnique < 2) && (sump < sumpmin)) {
-      sumpmin = sump;
+    sumps[k] = sump;
+    nUniques[k] = nUnique;
+  }
+  });
+
+  for (unsigned int k = 0; k < nv; ++k) {
+    if ((nUniques[k] < 2) && (sumps[k] < sumpmin)) {
+      sumpmin = sumps[k];
       k0 = k;
     }
-
   }
   
   if (k0 != nv) {
@@ -619,6 +636,12 @@ DAClusterizerInZT_vect::split(const double beta,  track_t &tks, vertex_t & y, do
   bool split=false;
   const unsigned int nt = tks.getSize();
 
+  // exponentials of all tracks for one vertex, computed in one vectorized pass
+  std::vector<double> arg_cache(nt), soft_cache(nt), eik_cache(nt);
+  double * __restrict__ parg_cache = arg_cache.data();
+  double * __restrict__ psoft_cache = soft_cache.data();
+  double * __restrict__ peik_cache = eik_cache.data();
+
   for(unsigned int ic=0; ic<critical.size(); ic++){
     unsigned int k=critical[ic].second;
 
@@ -641,6 +664,15 @@ DAClusterizerInZT_vect::split(const double beta,  track_t &tks, vertex_t & y, do
     double sq = sin(qsplit);
     if(cq < 0){ cq=-cq; sq=-sq; } // prefer cq>0 to keep z-ordering
 
+    for(unsigned int i=0; i<nt; ++i){
+      double lr = (tks.z_[i]-y.z_[k]) * cq + (tks.t[i] - y.t_[k]) * sq;
+      parg_cache[i] = -( lr * std::sqrt(beta * ( cq*cq*tks.dz2_[i] + sq*sq*tks.dt2_[i] ) ) );
+    }
+    local_exp_list(parg_cache, psoft_cache, nt);
+    for(unsigned int i=0; i<nt; ++i)
+      parg_cache[i] = -beta * Eik(tks.z_[i], y.z_[k], tks.dz2_[i], tks.t_[i], y.t_[k], tks.dt2_[i]);
+    local_exp_list(parg_cache, peik_cache, nt);
+
     // estimate subcluster positions and weight
     double p1=0, z1=0, t1=0, wz1=0, wt1=0;
     double p2=0, z2=0, t2=0, wz2=0, wt2=0;
@@ -654,13 +686,12 @@ DAClusterizerInZT_vect::split(const double beta,  track_t &tks, vertex_t & y, do
 	// soften it, especially at low T	
 	double arg = lr * std::sqrt(beta * ( cq*cq*tks.dz2_[i] + sq*sq*tks.dt2_[i] ) ); 
 	if(std::abs(arg) < 20){
-	  double t = local_exp(-arg);
+	  double t = psoft_cache[i];
 	  tl = t/(t+1.);
 	  tr = 1/(t+1.);
 	}
 
-	double p = y.pk_[k] * tks.pi_[i] * local_exp(-beta * Eik(tks.z_[i], y.z_[k], tks.dz2_[i], 
-                                                                 tks.t_[i], y.t_[k], tks.dt2_[i])) / tks.Z_sum_[i];
+	double p = y.pk_[k] * tks.pi_[i] * peik_cache[i] / tks.Z_sum_[i];
 	double wz = p*tks.dz2_[i];
 	double wt = p*tks.dt2_[i];
 	p1 += p*tl;  z1 += wz*tl*tks.z_[i]; t1 += wt*tl*tks.t_[i]; wz1 += wz*tl; wt1 += wt*tl;
@@ -987,32 +1018,45 @@ DAClusterizerInZT_vect::vertices(const vector<reco::TransientTrack> & tracks, co
   for (unsigned int k = 0; k < nv; k++)
      if ( edm::isNotFinite(y.pk_[k]) || edm::isNotFinite(y.z_[k]) ) { y.pk_[k]=0; y.z_[k]=0;}
 
-  for (unsigned int i = 0; i < nt; i++) // initialize
-    tks.Z_sum_[i] = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_);
-
-  // improve vectorization (does not require reduction ....)
-  for (unsigned int k = 0; k < nv; k++) {
-     for (unsigned int i = 0; i < nt; i++)  
-       tks.Z_sum_[i] += y.pk_[k] * local_exp(-beta * Eik(tks.z_[i], y.z_[k],tks.dz2_[i], tks.t_[i], y.t_[k],tks.dt2_[i]));
+  // a track goes to the first vertex in which it has a probability above mintrkweight
+  // (afterwards its Z is set to 0, which excludes double assignment):
+  // the tracks are independent and are assigned concurrently, in blocks
+  const double Z_init = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_);
+  std::vector<unsigned int> assigned(nt, nv);
+  auto kernel_assign = [&](unsigned int ibegin, unsigned int iend) {
+    std::vector<double> arg_cache(nv), eik_cache(nv);
+    double * __restrict__ parg_cache = arg_cache.data();
+    double * __restrict__ peik_cache = eik_cache.data();
+    for (unsigned int i = ibegin; i < iend; i++) {
+      for (unsigned int k = 0; k < nv; k++)
+	parg_cache[k] = -beta * Eik(tks.z_[i], y.z_[k], tks.dz2_[i], tks.t_[i], y.t_[k], tks.dt2_[i]);
+      local_exp_list(parg_cache, peik_cache, nv);
+      double Z = Z_init;
+      for (unsigned int k = 0; k < nv; k++) Z += y.pk_[k] * peik_cache[k];
+      tks.Z_sum_[i] = Z;
+      if ( !(Z > 1e-100) || !(tks.pi_[i] > 0) ) continue;
+      for (unsigned int k = 0; k < nv; k++) {
+	double p = y.pk_[k] * peik_cache[k] / Z;
+	if (p > mintrkweight_) { assigned[i] = k; break; }
+      }
+    }
+  };
+  const unsigned int nBlocks = (nt + daclusterizer::trackBlockSize - 1) / daclusterizer::trackBlockSize;
+  tbb::parallel_for(0U, nBlocks, [&](unsigned int ib) {
+    kernel_assign(ib*daclusterizer::trackBlockSize, std::min(nt, (ib+1)*daclusterizer::trackBlockSize));
+  });
+
+  std::vector<vector<reco::TransientTrack> > vertexTracks(nv);
+  for (unsigned int i = 0; i < nt; i++) {
+    if (assigned[i] < nv) {
+      vertexTracks[assigned[i]].push_back(*(tks.tt[i]));
+      tks.Z_sum_[i] = 0; // setting Z=0 excludes double assignment
+    }
   }
 
-
   for (unsigned int k = 0; k < nv; k++) {
     GlobalPoint pos(0, 0, y.z_[k]);
-    
-    vector<reco::TransientTrack> vertexTracks;
-    for (unsigned int i = 0; i < nt; i++) {
-      if (tks.Z_sum_[i] > 1e-100) {
-	
-	double p = y.pk_[k] * local_exp(-beta * Eik(tks.z_[i], y.z_[k], tks.dz2_[i],
-                                                    tks.t_[i], y.t_[k], tks.dt2_[i] )) / tks.Z_sum_[i];
-	if ((tks.pi_[i] > 0) && (p > mintrkweight_)) {
-	  vertexTracks.push_back(*(tks.tt[i]));
-	  tks.Z_sum_[i] = 0; // setting Z=0 excludes double assignment
-	}
-      }
-    }
-    TransientVertex v(pos, y.t_[k], dummyError, vertexTracks, 0);
+    TransientVertex v(pos, y.t_[k], dummyError, vertexTracks[k], 0);
     clusters.push_back(v);
   }
 
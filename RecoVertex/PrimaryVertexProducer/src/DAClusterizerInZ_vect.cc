@@ -8,6 +8,9 @@
 #include <limits>
 #include <iomanip>
 #include "FWCore/Utilities/interface/isFinite.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerTrackBlocks.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "vdt/vdtMath.h"
 
 using namespace std;
@@ -165,69 +168,79 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
   // define kernels
   auto kernel_calc_exp_arg = [ beta, nv ] ( const unsigned int itrack,
 					     track_t const& tracks,
-					     vertex_t const& vertices ) {
+					     vertex_t const& vertices,
+					     double * __restrict__ ei_cache ) {
     const double track_z = tracks._z[itrack];
     const double botrack_dz2 = -beta*tracks._dz2[itrack];
 
     // auto-vectorized
     for ( unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
       auto mult_res =  track_z - vertices._z[ivertex];
-      vertices._ei_cache[ivertex] = botrack_dz2 * ( mult_res * mult_res );
+      ei_cache[ivertex] = botrack_dz2 * ( mult_res * mult_res );
     }
   };
   
-  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices) -> double
+  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices, const double * __restrict__ ei) -> double
     {
       double ZTemp = Z_init;
       for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {	
-	ZTemp += vertices._pk[ivertex] * vertices._ei[ivertex];
+	ZTemp += vertices._pk[ivertex] * ei[ivertex];
       }
       return ZTemp;
     };
 
+  // accumulates into sums = { se, sw, swz, swE }
   auto kernel_calc_normalization = [ beta, nv ] (const unsigned int track_num,
-						  track_t & tks_vec,
-						  vertex_t & y_vec ) {
+						  track_t const& tks_vec,
+						  vertex_t const& y_vec,
+						  const double * __restrict__ ei_cache,
+						  const double * __restrict__ ei,
+						  double * __restrict__ sums ) {
     auto tmp_trk_pi = tks_vec._pi[track_num];
     auto o_trk_Z_sum = 1./tks_vec._Z_sum[track_num];
     auto o_trk_dz2 = tks_vec._dz2[track_num];
     auto tmp_trk_z = tks_vec._z[track_num];
     auto obeta =  -1./beta;
+    double * __restrict__ se = sums;
+    double * __restrict__ sw = sums + nv;
+    double * __restrict__ swz = sums + 2*nv;
+    double * __restrict__ swE = sums + 3*nv;
     
     // auto-vectorized
     for (unsigned int k = 0; k < nv; ++k) {
-      y_vec._se[k] +=  y_vec._ei[k] * (tmp_trk_pi* o_trk_Z_sum);
-      auto w = y_vec._pk[k] * y_vec._ei[k] * (tmp_trk_pi*o_trk_Z_sum *o_trk_dz2);
-      y_vec._sw[k]  += w;
-      y_vec._swz[k] += w * tmp_trk_z;
-      y_vec._swE[k] += w * y_vec._ei_cache[k]*obeta;
+      se[k] +=  ei[k] * (tmp_trk_pi* o_trk_Z_sum);
+      auto w = y_vec._pk[k] * ei[k] * (tmp_trk_pi*o_trk_Z_sum *o_trk_dz2);
+      sw[k]  += w;
+      swz[k] += w * tmp_trk_z;
+      swE[k] += w * ei_cache[k]*obeta;
     }
   };
   
-  
-  for (auto ivertex = 0U; ivertex < nv; ++ivertex) {
-    gvertices._se[ivertex] = 0.0;
-    gvertices._sw[ivertex] = 0.0;
-    gvertices._swz[ivertex] = 0.0;
-    gvertices._swE[ivertex] = 0.0;
-  }
-  
-  
-  
-  // loop over tracks
-  for (auto itrack = 0U; itrack < nt; ++itrack) {
-    kernel_calc_exp_arg(itrack, gtracks, gvertices);
-    local_exp_list(gvertices._ei_cache, gvertices._ei, nv);
-    
-    gtracks._Z_sum[itrack] = kernel_add_Z(gvertices);
-    if (edm::isNotFinite(gtracks._Z_sum[itrack])) gtracks._Z_sum[itrack] = 0.0;
-    // used in the next major loop to follow
-    sumpi += gtracks._pi[itrack];
-    
-    if (gtracks._Z_sum[itrack] > 1.e-100){
-      kernel_calc_normalization(itrack, gtracks, gvertices);
+  // loop over tracks, in blocks running concurrently
+  auto kernel_track_block = [&] (unsigned int ibegin, unsigned int iend,
+				  double * __restrict__ sums, double * __restrict__ ei_cache, double * __restrict__ ei) {
+    for (auto itrack = ibegin; itrack < iend; ++itrack) {
+      kernel_calc_exp_arg(itrack, gtracks, gvertices, ei_cache);
+      local_exp_list(ei_cache, ei, nv);
+      
+      gtracks._Z_sum[itrack] = kernel_add_Z(gvertices, ei);
+      if (edm::isNotFinite(gtracks._Z_sum[itrack])) gtracks._Z_sum[itrack] = 0.0;
+      
+      if (gtracks._Z_sum[itrack] > 1.e-100){
+	kernel_calc_normalization(itrack, gtracks, gvertices, ei_cache, ei, sums);
+      }
     }
-  }
+  };
+
+  std::vector<double> sums(4*nv);
+  daclusterizer::accumulateOverTrackBlocks(nt, nv, 4, sums.data(), kernel_track_block);
+  std::copy(sums.begin(),        sums.begin()+nv,   gvertices._se);
+  std::copy(sums.begin()+nv,     sums.begin()+2*nv, gvertices._sw);
+  std::copy(sums.begin()+2*nv,   sums.begin()+3*nv, gvertices._swz);
+  std::copy(sums.begin()+3*nv,   sums.end(),        gvertices._swE);
+
+  // used in the next major loop to follow
+  for (auto itrack = 0U; itrack < nt; ++itrack) sumpi += gtracks._pi[itrack];
   
   // now update z and pk
   auto kernel_calc_z = [  sumpi, nv, this, useRho0 ] (vertex_t & vertices ) -> double {
@@ -329,27 +342,39 @@ DAClusterizerInZ_vect::purge(vertex_t & y, track_t & tks, double & rho0, const d
   double sumpmin = nt;
   unsigned int k0 = nv;
   
-  for (unsigned int k = 0; k < nv; k++) {
-    
-    int nUnique = 0;
-    double sump = 0;
-
-    double pmax = y._pk[k] / (y._pk[k] + rho0 * local_exp(-beta * dzCutOff_* dzCutOff_));
-    for (unsigned int i = 0; i < nt; i++) {
-      if (tks._Z_sum[i] > 1.e-100) {
-	double p = y._pk[k] * local_exp(-beta * Eik(tks._z[i], y._z[k], tks._dz2[i])) / tks._Z_sum[i];
-	sump += p;
-	if ((p > uniquetrkweight_ * pmax) && (tks._pi[i] > 0)) {
-	  nUnique++;
+  // the vertices are independent: evaluate them concurrently, then choose in order
+  std::vector<double> sumps(nv);
+  std::vector<int> nUniques(nv);
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nv), [&](tbb::blocked_range<unsigned int> const & r) {
+    std::vector<double> arg_cache(nt), eik_cache(nt);
+    double * __restrict__ parg_cache = arg_cache.data();
+    double * __restrict__ peik_cache = eik_cache.data();
+    for (unsigned int k = r.begin(); k < r.end(); k++) {
+      
+      int nUnique = 0;
+      double sump = 0;
+      
+      double pmax = y._pk[k] / (y._pk[k] + rho0 * local_exp(-beta * dzCutOff_* dzCutOff_));
+      const double pcut = uniquetrkweight_ * pmax;
+      for (unsigned int i = 0; i < nt; i++) parg_cache[i] = -beta * Eik(tks._z[i], y._z[k], tks._dz2[i]);
+      local_exp_list(parg_cache, peik_cache, nt);
+      for (unsigned int i = 0; i < nt; i++) {
+	if (tks._Z_sum[i] > 1.e-100) {
+	  double p = y._pk[k] * peik_cache[i] / tks._Z_sum[i];
+	  sump += p;
+	  nUnique += ( (p > pcut) & (tks._pi[i] > 0) );
 	}
       }
+      sumps[k] = sump;
+      nUniques[k] = nUnique;
     }
+  });
 
-    if ((nUnique < 2) && (sump < sumpmin)) {
-      sumpmin = sump;
+  for (unsigned int k = 0; k < nv; k++) {
+    if ((nUniques[k] < 2) && (sumps[k] < sumpmin)) {
+      sumpmin = sumps[k];
       k0 = k;
     }
-
   }
   
   if (k0 != nv) {
@@ -445,9 +470,20 @@ DAClusterizerInZ_vect::split(const double beta,  track_t &tks, vertex_t & y, dou
   bool split=false;
   const unsigned int nt = tks.GetSize();
 
+  // exponentials of all tracks for one vertex, computed in one vectorized pass
+  std::vector<double> arg_cache(nt), soft_cache(nt), eik_cache(nt);
+  double * __restrict__ parg_cache = arg_cache.data();
+  double * __restrict__ psoft_cache = soft_cache.data();
+  double * __restrict__ peik_cache = eik_cache.data();
+
   for(unsigned int ic=0; ic<critical.size(); ic++){
     unsigned int k=critical[ic].second;
 
+    for(unsigned int i=0; i<nt; i++) parg_cache[i] = -(tks._z[i] - y._z[k]) * sqrt(beta * tks._dz2[i]);
+    local_exp_list(parg_cache, psoft_cache, nt);
+    for(unsigned int i=0; i<nt; i++) parg_cache[i] = -beta * Eik(tks._z[i], y._z[k], tks._dz2[i]);
+    local_exp_list(parg_cache, peik_cache, nt);
+
     // estimate subcluster positions and weight
     double p1=0, z1=0, w1=0;
     double p2=0, z2=0, w2=0;
@@ -461,12 +497,12 @@ DAClusterizerInZ_vect::split(const double beta,  track_t &tks, vertex_t & y, dou
 	 // soften it, especially at low T
 	double arg = (tks._z[i] - y._z[k]) * sqrt(beta * tks._dz2[i]);
 	if(std::fabs(arg) < 20){
-	  double t = local_exp(-arg);
+	  double t = psoft_cache[i];
 	  tl = t/(t+1.);
 	  tr = 1/(t+1.);
 	}
 
-	double p = y._pk[k] * tks._pi[i] * local_exp(-beta * Eik(tks._z[i], y._z[k], tks._dz2[i])) / tks._Z_sum[i];
+	double p = y._pk[k] * tks._pi[i] * peik_cache[i] / tks._Z_sum[i];
 	double w = p*tks._dz2[i];
 	p1 += p*tl ; z1 += w*tl*tks._z[i]; w1 += w*tl;
 	p2 += p*tr;  z2 += w*tr*tks._z[i]; w2 += w*tr;
@@ -710,32 +746,44 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
   for (unsigned int k = 0; k < nv; k++)
      if ( edm::isNotFinite(y._pk[k]) || edm::isNotFinite(y._z[k]) ) { y._pk[k]=0; y._z[k]=0;}
 
-  for (unsigned int i = 0; i < nt; i++) // initialize
-    tks._Z_sum[i] = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_);
-
-  // improve vectorization (does not require reduction ....)
-  for (unsigned int k = 0; k < nv; k++) {
-     for (unsigned int i = 0; i < nt; i++)  
-      tks._Z_sum[i] += y._pk[k] * local_exp(-beta * Eik(tks._z[i], y._z[k],tks._dz2[i]));
+  // a track goes to the first vertex in which it has a probability above mintrkweight
+  // (afterwards its Z is set to 0, which excludes double assignment):
+  // the tracks are independent and are assigned concurrently, in blocks
+  const double Z_init = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_);
+  std::vector<unsigned int> assigned(nt, nv);
+  auto kernel_assign = [&](unsigned int ibegin, unsigned int iend) {
+    std::vector<double> arg_cache(nv), eik_cache(nv);
+    double * __restrict__ parg_cache = arg_cache.data();
+    double * __restrict__ peik_cache = eik_cache.data();
+    for (unsigned int i = ibegin; i < iend; i++) {
+      for (unsigned int k = 0; k < nv; k++) parg_cache[k] = -beta * Eik(tks._z[i], y._z[k], tks._dz2[i]);
+      local_exp_list(parg_cache, peik_cache, nv);
+      double Z = Z_init;
+      for (unsigned int k = 0; k < nv; k++) Z += y._pk[k] * peik_cache[k];
+      tks._Z_sum[i] = Z;
+      if ( !(Z > 1e-100) || !(tks._pi[i] > 0) ) continue;
+      for (unsigned int k = 0; k < nv; k++) {
+	double p = y._pk[k] * peik_cache[k] / Z;
+	if (p > mintrkweight_) { assigned[i] = k; break; }
+      }
+    }
+  };
+  const unsigned int nBlocks = (nt + daclusterizer::trackBlockSize - 1) / daclusterizer::trackBlockSize;
+  tbb::parallel_for(0U, nBlocks, [&](unsigned int ib) {
+    kernel_assign(ib*daclusterizer::trackBlockSize, std::min(nt, (ib+1)*daclusterizer::trackBlockSize));
+  });
+
+  std::vector<vector<reco::TransientTrack> > vertexTracks(nv);
+  for (unsigned int i = 0; i < nt; i++) {
+    if (assigned[i] < nv) {
+      vertexTracks[assigned[i]].push_back(*(tks.tt[i]));
+      tks._Z_sum[i] = 0; // setting Z=0 excludes double assignment
+    }
   }
 
-
   for (unsigned int k = 0; k < nv; k++) {
     GlobalPoint pos(0, 0, y._z[k]);
-    
-    vector<reco::TransientTrack> vertexTracks;
-    for (unsigned int i = 0; i < nt; i++) {
-      if (tks._Z_sum[i] > 1e-100) {
-	
-	double p = y._pk[k] * local_exp(-beta * Eik(tks._z[i], y._z[k],
-						    tks._dz2[i])) / tks._Z_sum[i];
-	if ((tks._pi[i] > 0) && (p > mintrkweight_)) {
-	  vertexTracks.push_back(*(tks.tt[i]));
-	  tks._Z_sum[i] = 0; // setting Z=0 excludes double assignment
-	}
-      }
-    }
-    TransientVertex v(pos, dummyError, vertexTracks, 0);
+    TransientVertex v(pos, dummyError, vertexTracks[k], 0);
     clusters.push_back(v);
   }
 
@@ -0,0 +1,86 @@
+// Scaling of the per-vertex track sums of the DA clusterizer (DAClusterizerInZ_vect::update)
+// with the number of tracks, and check that the result does not depend on the number of threads.
+
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZ_vect.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "tbb/task_arena.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace {
+
+  edm::ParameterSet config() {
+    edm::ParameterSet conf;
+    conf.addParameter<double>("Tmin", 2.0);
+    conf.addParameter<double>("Tpurge", 2.0);
+    conf.addParameter<double>("Tstop", 0.5);
+    conf.addParameter<double>("vertexSize", 0.006);
+    conf.addParameter<double>("coolingFactor", 0.6);
+    conf.addParameter<double>("d0CutOff", 3.);
+    conf.addParameter<double>("dzCutOff", 3.);
+    conf.addParameter<double>("uniquetrkweight", 0.8);
+    conf.addParameter<double>("zmerge", 1.e-2);
+    return conf;
+  }
+
+  // nv vertices spread along the beamline, nt tracks shared among them
+  void generate(unsigned int nt, unsigned int nv,
+                DAClusterizerInZ_vect::track_t & tks, DAClusterizerInZ_vect::vertex_t & y) {
+    std::mt19937 gen(12345);
+    std::normal_distribution<double> zv(0.,4.), g(0.,1.);
+    std::vector<double> zvtx(nv);
+    for (auto & z : zvtx) { z = zv(gen); y.AddItem(z, 1./nv); }
+    for (unsigned int i=0; i<nt; ++i) {
+      double dz = 0.005+0.03*std::abs(g(gen));
+      tks.AddItem(zvtx[i%nv]+dz*g(gen), dz*dz, nullptr, 1.);
+    }
+    tks.ExtractRaw();
+  }
+
+}
+
+int main() {
+  DAClusterizerInZ_vect clusterizer(config());
+  const double beta = 1./4.;
+  const int nRepeat = 20;
+
+  for (unsigned int nt : {1000, 2000, 5000, 10000}) {
+    const unsigned int nv = nt/50;
+
+    // single thread reference
+    DAClusterizerInZ_vect::track_t tks1;
+    DAClusterizerInZ_vect::vertex_t y1;
+    generate(nt, nv, tks1, y1);
+    double delta1 = 0;
+    tbb::task_arena single(1);
+    single.execute([&] { delta1 = clusterizer.update(beta, tks1, y1, false, 0.); });
+
+    // all threads, timed; each update starts from the same prototypes
+    DAClusterizerInZ_vect::track_t tks;
+    DAClusterizerInZ_vect::vertex_t y;
+    double delta = 0;
+    std::chrono::duration<double,std::micro> elapsed(0);
+    for (int i=0; i<nRepeat; ++i) {
+      tks = DAClusterizerInZ_vect::track_t(); y = DAClusterizerInZ_vect::vertex_t();
+      generate(nt, nv, tks, y);
+      auto start = std::chrono::steady_clock::now();
+      delta = clusterizer.update(beta, tks, y, false, 0.);
+      elapsed += std::chrono::steady_clock::now()-start;
+    }
+
+    // bitwise identical, whatever the number of threads
+    assert(delta==delta1);
+    assert(std::memcmp(y.z.data(), y1.z.data(), nv*sizeof(double))==0);
+    assert(std::memcmp(y.pk.data(), y1.pk.data(), nv*sizeof(double))==0);
+    assert(std::memcmp(tks.Z_sum.data(), tks1.Z_sum.data(), nt*sizeof(double))==0);
+
+    std::cout << "tracks " << nt << " vertices " << nv << ": "
+              << elapsed.count()/nRepeat << " us per update" << std::endl;
+  }
+  return 0;
+}
@@ -60,6 +60,16 @@ private:
   /// propagate through the whole detector, returns true if successful
   bool propagateAll(const SteppingHelixStateInfo& initialState) dso_internal;
   
+  /// states filled by propagateAll
+  const std::deque<SteppingHelixStateInfo>& getFullTrajectory() const dso_internal { return fullTrajectory_; }
+  
+  /// use the states of a previous propagateAll instead of propagating again
+  void setFullTrajectory(const std::deque<SteppingHelixStateInfo>& trajectory) dso_internal {
+    reset_trajectory();
+    fullTrajectory_ = trajectory;
+    fullTrajectoryFilled_ = true;
+  }
+  
   void propagateForward(SteppingHelixStateInfo& state, float distance) dso_internal;
   void propagate(SteppingHelixStateInfo& state, const Plane& plane) dso_internal;
   void propagate(SteppingHelixStateInfo& state, const Cylinder& cylinder) dso_internal;
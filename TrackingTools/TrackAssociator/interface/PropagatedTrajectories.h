@@ -0,0 +1,73 @@
+#ifndef TrackAssociator_PropagatedTrajectories_h
+#define TrackAssociator_PropagatedTrajectories_h 1
+
+// -*- C++ -*-
+//
+// Package:    TrackAssociator
+// Class:      PropagatedTrajectories
+//
+/*
+
+ Description: transient event product with the trajectories of the tracks
+ * of a collection propagated through the detector (CachedTrajectory::propagateAll),
+ * keyed by track ref. It is filled by PropagatedTrajectoryProducer, so that
+ * the associators of the event (muon ID, isolation, ...) don't propagate
+ * the same track again.
+ *
+ * Each trajectory is stored with the state it was propagated from and the
+ * limits of the propagation: TrackDetectorAssociator only uses it if they
+ * are the ones it would use itself, and propagates the track otherwise.
+
+*/
+//
+
+#include "DataFormats/Provenance/interface/ProductID.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+#include "DataFormats/GeometryVector/interface/GlobalVector.h"
+#include "TrackPropagation/SteppingHelixPropagator/interface/SteppingHelixStateInfo.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+class PropagatedTrajectories {
+ public:
+   typedef std::deque<SteppingHelixStateInfo> Trajectory;
+
+   struct Entry {
+      Entry(): propagated(false), step(0), minRho(0), minZ(0), maxRho(0), maxZ(0) {}
+
+      /// false if the track was not propagated (e.g. below the momentum thresholds)
+      bool propagated;
+      /// state the trajectory was propagated from
+      GlobalPoint originPosition;
+      GlobalVector originMomentum;
+      /// limits of the propagation
+      float step;
+      float minRho;
+      float minZ;
+      float maxRho;
+      float maxZ;
+      /// empty if the propagation failed
+      Trajectory trajectory;
+   };
+
+   PropagatedTrajectories() {}
+   /// propagator: label of the propagator used for all the tracks
+   PropagatedTrajectories(const edm::ProductID& tracks, unsigned int size, const std::string& propagator):
+     tracks_(tracks), propagator_(propagator), entries_(size) {}
+
+   const std::string& propagator() const { return propagator_; }
+
+   /// null if the track is not in the collection or was not propagated
+   const Entry* find(const reco::TrackRef& track) const;
+
+   Entry& operator[](unsigned int key) { return entries_[key]; }
+
+ private:
+   edm::ProductID tracks_;
+   std::string propagator_;
+   std::vector<Entry> entries_;
+};
+#endif
@@ -33,6 +33,7 @@
 #include "TrackingTools/TrackAssociator/interface/DetIdAssociator.h"
 #include "TrackingTools/TrackAssociator/interface/TrackDetMatchInfo.h"
 #include "TrackingTools/TrackAssociator/interface/CachedTrajectory.h"
+#include "TrackingTools/TrackAssociator/interface/PropagatedTrajectories.h"
 
 #include "DataFormats/CaloTowers/interface/CaloTower.h"
 #include "DataFormats/EcalRecHit/interface/EcalRecHit.h"
@@ -85,6 +86,21 @@ class TrackDetectorAssociator {
 					   const reco::Track&,
 					   const AssociatorParameters&,
 					   Direction direction = Any );
+   /// associate using reco::TrackRef, with the trajectory of the track
+   /// in the event product if it was propagated alike
+   TrackDetMatchInfo            associate( const edm::Event&,
+					   const edm::EventSetup&,
+					   const reco::TrackRef&,
+					   const PropagatedTrajectories&,
+					   const AssociatorParameters&,
+					   Direction direction = Any );
+   /// propagate a track through the detector as associate() does,
+   /// returns false if the propagation failed
+   bool                         propagate( const edm::EventSetup&,
+					   const reco::Track&,
+					   const AssociatorParameters&,
+					   PropagatedTrajectories::Entry&,
+					   Direction direction = Any );
    /// associate using a simulated track
    TrackDetMatchInfo            associate( const edm::Event&,
 					   const edm::EventSetup&,
@@ -162,6 +178,39 @@ class TrackDetectorAssociator {
   
    void           init( const edm::EventSetup&) dso_internal;
    
+   /// states to propagate a track from, and whether it is propagated outside-in;
+   /// returns false if there is no outer state
+   bool getTrackStates( const edm::EventSetup&,
+			const reco::Track&,
+			Direction,
+			FreeTrajectoryState& innerState,
+			FreeTrajectoryState& outerState,
+			bool& outsideIn ) dso_internal;
+   
+   TrackDetMatchInfo associate( const edm::Event&,
+				const edm::EventSetup&,
+				const reco::Track&,
+				const AssociatorParameters&,
+				Direction,
+				const PropagatedTrajectories::Entry* ) dso_internal;
+   
+   TrackDetMatchInfo associate( const edm::Event&,
+				const edm::EventSetup&,
+				const AssociatorParameters&,
+				const FreeTrajectoryState* innerState,
+				const FreeTrajectoryState* outerState,
+				const PropagatedTrajectories::Entry* ) dso_internal;
+   
+   /// fill the trajectory of cachedTrajectory_, from the propagated one if
+   /// it has the same origin and limits, and copy it to toFill if not null;
+   /// returns false if there is none
+   bool fillTrajectory( const edm::EventSetup&,
+			const AssociatorParameters&,
+			const FreeTrajectoryState* innerState,
+			const FreeTrajectoryState* outerState,
+			const PropagatedTrajectories::Entry* propagated,
+			PropagatedTrajectories::Entry* toFill ) dso_internal;
+   
    math::XYZPoint getPoint( const GlobalPoint& point)  dso_internal
      {
 	return math::XYZPoint(point.x(),point.y(),point.z());
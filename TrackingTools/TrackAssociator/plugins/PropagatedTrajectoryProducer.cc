@@ -0,0 +1,114 @@
+// -*- C++ -*-
+//
+// Package:    TrackAssociator
+// Class:      PropagatedTrajectoryProducer
+//
+/*
+
+ Description: propagates each track of a collection once through the detector,
+ * as TrackDetectorAssociator::associate does, and puts the trajectories in the
+ * event (PropagatedTrajectories) for the associators of the modules that
+ * consume them.
+ *
+ * The propagator, the direction and the TrackAssociatorParameters (useMuon
+ * sets the propagation limits) must be the ones of the consumers: the
+ * associators propagate again the tracks for which they don't match.
+
+*/
+//
+
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "TrackingTools/GeomPropagators/interface/Propagator.h"
+#include "TrackingTools/Records/interface/TrackingComponentsRecord.h"
+#include "TrackingTools/TrackAssociator/interface/PropagatedTrajectories.h"
+#include "TrackingTools/TrackAssociator/interface/TrackAssociatorParameters.h"
+#include "TrackingTools/TrackAssociator/interface/TrackDetectorAssociator.h"
+
+class PropagatedTrajectoryProducer : public edm::stream::EDProducer<> {
+ public:
+   explicit PropagatedTrajectoryProducer(const edm::ParameterSet&);
+
+   void produce(edm::Event&, const edm::EventSetup&) override;
+
+   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+ private:
+   edm::EDGetTokenT<reco::TrackCollection> tracksToken_;
+   // ES label of the propagator, the default propagator of the associator if empty
+   std::string propagatorName_;
+   TrackDetectorAssociator::Direction direction_;
+   double minPt_;
+   double minP_;
+
+   TrackDetectorAssociator trackAssociator_;
+   TrackAssociatorParameters parameters_;
+};
+
+PropagatedTrajectoryProducer::PropagatedTrajectoryProducer(const edm::ParameterSet& iConfig):
+  tracksToken_(consumes<reco::TrackCollection>(iConfig.getParameter<edm::InputTag>("tracks"))),
+  propagatorName_(iConfig.getParameter<std::string>("propagator")),
+  minPt_(iConfig.getParameter<double>("minPt")),
+  minP_(iConfig.getParameter<double>("minP"))
+{
+   const std::string direction = iConfig.getParameter<std::string>("direction");
+   if (direction == "Any") direction_ = TrackDetectorAssociator::Any;
+   else if (direction == "InsideOut") direction_ = TrackDetectorAssociator::InsideOut;
+   else if (direction == "OutsideIn") direction_ = TrackDetectorAssociator::OutsideIn;
+   else throw cms::Exception("ConfigurationError") << "Unknown propagation direction " << direction
+						    << ", use Any, InsideOut or OutsideIn";
+
+   edm::ConsumesCollector iC = consumesCollector();
+   parameters_.loadParameters(iConfig.getParameter<edm::ParameterSet>("TrackAssociatorParameters"), iC);
+
+   if (propagatorName_.empty()) trackAssociator_.useDefaultPropagator();
+
+   produces<PropagatedTrajectories>();
+}
+
+void PropagatedTrajectoryProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+   if (! propagatorName_.empty()) {
+      edm::ESHandle<Propagator> propagator;
+      iSetup.get<TrackingComponentsRecord>().get(propagatorName_, propagator);
+      trackAssociator_.setPropagator(propagator.product());
+   }
+
+   edm::Handle<reco::TrackCollection> tracks;
+   iEvent.getByToken(tracksToken_, tracks);
+
+   auto trajectories = std::make_unique<PropagatedTrajectories>(tracks.id(), tracks->size(), propagatorName_);
+   for (unsigned int i = 0; i < tracks->size(); ++i) {
+      const reco::Track& track = (*tracks)[i];
+      if (track.pt() < minPt_ || track.p() < minP_) continue;
+      trackAssociator_.propagate(iSetup, track, parameters_, (*trajectories)[i], direction_);
+   }
+
+   iEvent.put(std::move(trajectories));
+}
+
+void PropagatedTrajectoryProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
+{
+   edm::ParameterSetDescription desc;
+   desc.add<edm::InputTag>("tracks", edm::InputTag("generalTracks"));
+   desc.add<std::string>("propagator", "SteppingHelixPropagatorAny")->setComment("empty for the default propagator of the associator");
+   desc.add<std::string>("direction", "Any")->setComment("Any, InsideOut or OutsideIn");
+   desc.add<double>("minPt", 0.5);
+   desc.add<double>("minP", 2.5);
+   edm::ParameterSetDescription descTrkAsoPar;
+   descTrkAsoPar.setAllowAnything();
+   desc.add<edm::ParameterSetDescription>("TrackAssociatorParameters", descTrkAsoPar);
+   descriptions.addDefault(desc);
+}
+
+DEFINE_FWK_MODULE(PropagatedTrajectoryProducer);
@@ -0,0 +1,17 @@
+import FWCore.ParameterSet.Config as cms
+
+from TrackingTools.TrackAssociator.default_cfi import TrackAssociatorParameterBlock
+
+# Trajectories of the tracks propagated through the detector once per event,
+# for the modules using a TrackDetectorAssociator configured alike
+# (same propagator, direction and TrackAssociatorParameters)
+propagatedTrajectories = cms.EDProducer("PropagatedTrajectoryProducer",
+    TrackAssociatorParameterBlock,
+    tracks = cms.InputTag("generalTracks"),
+    # ES label of the propagator, empty for the default propagator of the associator
+    propagator = cms.string("SteppingHelixPropagatorAny"),
+    # Any, InsideOut or OutsideIn
+    direction = cms.string("Any"),
+    minPt = cms.double(0.5),
+    minP = cms.double(2.5)
+)
@@ -0,0 +1,17 @@
+// -*- C++ -*-
+//
+// Package:    TrackAssociator
+// Class:      PropagatedTrajectories
+//
+//
+//
+
+#include "TrackingTools/TrackAssociator/interface/PropagatedTrajectories.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+const PropagatedTrajectories::Entry* PropagatedTrajectories::find(const reco::TrackRef& track) const
+{
+   if (track.isNull() || track.id() != tracks_ || track.key() >= entries_.size()) return nullptr;
+   const Entry& entry = entries_[track.key()];
+   return entry.propagated ? &entry : nullptr;
+}
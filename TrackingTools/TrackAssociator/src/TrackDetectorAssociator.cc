@@ -172,6 +172,16 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
 						      const AssociatorParameters& parameters,
 						      const FreeTrajectoryState* innerState,
 						      const FreeTrajectoryState* outerState)
+{
+   return associate(iEvent, iSetup, parameters, innerState, outerState, nullptr);
+}
+
+TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
+						      const edm::EventSetup& iSetup,
+						      const AssociatorParameters& parameters,
+						      const FreeTrajectoryState* innerState,
+						      const FreeTrajectoryState* outerState,
+						      const PropagatedTrajectories::Entry* propagated)
 {
    TrackDetMatchInfo info;
    if (! parameters.useEcal && ! parameters.useCalo && ! parameters.useHcal &&
@@ -179,8 +189,45 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
      throw cms::Exception("ConfigurationError") << 
      "Configuration error! No subdetector was selected for the track association.";
    
-   SteppingHelixStateInfo trackOrigin(*innerState);
    info.stateAtIP = *innerState;
+   
+   const bool hasTrajectory = fillTrajectory(iSetup, parameters, innerState, outerState, propagated, nullptr);
+   info.setCaloGeometry(theCaloGeometry_);
+   if ( ! hasTrajectory ) return info;
+   
+   // get trajectory in calorimeters
+   cachedTrajectory_.findEcalTrajectory( ecalDetIdAssociator_->volume() );
+   cachedTrajectory_.findHcalTrajectory( hcalDetIdAssociator_->volume() );
+   cachedTrajectory_.findHOTrajectory( hoDetIdAssociator_->volume() );
+   cachedTrajectory_.findPreshowerTrajectory( preshowerDetIdAssociator_->volume() );
+
+   info.trkGlobPosAtEcal = getPoint( cachedTrajectory_.getStateAtEcal().position() );
+   info.trkGlobPosAtHcal = getPoint( cachedTrajectory_.getStateAtHcal().position() );
+   info.trkGlobPosAtHO  = getPoint( cachedTrajectory_.getStateAtHO().position() );
+   
+   info.trkMomAtEcal = cachedTrajectory_.getStateAtEcal().momentum();
+   info.trkMomAtHcal = cachedTrajectory_.getStateAtHcal().momentum();
+   info.trkMomAtHO   = cachedTrajectory_.getStateAtHO().momentum();
+   
+   if (parameters.useEcal) fillEcal( iEvent, info, parameters);
+   if (parameters.useCalo) fillCaloTowers( iEvent, info, parameters);
+   if (parameters.useHcal) fillHcal( iEvent, info, parameters);
+   if (parameters.useHO)   fillHO( iEvent, info, parameters);
+   if (parameters.usePreshower) fillPreshower( iEvent, info, parameters);
+   if (parameters.useMuon) fillMuon( iEvent, info, parameters);
+   if (parameters.truthMatch) fillCaloTruth( iEvent, info, parameters);
+   
+   return info;
+}
+
+bool TrackDetectorAssociator::fillTrajectory( const edm::EventSetup& iSetup,
+					      const AssociatorParameters& parameters,
+					      const FreeTrajectoryState* innerState,
+					      const FreeTrajectoryState* outerState,
+					      const PropagatedTrajectories::Entry* propagated,
+					      PropagatedTrajectories::Entry* toFill )
+{
+   SteppingHelixStateInfo trackOrigin(*innerState);
    cachedTrajectory_.setStateAtIP(trackOrigin);
    
    init( iSetup );
@@ -193,8 +240,6 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
    // in the barrel, a track should have P_t as low as 3 GeV or smaller
    // If it's necessary, number of points along trajectory can be increased
    
-   info.setCaloGeometry(theCaloGeometry_);
-   
    cachedTrajectory_.reset_trajectory();
    // estimate propagation outer boundaries based on 
    // requested sub-detector information. For now limit
@@ -234,33 +279,39 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
      }
    }
 
-   if ( trackOrigin.momentum().mag() == 0 ) return info;
-   if ( edm::isNotFinite(trackOrigin.momentum().x()) or edm::isNotFinite(trackOrigin.momentum().y()) or edm::isNotFinite(trackOrigin.momentum().z()) ) return info;
-   if ( ! cachedTrajectory_.propagateAll(trackOrigin) ) return info;
-   
-   // get trajectory in calorimeters
-   cachedTrajectory_.findEcalTrajectory( ecalDetIdAssociator_->volume() );
-   cachedTrajectory_.findHcalTrajectory( hcalDetIdAssociator_->volume() );
-   cachedTrajectory_.findHOTrajectory( hoDetIdAssociator_->volume() );
-   cachedTrajectory_.findPreshowerTrajectory( preshowerDetIdAssociator_->volume() );
+   if ( toFill ) {
+      toFill->propagated = true;
+      toFill->originPosition = trackOrigin.position();
+      toFill->originMomentum = trackOrigin.momentum();
+      toFill->step = cachedTrajectory_.step_;
+      toFill->minRho = cachedTrajectory_.minRho_;
+      toFill->minZ = cachedTrajectory_.minZ_;
+      toFill->maxRho = cachedTrajectory_.maxRho_;
+      toFill->maxZ = cachedTrajectory_.maxZ_;
+      toFill->trajectory.clear();
+   }
 
-   info.trkGlobPosAtEcal = getPoint( cachedTrajectory_.getStateAtEcal().position() );
-   info.trkGlobPosAtHcal = getPoint( cachedTrajectory_.getStateAtHcal().position() );
-   info.trkGlobPosAtHO  = getPoint( cachedTrajectory_.getStateAtHO().position() );
-   
-   info.trkMomAtEcal = cachedTrajectory_.getStateAtEcal().momentum();
-   info.trkMomAtHcal = cachedTrajectory_.getStateAtHcal().momentum();
-   info.trkMomAtHO   = cachedTrajectory_.getStateAtHO().momentum();
-   
-   if (parameters.useEcal) fillEcal( iEvent, info, parameters);
-   if (parameters.useCalo) fillCaloTowers( iEvent, info, parameters);
-   if (parameters.useHcal) fillHcal( iEvent, info, parameters);
-   if (parameters.useHO)   fillHO( iEvent, info, parameters);
-   if (parameters.usePreshower) fillPreshower( iEvent, info, parameters);
-   if (parameters.useMuon) fillMuon( iEvent, info, parameters);
-   if (parameters.truthMatch) fillCaloTruth( iEvent, info, parameters);
+   if ( trackOrigin.momentum().mag() == 0 ) return false;
+   if ( edm::isNotFinite(trackOrigin.momentum().x()) or edm::isNotFinite(trackOrigin.momentum().y()) or edm::isNotFinite(trackOrigin.momentum().z()) ) return false;
    
-   return info;
+   // the trajectory propagated beforehand is the one propagateAll would give
+   // if it starts from the same state with the same limits
+   if ( propagated &&
+	propagated->originPosition == trackOrigin.position() &&
+	propagated->originMomentum == trackOrigin.momentum() &&
+	propagated->step == cachedTrajectory_.step_ &&
+	propagated->minRho == cachedTrajectory_.minRho_ &&
+	propagated->minZ == cachedTrajectory_.minZ_ &&
+	propagated->maxRho == cachedTrajectory_.maxRho_ &&
+	propagated->maxZ == cachedTrajectory_.maxZ_ ) {
+      LogTrace("TrackAssociator") << "Using the propagated trajectory with " << propagated->trajectory.size() << " states\n";
+      if ( propagated->trajectory.empty() ) return false;
+      cachedTrajectory_.setFullTrajectory(propagated->trajectory);
+      return true;
+   }
+   if ( ! cachedTrajectory_.propagateAll(trackOrigin) ) return false;
+   if ( toFill ) toFill->trajectory = cachedTrajectory_.getFullTrajectory();
+   return true;
 }
 
 void TrackDetectorAssociator::fillEcal( const edm::Event& iEvent,
@@ -996,91 +1047,147 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
 						      const reco::Track& track,
 						      const AssociatorParameters& parameters,
 						      Direction direction /*= Any*/ )
+{
+   return associate(iEvent, iSetup, track, parameters, direction, nullptr);
+}
+
+TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
+						      const edm::EventSetup& iSetup,
+						      const reco::TrackRef& track,
+						      const PropagatedTrajectories& trajectories,
+						      const AssociatorParameters& parameters,
+						      Direction direction /*= Any*/ )
+{
+   return associate(iEvent, iSetup, *track, parameters, direction, trajectories.find(track));
+}
+
+TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
+						      const edm::EventSetup& iSetup,
+						      const reco::Track& track,
+						      const AssociatorParameters& parameters,
+						      Direction direction,
+						      const PropagatedTrajectories::Entry* propagated )
+{
+   double currentStepSize = cachedTrajectory_.getPropagationStep();
+   
+   FreeTrajectoryState innerState, outerState;
+   bool outsideIn = false;
+   const bool hasOuterState = getTrackStates(iSetup, track, direction, innerState, outerState, outsideIn);
+   
+   if ( outsideIn ) cachedTrajectory_.setPropagationStep( -fabs(currentStepSize) );
+   TrackDetMatchInfo result = associate(iEvent, iSetup, parameters, &innerState, hasOuterState ? &outerState : nullptr, propagated);
+   if ( outsideIn ) cachedTrajectory_.setPropagationStep( currentStepSize );
+   return result;
+}
+
+bool TrackDetectorAssociator::propagate( const edm::EventSetup& iSetup,
+					 const reco::Track& track,
+					 const AssociatorParameters& parameters,
+					 PropagatedTrajectories::Entry& entry,
+					 Direction direction /*= Any*/ )
 {
    double currentStepSize = cachedTrajectory_.getPropagationStep();
    
+   FreeTrajectoryState innerState, outerState;
+   bool outsideIn = false;
+   const bool hasOuterState = getTrackStates(iSetup, track, direction, innerState, outerState, outsideIn);
+   
+   if ( outsideIn ) cachedTrajectory_.setPropagationStep( -fabs(currentStepSize) );
+   const bool propagated = fillTrajectory(iSetup, parameters, &innerState, hasOuterState ? &outerState : nullptr, nullptr, &entry);
+   if ( outsideIn ) cachedTrajectory_.setPropagationStep( currentStepSize );
+   return propagated;
+}
+
+bool TrackDetectorAssociator::getTrackStates( const edm::EventSetup& iSetup,
+					      const reco::Track& track,
+					      Direction direction,
+					      FreeTrajectoryState& innerState,
+					      FreeTrajectoryState& outerState,
+					      bool& outsideIn )
+{
    edm::ESHandle<MagneticField> bField;
    iSetup.get<IdealMagneticFieldRecord>().get(bField);
-
+   
+   outsideIn = false;
+   
    if(track.extra().isNull()) {
       if ( direction != InsideOut ) 
 	throw cms::Exception("FatalError") << 
 	"No TrackExtra information is available and association is done with something else than InsideOut track.\n" <<
 	"Either change the parameter or provide needed data!\n";
      LogTrace("TrackAssociator") << "Track Extras not found\n";
-     FreeTrajectoryState initialState = trajectoryStateTransform::initialFreeState(track,&*bField);
-     return associate(iEvent, iSetup, parameters, &initialState); // 5th argument is null pointer
+     innerState = trajectoryStateTransform::initialFreeState(track,&*bField);
+     return false; // no outer state
    }
    
    LogTrace("TrackAssociator") << "Track Extras found\n";
-   FreeTrajectoryState innerState = trajectoryStateTransform::innerFreeState(track,&*bField);
-   FreeTrajectoryState outerState = trajectoryStateTransform::outerFreeState(track,&*bField);
+   FreeTrajectoryState trackInnerState = trajectoryStateTransform::innerFreeState(track,&*bField);
+   FreeTrajectoryState trackOuterState = trajectoryStateTransform::outerFreeState(track,&*bField);
    FreeTrajectoryState referenceState = trajectoryStateTransform::initialFreeState(track,&*bField);
    
    LogTrace("TrackAssociator") << "inner track state (rho, z, phi):" << 
      track.innerPosition().Rho() << ", " << track.innerPosition().z() <<
      ", " << track.innerPosition().phi() << "\n";
    LogTrace("TrackAssociator") << "innerFreeState (rho, z, phi):" << 
-     innerState.position().perp() << ", " << innerState.position().z() <<
-     ", " << innerState.position().phi() << "\n";
+     trackInnerState.position().perp() << ", " << trackInnerState.position().z() <<
+     ", " << trackInnerState.position().phi() << "\n";
    
    LogTrace("TrackAssociator") << "outer track state (rho, z, phi):" << 
      track.outerPosition().Rho() << ", " << track.outerPosition().z() <<
      ", " << track.outerPosition().phi() << "\n";
    LogTrace("TrackAssociator") << "outerFreeState (rho, z, phi):" << 
-     outerState.position().perp() << ", " << outerState.position().z() <<
-     ", " << outerState.position().phi() << "\n";
+     trackOuterState.position().perp() << ", " << trackOuterState.position().z() <<
+     ", " << trackOuterState.position().phi() << "\n";
    
    // InsideOut first
    if ( crossedIP( track ) ) {
       switch ( direction ) {
        case InsideOut:
        case Any:
-	 return associate(iEvent, iSetup, parameters, &referenceState, &outerState);
-	 break;
+	 innerState = referenceState;
+	 outerState = trackOuterState;
+	 return true;
        case OutsideIn:
-	   {
-	      cachedTrajectory_.setPropagationStep( -fabs(currentStepSize) );
-	      TrackDetMatchInfo result = associate(iEvent, iSetup, parameters, &innerState, &referenceState);
-	      cachedTrajectory_.setPropagationStep( currentStepSize );
-	      return result;
-	      break;
-	   }
+	 outsideIn = true;
+	 innerState = trackInnerState;
+	 outerState = referenceState;
+	 return true;
       }
    } else {
       switch ( direction ) {
        case InsideOut:
-	 return associate(iEvent, iSetup, parameters, &innerState, &outerState);
-	 break;
+	 innerState = trackInnerState;
+	 outerState = trackOuterState;
+	 return true;
        case OutsideIn:
-	   {
-	      cachedTrajectory_.setPropagationStep( -fabs(currentStepSize) );
-	      TrackDetMatchInfo result = associate(iEvent, iSetup, parameters, &outerState, &innerState);
-	      cachedTrajectory_.setPropagationStep( currentStepSize );
-	      return result;
-	      break;
-	   }
+	 outsideIn = true;
+	 innerState = trackOuterState;
+	 outerState = trackInnerState;
+	 return true;
        case Any:
 	   {
 	      // check if we deal with clear outside-in case
 	      if ( track.innerPosition().Dot( track.innerMomentum() ) < 0 &&
 		   track.outerPosition().Dot( track.outerMomentum() ) < 0 )
 		{
-		   cachedTrajectory_.setPropagationStep( -fabs(currentStepSize) );
-		   TrackDetMatchInfo result;
-		   if ( track.innerPosition().R() < track.outerPosition().R() )
-		     result = associate(iEvent, iSetup, parameters, &innerState, &outerState);
-		   else
-		     result = associate(iEvent, iSetup, parameters, &outerState, &innerState);
-		   cachedTrajectory_.setPropagationStep( currentStepSize );
-		   return result;
+		   outsideIn = true;
+		   if ( track.innerPosition().R() < track.outerPosition().R() ) {
+		      innerState = trackInnerState;
+		      outerState = trackOuterState;
+		   } else {
+		      innerState = trackOuterState;
+		      outerState = trackInnerState;
+		   }
+		   return true;
 		}
 	   }
       }
    }
 	
    // all other cases  
-   return associate(iEvent, iSetup, parameters, &innerState, &outerState);
+   innerState = trackInnerState;
+   outerState = trackOuterState;
+   return true;
 }
 
 TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
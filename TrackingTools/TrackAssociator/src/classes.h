@@ -0,0 +1,8 @@
+#include "TrackingTools/TrackAssociator/interface/PropagatedTrajectories.h"
+#include "DataFormats/Common/interface/Wrapper.h"
+
+namespace TrackingTools_TrackAssociator {
+  struct dictionary {
+    edm::Wrapper<PropagatedTrajectories> wpt;
+  };
+}
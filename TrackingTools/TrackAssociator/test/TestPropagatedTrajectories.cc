@@ -0,0 +1,107 @@
+// -*- C++ -*-
+//
+// Package:    TrackAssociator
+// Class:      TestPropagatedTrajectories
+//
+/*
+
+ Description: checks that the association of the tracks is the same with the
+ * trajectories of PropagatedTrajectoryProducer as when the associator propagates
+ * the tracks itself, and that the trajectories are used. Throws otherwise.
+
+*/
+//
+
+#include "FWCore/Framework/interface/stream/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "TrackingTools/GeomPropagators/interface/Propagator.h"
+#include "TrackingTools/Records/interface/TrackingComponentsRecord.h"
+#include "TrackingTools/TrackAssociator/interface/PropagatedTrajectories.h"
+#include "TrackingTools/TrackAssociator/interface/TrackDetectorAssociator.h"
+#include "TrackingTools/TrackAssociator/interface/TrackAssociatorParameters.h"
+
+class TestPropagatedTrajectories : public edm::stream::EDAnalyzer<> {
+ public:
+   explicit TestPropagatedTrajectories(const edm::ParameterSet&);
+   void analyze(const edm::Event&, const edm::EventSetup&) override;
+   void endStream() override;
+
+ private:
+   void compare(const reco::TrackRef&, TrackDetMatchInfo&, TrackDetMatchInfo&) const;
+
+   edm::EDGetTokenT<reco::TrackCollection> tracksToken_;
+   edm::EDGetTokenT<PropagatedTrajectories> trajectoriesToken_;
+   TrackDetectorAssociator trackAssociator_;
+   TrackAssociatorParameters parameters_;
+   unsigned int nTracks_;
+   unsigned int nPropagated_;
+};
+
+TestPropagatedTrajectories::TestPropagatedTrajectories(const edm::ParameterSet& iConfig):
+  tracksToken_(consumes<reco::TrackCollection>(iConfig.getParameter<edm::InputTag>("tracks"))),
+  trajectoriesToken_(consumes<PropagatedTrajectories>(iConfig.getParameter<edm::InputTag>("propagatedTrajectories"))),
+  nTracks_(0), nPropagated_(0)
+{
+   edm::ConsumesCollector iC = consumesCollector();
+   parameters_.loadParameters(iConfig.getParameter<edm::ParameterSet>("TrackAssociatorParameters"), iC);
+}
+
+void TestPropagatedTrajectories::compare(const reco::TrackRef& track, TrackDetMatchInfo& propagated, TrackDetMatchInfo& reference) const
+{
+   bool same = propagated.trkGlobPosAtEcal == reference.trkGlobPosAtEcal &&
+     propagated.trkGlobPosAtHcal == reference.trkGlobPosAtHcal &&
+     propagated.trkGlobPosAtHO == reference.trkGlobPosAtHO &&
+     propagated.crossedEcalIds == reference.crossedEcalIds &&
+     propagated.crossedHcalIds == reference.crossedHcalIds &&
+     propagated.crossedHOIds == reference.crossedHOIds &&
+     propagated.crossedEnergy(TrackDetMatchInfo::EcalRecHits) == reference.crossedEnergy(TrackDetMatchInfo::EcalRecHits) &&
+     propagated.crossedEnergy(TrackDetMatchInfo::HcalRecHits) == reference.crossedEnergy(TrackDetMatchInfo::HcalRecHits) &&
+     propagated.crossedEnergy(TrackDetMatchInfo::HORecHits) == reference.crossedEnergy(TrackDetMatchInfo::HORecHits) &&
+     propagated.chambers.size() == reference.chambers.size();
+   for (unsigned int i = 0; same && i < propagated.chambers.size(); ++i) {
+      same = propagated.chambers[i].id == reference.chambers[i].id &&
+	propagated.chambers[i].localDistanceX == reference.chambers[i].localDistanceX &&
+	propagated.chambers[i].localDistanceY == reference.chambers[i].localDistanceY &&
+	propagated.chambers[i].segments.size() == reference.chambers[i].segments.size();
+   }
+   if (! same) throw cms::Exception("TestPropagatedTrajectories") << "Different association for the track " << track.key()
+								   << " with the propagated trajectory";
+}
+
+void TestPropagatedTrajectories::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+   edm::Handle<reco::TrackCollection> tracks;
+   iEvent.getByToken(tracksToken_, tracks);
+   edm::Handle<PropagatedTrajectories> trajectories;
+   iEvent.getByToken(trajectoriesToken_, trajectories);
+
+   edm::ESHandle<Propagator> propagator;
+   iSetup.get<TrackingComponentsRecord>().get(trajectories->propagator(), propagator);
+   trackAssociator_.setPropagator(propagator.product());
+
+   for (unsigned int i = 0; i < tracks->size(); ++i) {
+      const reco::TrackRef track(tracks, i);
+      ++nTracks_;
+      if (trajectories->find(track)) ++nPropagated_;
+      TrackDetMatchInfo propagated = trackAssociator_.associate(iEvent, iSetup, track, *trajectories, parameters_);
+      TrackDetMatchInfo reference = trackAssociator_.associate(iEvent, iSetup, *track, parameters_);
+      compare(track, propagated, reference);
+   }
+}
+
+void TestPropagatedTrajectories::endStream()
+{
+   edm::LogInfo("TestPropagatedTrajectories") << nPropagated_ << " of the " << nTracks_ << " tracks were propagated beforehand";
+   if (nTracks_ > 0 && nPropagated_ == 0)
+     throw cms::Exception("TestPropagatedTrajectories") << "No track was propagated beforehand";
+}
+
+DEFINE_FWK_MODULE(TestPropagatedTrajectories);
@@ -0,0 +1,39 @@
+import FWCore.ParameterSet.Config as cms
+
+# Checks that the associators give the same result with the trajectories
+# of PropagatedTrajectoryProducer as when they propagate the tracks themselves
+process = cms.Process("TEST")
+
+process.load('Configuration.StandardSequences.Services_cff')
+process.load('FWCore.MessageService.MessageLogger_cfi')
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase1_2017_realistic', '')
+
+process.load("TrackPropagation.SteppingHelixPropagator.SteppingHelixPropagatorAny_cfi")
+process.load("TrackingTools.TrackAssociator.DetIdAssociatorESProducer_cff")
+
+from PhysicsTools.PatAlgos.patInputFiles_cff import filesRelValTTbarGENSIMRECO
+process.source = cms.Source("PoolSource",
+    fileNames = filesRelValTTbarGENSIMRECO
+)
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(10)
+)
+process.MessageLogger.categories.append('TestPropagatedTrajectories')
+process.MessageLogger.cerr.TestPropagatedTrajectories = cms.untracked.PSet(
+    limit = cms.untracked.int32(-1)
+)
+
+process.load("TrackingTools.TrackAssociator.propagatedTrajectories_cfi")
+
+from TrackingTools.TrackAssociator.default_cfi import TrackAssociatorParameterBlock
+process.testPropagatedTrajectories = cms.EDAnalyzer("TestPropagatedTrajectories",
+    TrackAssociatorParameterBlock,
+    tracks = cms.InputTag("generalTracks"),
+    propagatedTrajectories = cms.InputTag("propagatedTrajectories")
+)
+
+process.p = cms.Path(process.propagatedTrajectories * process.testPropagatedTrajectories)